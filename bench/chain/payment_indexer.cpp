@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::machine;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(payment_indexer_bench)
+
+// A three transaction block of mainnet.
+#define MAINNET_BLOCK \
+    "010000007f110631052deeee06f0754a3629ad7663e56359fd5f3aa7b3e30a00" \
+    "000000005f55996827d9712147a8eb6d7bae44175fe0bcfa967e424a25bfe9f4" \
+    "dc118244d67fb74c9d8e2f1bea5ee82a03010000000100000000000000000000" \
+    "00000000000000000000000000000000000000000000ffffffff07049d8e2f1b" \
+    "0114ffffffff0100f2052a0100000043410437b36a7221bc977dce712728a954" \
+    "e3b5d88643ed5aef46660ddcfeeec132724cd950c1fdd008ad4a2dfd354d6af0" \
+    "ff155fc17c1ee9ef802062feb07ef1d065f0ac000000000100000001260fd102" \
+    "fab456d6b169f6af4595965c03c2296ecf25bfd8790e7aa29b404eff01000000" \
+    "8c493046022100c56ad717e07229eb93ecef2a32a42ad041832ffe66bd2e1485" \
+    "dc6758073e40af022100e4ba0559a4cebbc7ccb5d14d1312634664bac46f36dd" \
+    "d35761edaae20cefb16f01410417e418ba79380f462a60d8dd12dcef8ebfd7ab" \
+    "1741c5c907525a69a8743465f063c1d9182eea27746aeb9f1f52583040b1bc34" \
+    "1b31ca0388139f2f323fd59f8effffffff0200ffb2081d0000001976a914fc7b" \
+    "44566256621affb1541cc9d59f08336d276b88ac80f0fa02000000001976a914" \
+    "617f0609c9fabb545105f7898f36b84ec583350d88ac00000000010000000122" \
+    "cd6da26eef232381b1a670aa08f4513e9f91a9fd129d912081a3dd138cb01301" \
+    "0000008c4930460221009339c11b83f234b6c03ebbc4729c2633cbc8cbd0d157" \
+    "74594bfedc45c4f99e2f022100ae0135094a7d651801539df110a028d65459d2" \
+    "4bc752d7512bc8a9f78b4ab368014104a2e06c38dc72c4414564f190478e3b0d" \
+    "01260f09b8520b196c2f6ec3d06239861e49507f09b7568189efe8d327c3384a" \
+    "4e488f8c534484835f8020b3669e5aebffffffff0200ac23fc060000001976a9" \
+    "14b9a2c9700ff9519516b21af338d28d53ddf5349388ac00743ba40b00000019" \
+    "76a914eb675c349c474bec8dea2d79d12cff6f330ab48788ac00000000"
+
+static payment_address first(const payment_address::list& addresses)
+{
+    return addresses.empty() ? payment_address() : addresses.front();
+}
+
+// The serial extraction and pairing that the indexer replaces.
+static void index_serial(short_hash_list& keys, payment_record::list& payments,
+    stealth_record::list& stealth, const block& block, size_t height)
+{
+    for (const auto& tx: block.transactions())
+    {
+        const auto hash = tx.hash();
+        const auto& inputs = tx.inputs();
+        const auto& outputs = tx.outputs();
+
+        for (uint32_t index = 0; index < inputs.size(); ++index)
+        {
+            const auto& input = inputs[index];
+            const auto address = first(
+                payment_address::extract_input(input.script()));
+
+            if (!tx.is_coinbase() && address)
+            {
+                keys.push_back(address.hash());
+                payments.emplace_back(height, input_point{ hash, index },
+                    input.previous_output().checksum());
+            }
+        }
+
+        for (uint32_t index = 0; index < outputs.size(); ++index)
+        {
+            const auto& output = outputs[index];
+            const auto address = first(
+                payment_address::extract_output(output.script()));
+
+            if (address)
+            {
+                keys.push_back(address.hash());
+                payments.emplace_back(height, output_point{ hash, index },
+                    output.value());
+            }
+        }
+
+        for (uint32_t index = 0; index + 1u < outputs.size(); ++index)
+        {
+            uint32_t prefix;
+            hash_digest ephemeral_key;
+            const auto& script = outputs[index].script();
+            const auto address = first(
+                payment_address::extract_output(outputs[index + 1].script()));
+
+            if (address && to_stealth_prefix(prefix, script) &&
+                extract_ephemeral_key(ephemeral_key, script))
+                stealth.emplace_back(height, prefix, ephemeral_key,
+                    address.hash(), hash);
+        }
+    }
+}
+
+static ec_secret secret(uint32_t index)
+{
+    return bitcoin_hash(to_chunk(to_little_endian(index)));
+}
+
+static data_chunk public_key(uint32_t index, bool compressed=true)
+{
+    if (compressed)
+    {
+        ec_compressed point;
+        BOOST_REQUIRE(secret_to_public(point, secret(index)));
+        return to_chunk(point);
+    }
+
+    ec_uncompressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret(index)));
+    return to_chunk(point);
+}
+
+static short_hash key_hash(uint32_t index)
+{
+    return bitcoin_short_hash(public_key(index));
+}
+
+static script from_bytes(const data_chunk& bytes)
+{
+    return{ bytes, false };
+}
+
+// Scripts of each kind handled by the matcher, including those that fall
+// back to script parsing.
+static std::vector<script> output_scripts(uint32_t index)
+{
+    script stealth;
+    ec_secret ephemeral;
+    const auto seed = to_chunk(to_little_endian(index));
+    BOOST_REQUIRE(create_stealth_data(stealth, ephemeral, {}, seed));
+
+    return
+    {
+        stealth,
+        script::to_pay_key_hash_pattern(key_hash(index)),
+        script::to_pay_script_hash_pattern(key_hash(index + 1)),
+        script::to_pay_public_key_pattern(public_key(index + 2)),
+        script::to_pay_public_key_pattern(public_key(index + 3, false)),
+        script::to_null_data_pattern(to_chunk(to_little_endian(index))),
+        from_bytes(build_chunk(
+        {
+            base16_literal("76a94c14"),
+            key_hash(index + 4),
+            base16_literal("88ac")
+        })),
+        from_bytes(build_chunk(
+        {
+            base16_literal("4c21"),
+            public_key(index + 5),
+            base16_literal("ac")
+        })),
+        from_bytes(build_chunk({ base16_literal("0014"), key_hash(index) })),
+        from_bytes(to_chunk(base16_literal("a914")))
+    };
+}
+
+static std::vector<script> input_scripts(uint32_t index)
+{
+    const data_chunk signature(71, 0x30);
+    const auto redeem = script(script::to_pay_key_hash_pattern(
+        key_hash(index))).to_data(false);
+
+    return
+    {
+        script{ { operation(signature), operation(public_key(index)) } },
+        script{ { operation(signature),
+            operation(public_key(index + 1, false)) } },
+        script{ { operation(opcode::push_size_0), operation(signature),
+            operation(redeem) } },
+        script{ { operation(signature),
+            operation(to_chunk(base16_literal("ab"))) } },
+        script{ { operation(signature), operation(opcode::dup) } },
+        from_bytes(build_chunk(
+        {
+            base16_literal("4c47"),
+            signature,
+            base16_literal("4d2100"),
+            public_key(index + 2)
+        })),
+        from_bytes(to_chunk(base16_literal("4c"))),
+        {}
+    };
+}
+
+// A transaction with one input and one output of each kind.
+static transaction make_transaction(uint32_t index)
+{
+    transaction tx;
+    const auto hash = bitcoin_hash(to_chunk(to_little_endian(index)));
+
+    uint32_t point_index = 0;
+    for (auto& item: input_scripts(index))
+        tx.inputs().emplace_back(output_point{ hash, point_index++ },
+            std::move(item), max_input_sequence);
+
+    uint64_t value = 0;
+    for (auto& item: output_scripts(index))
+        tx.outputs().emplace_back(value++, std::move(item));
+
+    return tx;
+}
+
+static block make_block(uint32_t count)
+{
+    transaction::list txs{ block::genesis_mainnet().transactions().front() };
+    txs.reserve(count + 1);
+
+    for (uint32_t index = 0; index < count; ++index)
+        txs.push_back(make_transaction(index * 10));
+
+    return { header(), std::move(txs) };
+}
+
+
+// Indexes the mainnet block with its spends repeated and a mixed block.
+BOOST_AUTO_TEST_CASE(payment_indexer__index__throughput)
+{
+    static const size_t iterations = 20;
+
+    block mainnet;
+    BOOST_REQUIRE(mainnet.from_data(to_chunk(base16_literal(MAINNET_BLOCK))));
+
+    // The mainnet block with its spends repeated (2000 transactions).
+    auto txs = mainnet.transactions();
+    while (txs.size() < 2000)
+        txs.push_back(mainnet.transactions()[1 + txs.size() % 2]);
+
+    const block repeated{ mainnet.header(), std::move(txs) };
+    const auto mixed = make_block(500);
+
+    for (const auto& instance: { repeated, mixed })
+    {
+        short_hash_list keys;
+        payment_record::list payments;
+        stealth_record::list stealth;
+        const auto serial_time = timer<asio::microseconds>::duration([&]()
+        {
+            for (size_t index = 0; index < iterations; ++index)
+            {
+                keys.clear();
+                payments.clear();
+                stealth.clear();
+                index_serial(keys, payments, stealth, instance, 0);
+            }
+        });
+
+        payment_indexer indexer;
+        const auto indexer_time = timer<asio::microseconds>::duration([&]()
+        {
+            for (size_t index = 0; index < iterations; ++index)
+                indexer.index(instance, 0);
+        });
+
+        BOOST_REQUIRE(indexer.payments().keys == keys);
+        BOOST_REQUIRE(indexer.payment_records() == payments);
+        BOOST_REQUIRE(indexer.stealth_records() == stealth);
+
+        const auto rows = keys.size() + stealth.size();
+        BOOST_TEST_MESSAGE("index block (" << instance.transactions().size()
+            << " txs, " << rows << " rows) x " << iterations << ": serial "
+            << serial_time.count() << "us, indexer " << indexer_time.count()
+            << "us");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
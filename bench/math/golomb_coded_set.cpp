@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(golomb_coded_set_bench)
+
+static const siphash_key key{ 0x0706050403020100, 0x0f0e0d0c0b0a0908 };
+static const uint8_t bits = 19;
+static const uint64_t rate = 784931;
+
+static data_stack make_items(uint32_t first, uint32_t count)
+{
+    data_stack items;
+    items.reserve(count);
+
+    for (auto index = first; index < first + count; ++index)
+        items.push_back(to_chunk(to_little_endian(index)));
+
+    return items;
+}
+
+// Builds a set of 20000 items and queries it with 1000 x 10 targets.
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__throughput)
+{
+    static const uint32_t elements = 20000;
+    static const uint32_t queries = 1000;
+    static const uint32_t targets = 10;
+
+    const auto items = make_items(0, elements);
+    data_chunk set;
+
+    const auto build = timer<asio::microseconds>::duration([&]()
+    {
+        set = golomb_construct(items, bits, rate, key);
+    });
+
+    std::vector<data_stack> lists;
+    for (uint32_t query = 0; query < queries; ++query)
+        lists.push_back(make_items(elements + query * targets, targets));
+
+    size_t matched = 0;
+    const auto match = timer<asio::microseconds>::duration([&]()
+    {
+        for (const auto& list: lists)
+            matched += golomb_match(set, items.size(), list, bits, rate, key) ?
+                1 : 0;
+    });
+
+    BOOST_TEST_MESSAGE("construct (" << elements << "): " << build.count()
+        << "us, match (" << queries << " x " << targets << "): "
+        << match.count() << "us");
+
+    BOOST_REQUIRE_LT(matched, 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(block_filter_bench)
+
+static chain::script pay_key_hash(uint32_t index)
+{
+    return chain::script::to_pay_key_hash_pattern(
+        bitcoin_short_hash(to_chunk(to_little_endian(index))));
+}
+
+// A transaction spending a populated previous output paid to index.
+static chain::transaction spend(uint32_t index)
+{
+    chain::transaction tx
+    {
+        1, 0,
+        { { { null_hash, index }, {}, 0 } },
+        { { 500, pay_key_hash(index + 1000000) } }
+    };
+
+    tx.inputs().front().previous_output().validation.cache =
+        chain::output(1000, pay_key_hash(index));
+    return tx;
+}
+
+static chain::block make_block(uint32_t count)
+{
+    chain::transaction::list txs;
+    txs.reserve(count);
+
+    for (uint32_t index = 0; index < count; ++index)
+        txs.push_back(spend(index));
+
+    return { chain::header(), std::move(txs) };
+}
+
+// Builds the filter of a 2000 transaction block and queries it.
+BOOST_AUTO_TEST_CASE(block_filter__constructor_3__block)
+{
+    static const uint32_t transactions = 2000;
+    static const uint32_t queries = 1000;
+
+    const auto block = make_block(transactions);
+    block_filter instance;
+
+    const auto build = timer<asio::microseconds>::duration([&]()
+    {
+        instance = block_filter(block);
+    });
+
+    data_stack wallet;
+    for (uint32_t index = 0; index < 100; ++index)
+        wallet.push_back(pay_key_hash(transactions + index).to_data(false));
+
+    size_t matched = 0;
+    const auto match = timer<asio::microseconds>::duration([&]()
+    {
+        for (uint32_t query = 0; query < queries; ++query)
+            matched += instance.match(wallet) ? 1 : 0;
+    });
+
+    BOOST_TEST_MESSAGE("filter block (" << transactions << "): "
+        << build.count() << "us, match wallet (100) x " << queries << ": "
+        << match.count() << "us");
+
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u * transactions);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
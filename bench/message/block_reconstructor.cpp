@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(block_reconstructor_bench)
+
+static const uint64_t nonce = 0x0123456789abcdef;
+
+static transaction::const_ptr_list make_pool(size_t count)
+{
+    transaction::const_ptr_list pool;
+    pool.reserve(count);
+
+    // Distinct by lock time, small and quick to hash.
+    for (size_t index = 0; index < count; ++index)
+        pool.push_back(std::make_shared<const transaction>(
+            chain::transaction(1, static_cast<uint32_t>(index), {}, {})));
+
+    return pool;
+}
+
+// A coinbase followed by every step'th transaction of the pool.
+static chain::block make_block(const transaction::const_ptr_list& pool,
+    size_t step)
+{
+    chain::transaction::list transactions;
+    transactions.push_back(chain::transaction(2, 0, {}, {}));
+
+    for (size_t index = 0; index < pool.size(); index += step)
+        transactions.push_back(*pool[index]);
+
+    chain::block block(chain::header(), std::move(transactions));
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+// Reconstructs a 2000 transaction block from memory pools of various sizes.
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__memory_pool)
+{
+    static const size_t block_transactions = 2000;
+
+    for (const size_t size: { 10000, 100000, 300000 })
+    {
+        const auto pool = make_pool(size);
+        const auto block = make_block(pool, size / block_transactions);
+        const compact_block compact(block, nonce);
+
+        // Cache transaction hashes, as a memory pool would.
+        for (const auto& transaction: pool)
+            transaction->hash();
+
+        size_t filled = 0;
+        const auto time = timer<asio::microseconds>::duration([&]()
+        {
+            block_reconstructor instance(compact);
+            filled = instance.fill(pool);
+        });
+
+        BOOST_TEST_MESSAGE("memory pool " << size << ": " << time.count()
+            << "us");
+        BOOST_REQUIRE_EQUAL(filled, block.transactions().size() - 1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(timing_wheel_bench)
+
+// Schedule and expire 100k concurrent timers, reporting elapsed time.
+BOOST_AUTO_TEST_CASE(timing_wheel__start__100k_concurrent)
+{
+    static const size_t timers = 100000;
+    threadpool pool(2);
+    dispatcher dispatch(pool, "timing_wheel_bench");
+    std::atomic<size_t> expired(0);
+    std::promise<void> promise;
+    const auto handler = [&expired, &promise](const code&)
+    {
+        if (++expired == timers)
+            promise.set_value();
+    };
+
+    const auto elapsed = timer<asio::microseconds>::duration([&]()
+    {
+        for (size_t index = 0; index < timers; ++index)
+            dispatch.delayed(asio::milliseconds(index % 50), handler);
+    });
+
+    BOOST_TEST_MESSAGE("start 100k timers: " << elapsed.count() << "us");
+    promise.get_future().wait();
+    BOOST_REQUIRE_EQUAL(expired.load(), timers);
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 0u);
+    pool.shutdown();
+    pool.join();
+}
+
+// Schedule and cancel 100k concurrent timers, reporting elapsed time.
+BOOST_AUTO_TEST_CASE(timing_wheel__stop__100k_concurrent)
+{
+    static const size_t timers = 100000;
+    threadpool pool(1);
+    std::atomic<size_t> invoked(0);
+    std::vector<timing_wheel::entry_ptr> entries;
+    entries.reserve(timers);
+    const auto handler = [&invoked](const code&)
+    {
+        ++invoked;
+    };
+
+    const auto elapsed = timer<asio::microseconds>::duration([&]()
+    {
+        for (size_t index = 0; index < timers; ++index)
+            entries.push_back(pool.timers().start(handler, asio::seconds(1)));
+
+        for (const auto& entry: entries)
+            pool.timers().stop(entry);
+    });
+
+    BOOST_TEST_MESSAGE("start/stop 100k timers: " << elapsed.count() << "us");
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 0u);
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(invoked.load(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,6 +29,7 @@
 #include <bitcoin/bitcoin/chain/input_point.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
 #include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/payment_indexer.hpp>
 #include <bitcoin/bitcoin/chain/payment_record.hpp>
 #include <bitcoin/bitcoin/chain/point.hpp>
 #include <bitcoin/bitcoin/chain/point_iterator.hpp>
@@ -63,10 +64,12 @@
 #include <bitcoin/bitcoin/log/file_collector.hpp>
 #include <bitcoin/bitcoin/log/file_collector_repository.hpp>
 #include <bitcoin/bitcoin/log/file_counter_formatter.hpp>
+#include <bitcoin/bitcoin/log/ring_buffer_queue.hpp>
 #include <bitcoin/bitcoin/log/rotable_file.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 #include <bitcoin/bitcoin/log/sink.hpp>
 #include <bitcoin/bitcoin/log/source.hpp>
+#include <bitcoin/bitcoin/log/statsd_aggregator.hpp>
 #include <bitcoin/bitcoin/log/statsd_sink.hpp>
 #include <bitcoin/bitcoin/log/statsd_source.hpp>
 #include <bitcoin/bitcoin/log/udp_client_sink.hpp>
@@ -86,16 +89,23 @@
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/golomb_coded_set.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/math/stealth.hpp>
 #include <bitcoin/bitcoin/math/uint256.hpp>
 #include <bitcoin/bitcoin/message/address.hpp>
 #include <bitcoin/bitcoin/message/alert.hpp>
 #include <bitcoin/bitcoin/message/alert_payload.hpp>
 #include <bitcoin/bitcoin/message/block.hpp>
+#include <bitcoin/bitcoin/message/block_filter.hpp>
+#include <bitcoin/bitcoin/message/block_reconstructor.hpp>
 #include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
 #include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/encoding.hpp>
 #include <bitcoin/bitcoin/message/fee_filter.hpp>
 #include <bitcoin/bitcoin/message/filter_add.hpp>
 #include <bitcoin/bitcoin/message/filter_clear.hpp>
@@ -115,6 +125,7 @@
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/network_address.hpp>
 #include <bitcoin/bitcoin/message/not_found.hpp>
+#include <bitcoin/bitcoin/message/parser.hpp>
 #include <bitcoin/bitcoin/message/ping.hpp>
 #include <bitcoin/bitcoin/message/pong.hpp>
 #include <bitcoin/bitcoin/message/prefilled_transaction.hpp>
@@ -137,6 +148,8 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/atomic.hpp>
 #include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/buffer_writer.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/color.hpp>
 #include <bitcoin/bitcoin/utility/conditional_lock.hpp>
@@ -157,6 +170,7 @@
 #include <bitcoin/bitcoin/utility/monitor.hpp>
 #include <bitcoin/bitcoin/utility/noncopyable.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/utility/pending.hpp>
 #include <bitcoin/bitcoin/utility/png.hpp>
 #include <bitcoin/bitcoin/utility/prioritized_mutex.hpp>
@@ -174,6 +188,7 @@
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/timer.hpp>
+#include <bitcoin/bitcoin/utility/timing_wheel.hpp>
 #include <bitcoin/bitcoin/utility/track.hpp>
 #include <bitcoin/bitcoin/utility/work.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
@@ -195,7 +210,9 @@
 #include <bitcoin/bitcoin/wallet/select_outputs.hpp>
 #include <bitcoin/bitcoin/wallet/stealth_address.hpp>
 #include <bitcoin/bitcoin/wallet/stealth_receiver.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_scanner.hpp>
 #include <bitcoin/bitcoin/wallet/stealth_sender.hpp>
+#include <bitcoin/bitcoin/wallet/unspent_index.hpp>
 #include <bitcoin/bitcoin/wallet/uri.hpp>
 #include <bitcoin/bitcoin/wallet/uri_reader.hpp>
 
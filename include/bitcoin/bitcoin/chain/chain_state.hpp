@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_CHAIN_CHAIN_STATE_HPP
 #define LIBBITCOIN_CHAIN_CHAIN_STATE_HPP
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -180,6 +181,47 @@ protected:
     static uint32_t work_required(const data& values, uint32_t forks);
 
 private:
+    // A chunk of consecutive block versions, shared by successive states.
+    struct version_chunk;
+    typedef std::shared_ptr<const version_chunk> version_chunk_ptr;
+
+    // The values below the height upon which the state depends, in fixed
+    // size (rolling) form, with summaries maintained as values enter and
+    // leave the window. Promotion to the next height is constant time and
+    // shares version history with the parent state.
+    struct window
+    {
+        size_t height;
+        hash_digest hash;
+        hash_digest allow_collisions_hash;
+        hash_digest bip9_bit0_hash;
+
+        // Bits of this block, of the previous block, and the most recent
+        // retarget height or non-limit bits below this height (easy blocks).
+        uint32_t bits_self;
+        uint32_t bits_high;
+        uint32_t bits_easy;
+
+        // Version of this block, and the sample of versions at heights
+        // [version_first, version_first + version_count) with the number of
+        // them at or above each bip34-based version.
+        uint32_t version_self;
+        size_t version_first;
+        size_t version_count;
+        size_t version_bip34;
+        size_t version_bip66;
+        size_t version_bip65;
+        version_chunk_ptr versions;
+
+        // Timestamp of this block and of the last retarget height, and the
+        // median time past sample, in height order and in value order.
+        uint32_t timestamp_self;
+        uint32_t timestamp_retarget;
+        size_t timestamp_count;
+        std::array<uint32_t, median_time_past_interval> timestamps;
+        std::array<uint32_t, median_time_past_interval> sorted;
+    };
+
     static size_t bits_count(size_t height, uint32_t forks);
     static size_t version_count(size_t height, uint32_t forks);
     static size_t timestamp_count(size_t height, uint32_t forks);
@@ -187,23 +229,32 @@ private:
     static size_t collision_height(size_t height, uint32_t forks);
     static size_t bip9_bit0_height(size_t height, uint32_t forks);
 
-    static data to_pool(const chain_state& top);
-    static data to_block(const chain_state& pool, const block& block);
-    static data to_header(const chain_state& parent, const header& header);
+    static window to_window(const data& values);
+    static window to_pool(const chain_state& top);
+    static window to_block(const chain_state& pool, const block& block);
+    static window to_header(const chain_state& parent, const header& header);
+
+    static void push_version(window& values, uint32_t version, size_t count);
+    static void push_timestamp(window& values, uint32_t timestamp,
+        size_t count);
+
+    static activations activation(const window& values, uint32_t forks);
+    static uint32_t median_time_past(const window& values);
+    static uint32_t work_required(const window& values, uint32_t forks);
 
-    static uint32_t work_required_retarget(const data& values);
-    static uint32_t retarget_timespan(const chain_state::data& values);
+    static uint32_t work_required_retarget(const window& values);
+    static uint32_t retarget_timespan(const window& values);
 
     // easy blocks
-    static uint32_t easy_work_required(const data& values);
-    static uint32_t easy_time_limit(const chain_state::data& values);
+    static uint32_t easy_work_required(const window& values);
+    static uint32_t easy_time_limit(const window& values);
     static bool is_retarget_or_non_limit(size_t height, uint32_t bits);
     static bool is_retarget_height(size_t height);
     static size_t retarget_distance(size_t height);
 
     // This is retained as an optimization for other constructions.
-    // A similar height clone can be partially computed, reducing query cost.
-    const data data_;
+    // A next height state is promoted from it in constant time.
+    const window window_;
 
     // Configured forks are saved for state transitions.
     const uint32_t forks_;
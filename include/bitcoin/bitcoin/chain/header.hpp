@@ -156,6 +156,7 @@ private:
     typedef std::shared_ptr<hash_digest> hash_ptr;
 
     hash_ptr hash_cache() const;
+    byte_array<80> to_fixed_data() const;
 
     mutable hash_ptr hash_;
     mutable upgrade_mutex mutex_;
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_PAYMENT_INDEXER_HPP
+#define LIBBITCOIN_CHAIN_PAYMENT_INDEXER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/payment_record.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/stealth_record.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// Indexes the payment (history) and stealth rows of blocks for storage.
+/// Scripts are classified in parallel by a byte-level matcher, which parses
+/// operations only for uncommon encodings. Rows are emitted in columns and
+/// all buffers are reused from one block to the next.
+class BC_API payment_indexer
+{
+public:
+    /// The payment rows of a block, with one entry per row in each column.
+    /// Rows are in block order, with the inputs of a transaction first.
+    struct payment_rows
+    {
+        /// The hash of the payment address (the storage key).
+        short_hash_list keys;
+
+        /// The position of the transaction in the block.
+        std::vector<uint32_t> transactions;
+
+        /// The position of the input or output in the transaction.
+        std::vector<uint32_t> indexes;
+
+        /// Non-zero if the row is an input (spend), zero if an output.
+        std::vector<uint8_t> inputs;
+
+        /// The output value, or the checksum of the input's previous output.
+        std::vector<uint64_t> data;
+    };
+
+    /// The stealth rows of a block, with one entry per row in each column.
+    struct stealth_rows
+    {
+        /// The stealth prefix of the ephemeral key output.
+        std::vector<uint32_t> prefixes;
+
+        /// The ephemeral public key, without its sign byte.
+        hash_list ephemeral_keys;
+
+        /// The payment address hash of the following output.
+        short_hash_list keys;
+
+        /// The position of the transaction in the block.
+        std::vector<uint32_t> transactions;
+    };
+
+    /// Construct an indexer that uses up to threads threads (zero for the
+    /// hardware concurrency).
+    payment_indexer(size_t threads=0);
+
+    /// Index the block at the given height, replacing any previous rows.
+    void index(const block& block, size_t height);
+
+    /// The height of the indexed block.
+    size_t height() const;
+
+    /// The transaction hashes of the indexed block, in block order.
+    const hash_list& transaction_hashes() const;
+
+    const payment_rows& payments() const;
+    const stealth_rows& stealth() const;
+
+    /// The payment rows as records, keyed by the row in payments().keys.
+    payment_record::list payment_records() const;
+
+    /// The stealth rows as records.
+    stealth_record::list stealth_records() const;
+
+    /// The address hash of the first address extracted from an output or
+    /// input script, as payment_address::extract_output and extract_input.
+    /// As there, an uncompressed public key must be on the curve while a
+    /// compressed public key is hashed as serialized.
+    static bool extract_output(short_hash& out_hash, const script& script);
+    static bool extract_input(short_hash& out_hash, const script& script);
+
+private:
+    void classify(const block& block, size_t first, size_t last);
+    void compact(const block& block);
+
+    const size_t threads_;
+    size_t height_;
+    hash_list hashes_;
+    payment_rows payments_;
+    stealth_rows stealth_;
+
+    // Per input and output slot, reused across blocks.
+    std::vector<size_t> offsets_;
+    std::vector<uint8_t> flags_;
+    short_hash_list keys_;
+    std::vector<uint32_t> prefixes_;
+    hash_list ephemeral_keys_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
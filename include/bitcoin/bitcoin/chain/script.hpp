@@ -120,6 +120,9 @@ public:
     size_t serialized_size(bool prefix) const;
     const operation::list& operations() const;
 
+    /// The serialized script (without prefix), available without parsing.
+    const data_chunk& bytes() const;
+
     // Signing.
     //-------------------------------------------------------------------------
 
@@ -22,6 +22,7 @@
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
 
@@ -56,6 +57,32 @@ BC_API std::string encode_base58(data_slice unencoded);
  */
 BC_API bool decode_base58(data_chunk& out, const std::string& in);
 
+/**
+ * Encode data with its four byte checksum appended as base58 (base58check).
+ * Address (21 byte) and extended key (78 byte) payloads are checksummed and
+ * encoded without allocation of the checked data.
+ * @return the base58 encoded string.
+ */
+BC_API std::string encode_base58_check(data_slice payload);
+
+/**
+ * Attempt to decode base58check data, removing its four byte checksum.
+ * @return false if the input is malformed or the checksum does not match.
+ */
+BC_API bool decode_base58_check(data_chunk& out, const std::string& in);
+
+/**
+ * Encode each of a set of data (such as wrapped addresses) as base58.
+ * @return the base58 encoded strings, in the order of the data.
+ */
+BC_API string_list encode_base58(const data_stack& unencoded);
+
+/**
+ * Attempt to decode each of a set of base58 strings.
+ * @return false if any input contains non-base58 characters.
+ */
+BC_API bool decode_base58(data_stack& out, const string_list& in);
+
 } // namespace libbitcoin
 
 #include <bitcoin/bitcoin/impl/formats/base_58.ipp>
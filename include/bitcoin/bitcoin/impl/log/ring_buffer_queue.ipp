@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_LOG_RING_BUFFER_QUEUE_IPP
+#define LIBBITCOIN_LOG_RING_BUFFER_QUEUE_IPP
+
+#include <atomic>
+#include <cstddef>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/thread/locks.hpp>
+#include <bitcoin/bitcoin/log/attributes.hpp>
+#include <bitcoin/bitcoin/log/severity.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+// The sequence of each cell tracks its lap of the ring, as in Dmitry Vyukov's
+// bounded mpmc queue: 1024cores.net/home/lock-free-algorithms/queues
+
+template <size_t Capacity>
+ring_buffer_queue<Capacity>::ring_buffer_queue()
+  : cells_(Capacity),
+    enqueue_(0),
+    dequeue_(0),
+    dropped_(0),
+    sampled_(0),
+    policy_(overflow_policy::block),
+    blocked_(0),
+    waiting_(false),
+    interrupted_(false)
+{
+    for (size_t index = 0; index < Capacity; ++index)
+        cells_[index].sequence.store(index, std::memory_order_relaxed);
+}
+
+template <size_t Capacity>
+template <typename Arguments>
+ring_buffer_queue<Capacity>::ring_buffer_queue(const Arguments&)
+  : ring_buffer_queue()
+{
+}
+
+template <size_t Capacity>
+void ring_buffer_queue<Capacity>::set_overflow_policy(overflow_policy policy)
+{
+    policy_.store(policy);
+}
+
+template <size_t Capacity>
+size_t ring_buffer_queue<Capacity>::dropped() const
+{
+    return dropped_.load();
+}
+
+template <size_t Capacity>
+void ring_buffer_queue<Capacity>::enqueue(
+    const boost::log::record_view& record)
+{
+    if (!admit(record))
+    {
+        ++dropped_;
+        return;
+    }
+
+    while (!push(record))
+    {
+        if (policy_.load(std::memory_order_relaxed) != overflow_policy::block)
+        {
+            ++dropped_;
+            return;
+        }
+
+        notify();
+        wait_for_space();
+    }
+
+    notify();
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::try_enqueue(
+    const boost::log::record_view& record)
+{
+    if (!push(record))
+        return false;
+
+    notify();
+    return true;
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::try_dequeue_ready(
+    boost::log::record_view& record)
+{
+    return pop(record);
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::try_dequeue(
+    boost::log::record_view& record)
+{
+    return pop(record);
+}
+
+// Producers only signal when the consumer has announced that it is waiting.
+// The wait is bounded so that a signal lost to that race only delays writing.
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::dequeue_ready(
+    boost::log::record_view& record)
+{
+    static const auto timeout = boost::posix_time::milliseconds(10);
+
+    while (!interrupted_.load())
+    {
+        if (pop(record))
+            return true;
+
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        waiting_.store(true);
+
+        if (size() == 0 && !interrupted_.load())
+            condition_.timed_wait(lock, timeout);
+
+        waiting_.store(false);
+    }
+
+    interrupted_.store(false);
+    return false;
+}
+
+template <size_t Capacity>
+void ring_buffer_queue<Capacity>::interrupt_dequeue()
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    interrupted_.store(true);
+    condition_.notify_one();
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+template <size_t Capacity>
+size_t ring_buffer_queue<Capacity>::size() const
+{
+    return enqueue_.load() - dequeue_.load();
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::admit(
+    const boost::log::record_view& record)
+{
+    static const size_t threshold = Capacity - Capacity / 4;
+
+    if (policy_.load(std::memory_order_relaxed) != overflow_policy::sample ||
+        size() < threshold)
+        return true;
+
+    const auto level = record[attributes::severity];
+    if (level && level.get() >= severity::warning)
+        return true;
+
+    return (sampled_.fetch_add(1, std::memory_order_relaxed) %
+        sample_rate) == 0;
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::push(const boost::log::record_view& record)
+{
+    static const size_t mask = Capacity - 1;
+    auto position = enqueue_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        auto& slot = cells_[position & mask];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<intptr_t>(sequence) -
+            static_cast<intptr_t>(position);
+
+        if (difference == 0)
+        {
+            if (enqueue_.compare_exchange_weak(position, position + 1,
+                std::memory_order_relaxed))
+            {
+                slot.record = record;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The ring is full.
+            return false;
+        }
+        else
+        {
+            position = enqueue_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// A blocked producer sleeps until the consumer frees a cell. As with the
+// consumer, the wait is bounded so that a lost signal only delays the push.
+template <size_t Capacity>
+void ring_buffer_queue<Capacity>::wait_for_space()
+{
+    static const auto timeout = boost::posix_time::milliseconds(10);
+
+    boost::unique_lock<boost::mutex> lock(space_mutex_);
+    ++blocked_;
+
+    if (size() >= Capacity)
+        space_.timed_wait(lock, timeout);
+
+    --blocked_;
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::pop(boost::log::record_view& record)
+{
+    if (!take(record))
+        return false;
+
+    if (blocked_.load() != 0)
+    {
+        boost::lock_guard<boost::mutex> lock(space_mutex_);
+        space_.notify_all();
+    }
+
+    return true;
+}
+
+template <size_t Capacity>
+bool ring_buffer_queue<Capacity>::take(boost::log::record_view& record)
+{
+    static const size_t mask = Capacity - 1;
+    auto position = dequeue_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        auto& slot = cells_[position & mask];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<intptr_t>(sequence) -
+            static_cast<intptr_t>(position + 1);
+
+        if (difference == 0)
+        {
+            if (dequeue_.compare_exchange_weak(position, position + 1,
+                std::memory_order_relaxed))
+            {
+                record.swap(slot.record);
+                slot.record = boost::log::record_view();
+                slot.sequence.store(position + Capacity,
+                    std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The ring is empty.
+            return false;
+        }
+        else
+        {
+            position = dequeue_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <size_t Capacity>
+void ring_buffer_queue<Capacity>::notify()
+{
+    if (!waiting_.load())
+        return;
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    condition_.notify_one();
+}
+
+} // namespace log
+} // namespace libbitcoin
+
+#endif
@@ -27,9 +27,9 @@ namespace libbitcoin {
 
 template<size_t Size>
 byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
-    uint32_t p, uint32_t r)
+    uint32_t p, uint32_t r, size_t threads)
 {
-    const auto out = scrypt(data, salt, N, r, p, Size);
+    const auto out = scrypt(data, salt, N, r, p, Size, threads);
     return to_array<Size>({ out });
 }
 
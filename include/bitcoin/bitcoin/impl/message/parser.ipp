@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_PARSER_IPP
+#define LIBBITCOIN_MESSAGE_PARSER_IPP
+
+#include <memory>
+#include <utility>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+template <class Message>
+void parser::subscribe(handler<Message>&& handler)
+{
+    auto notify = std::move(handler);
+
+    subscribe(Message::command, [notify](uint32_t version,
+        const heading& head, data_slice payload, bool retain_encoding)
+    {
+        auto source = make_safe_deserializer(payload.begin(), payload.end());
+        const auto message = std::make_shared<Message>();
+
+        if (!message->from_data(version, source))
+            return false;
+
+        if (retain_encoding)
+            retain(*message, version, head, payload);
+
+        notify(message);
+        return true;
+    });
+}
+
+// Only blocks and transactions retain their encoding (see overloads).
+template <class Message>
+void parser::retain(Message&, uint32_t, const heading&, data_slice)
+{
+}
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
@@ -119,6 +119,10 @@ uint64_t deserializer<Iterator, CheckSafe>::read_variable_big_endian()
 {
     const auto value = read_byte();
 
+    // Single byte values are by far the most common, so test for them first.
+    if (value < varint_two_bytes)
+        return value;
+
     switch (value)
     {
         case varint_eight_bytes:
@@ -179,6 +183,10 @@ uint64_t deserializer<Iterator, CheckSafe>::read_variable_little_endian()
 {
     const auto value = read_byte();
 
+    // Single byte values are by far the most common, so test for them first.
+    if (value < varint_two_bytes)
+        return value;
+
     switch (value)
     {
         case varint_eight_bytes:
@@ -227,25 +235,21 @@ data_chunk deserializer<Iterator, CheckSafe>::read_bytes()
     return read_bytes(remaining());
 }
 
-// Return size is guaranteed.
-// This is a memory exhaustion risk if caller does not control size.
+// Return size is guaranteed only if the reader remains valid.
+// An invalid read returns empty, as the size may be attacker controlled.
 template <typename Iterator, bool CheckSafe>
 data_chunk deserializer<Iterator, CheckSafe>::read_bytes(size_t size)
 {
-    // TODO: avoid unnecessary default zero fill using
-    // the allocator adapter here: stackoverflow.com/a/21028912/1172329.
-    data_chunk out(size);
-
     if (!safe(size))
         invalidate();
 
-    if (!valid_ || size == 0)
-        return out;
+    if (!valid_)
+        return{};
 
+    // Construct from the range to avoid a default zero fill before copy.
     const auto begin = iterator_;
     iterator_ += size;
-    std::copy_n(begin, size, out.begin());
-    return out;
+    return data_chunk(begin, iterator_);
 }
 
 template <typename Iterator, bool CheckSafe>
@@ -264,26 +268,14 @@ std::string deserializer<Iterator, CheckSafe>::read_string(size_t size)
     if (!valid_)
         return{};
 
-    std::string out;
-    out.reserve(size);
-
     // Read up to size characters, stopping at the first null (may be many).
-    for (size_t index = 0; index < size; ++index)
-    {
-        const auto character = iterator_[index];
-
-        if (character == string_terminator)
-            break;
-
-        out.push_back(character);
-    }
+    const auto begin = iterator_;
+    const auto end = begin + size;
+    const auto terminator = std::find(begin, end, string_terminator);
 
     // Consume all size characters from the buffer.
-    iterator_ += size;
-
-    // Reduce the allocation to the number of characters pushed.
-    out.shrink_to_fit();
-    return out;
+    iterator_ = end;
+    return std::string(begin, terminator);
 }
 
 template <typename Iterator, bool CheckSafe>
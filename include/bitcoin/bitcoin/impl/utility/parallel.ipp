@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_IPP
+#define LIBBITCOIN_PARALLEL_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <vector>
+#include <boost/thread.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+template <typename Handler>
+void parallel_for(size_t count, size_t grain, Handler&& handler,
+    size_t threads)
+{
+    // Ranges but the last are at least grain, so below twice grain is serial.
+    grain = std::max(grain, size_t(1));
+    const auto ranges = std::min(thread_default(threads), count / grain);
+
+    if (ranges <= 1)
+    {
+        if (count != 0)
+            handler(size_t(0), count);
+
+        return;
+    }
+
+    const auto size = (count + ranges - 1) / ranges;
+    std::vector<boost::thread> workers;
+    workers.reserve(ranges - 1);
+
+    // The first exception of any range is rethrown once all are joined.
+    std::exception_ptr exception;
+    boost::mutex mutex;
+
+    const auto invoke = [&handler, &exception, &mutex](size_t first,
+        size_t last)
+    {
+        try
+        {
+            handler(first, last);
+        }
+        catch (...)
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+
+            if (!exception)
+                exception = std::current_exception();
+        }
+    };
+
+    // The first range is processed on the calling thread.
+    for (auto first = size; first < count; first += size)
+    {
+        const auto last = std::min(first + size, count);
+        workers.emplace_back([&invoke, first, last]()
+        {
+            invoke(first, last);
+        });
+    }
+
+    invoke(size_t(0), size);
+
+    for (auto& worker: workers)
+        worker.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -22,29 +22,39 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 
 namespace libbitcoin {
 
-template <typename Iterator>
-serializer<Iterator>::serializer(const Iterator begin)
-  : iterator_(begin), valid_(true)
+// Since the end is not used just use begin.
+template <typename Iterator, bool CheckSafe>
+serializer<Iterator, CheckSafe>::serializer(const Iterator begin)
+  : iterator_(begin), end_(begin), valid_(true)
+{
+}
+
+template <typename Iterator, bool CheckSafe>
+serializer<Iterator, CheckSafe>::serializer(const Iterator begin,
+    const Iterator end)
+  : iterator_(begin), end_(end), valid_(true)
 {
 }
 
 // Context.
 //-----------------------------------------------------------------------------
 
-template <typename Iterator>
-serializer<Iterator>::operator bool() const
+template <typename Iterator, bool CheckSafe>
+serializer<Iterator, CheckSafe>::operator bool() const
 {
     return valid_;
 }
 
-template <typename Iterator>
-bool serializer<Iterator>::operator!() const
+template <typename Iterator, bool CheckSafe>
+bool serializer<Iterator, CheckSafe>::operator!() const
 {
     return !valid_;
 }
@@ -52,20 +62,20 @@ bool serializer<Iterator>::operator!() const
 // Hashes.
 //-----------------------------------------------------------------------------
 
-template <typename Iterator>
-void serializer<Iterator>::write_hash(const hash_digest& hash)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_hash(const hash_digest& hash)
 {
     write_forward(hash);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_short_hash(const short_hash& hash)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_short_hash(const short_hash& hash)
 {
     write_forward(hash);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_mini_hash(const mini_hash& hash)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_mini_hash(const mini_hash& hash)
 {
     write_forward(hash);
 }
@@ -73,26 +83,26 @@ void serializer<Iterator>::write_mini_hash(const mini_hash& hash)
 // Big Endian Integers.
 //-----------------------------------------------------------------------------
 
-template <typename Iterator>
-void serializer<Iterator>::write_2_bytes_big_endian(uint16_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_2_bytes_big_endian(uint16_t value)
 {
     write_big_endian(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_4_bytes_big_endian(uint32_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_4_bytes_big_endian(uint32_t value)
 {
     write_big_endian(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_8_bytes_big_endian(uint64_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_8_bytes_big_endian(uint64_t value)
 {
     write_big_endian(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_variable_big_endian(uint64_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_variable_big_endian(uint64_t value)
 {
     if (value < varint_two_bytes)
     {
@@ -115,8 +125,8 @@ void serializer<Iterator>::write_variable_big_endian(uint64_t value)
     }
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_size_big_endian(size_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_size_big_endian(size_t value)
 {
     write_variable_big_endian(value);
 }
@@ -124,32 +134,36 @@ void serializer<Iterator>::write_size_big_endian(size_t value)
 // Little Endian Integers.
 //-----------------------------------------------------------------------------
 
-template <typename Iterator>
-void serializer<Iterator>::write_error_code(const code& ec)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_error_code(const code& ec)
 {
     write_4_bytes_little_endian(static_cast<uint32_t>(ec.value()));
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_2_bytes_little_endian(uint16_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_2_bytes_little_endian(
+    uint16_t value)
 {
     write_little_endian(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_4_bytes_little_endian(uint32_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_4_bytes_little_endian(
+    uint32_t value)
 {
     write_little_endian(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_8_bytes_little_endian(uint64_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_8_bytes_little_endian(
+    uint64_t value)
 {
     write_little_endian(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_variable_little_endian(uint64_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_variable_little_endian(
+    uint64_t value)
 {
     if (value < varint_two_bytes)
     {
@@ -172,8 +186,8 @@ void serializer<Iterator>::write_variable_little_endian(uint64_t value)
     }
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_size_little_endian(size_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_size_little_endian(size_t value)
 {
     write_variable_little_endian(value);
 }
@@ -181,33 +195,41 @@ void serializer<Iterator>::write_size_little_endian(size_t value)
 // Bytes (unchecked).
 //-----------------------------------------------------------------------------
 
-template <typename Iterator>
-void serializer<Iterator>::write_byte(uint8_t value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_byte(uint8_t value)
 {
+    if (!safe(sizeof(uint8_t)))
+        return;
+
     *iterator_++ = value;
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_bytes(const data_chunk& data)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_bytes(const data_chunk& data)
 {
     write_forward(data);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_bytes(const uint8_t* data, size_t size)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_bytes(const uint8_t* data,
+    size_t size)
 {
+    if (!safe(size))
+        return;
+
     iterator_ = std::copy_n(data, size, iterator_);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_string(const std::string& value)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_string(const std::string& value)
 {
     write_variable_little_endian(value.size());
     write_forward(value);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::write_string(const std::string& value, size_t size)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_string(const std::string& value,
+    size_t size)
 {
     const auto length = std::min(size, value.size());
     write_bytes(reinterpret_cast<const uint8_t*>(value.data()), length);
@@ -215,51 +237,66 @@ void serializer<Iterator>::write_string(const std::string& value, size_t size)
     write_bytes(padding);
 }
 
-template <typename Iterator>
-void serializer<Iterator>::skip(size_t size)
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::skip(size_t size)
 {
+    if (!safe(size))
+        return;
+
     iterator_ += size;
 }
 
 // non-interface
 //-------------------------------------------------------------------------
 
-template <typename Iterator>
-void serializer<Iterator>::write_delegated(functor write)
+template <typename Iterator, bool CheckSafe>
+Iterator serializer<Iterator, CheckSafe>::position() const
+{
+    return iterator_;
+}
+
+template <typename Iterator, bool CheckSafe>
+void serializer<Iterator, CheckSafe>::write_delegated(functor write)
 {
     write(*this);
 }
 
-template <typename Iterator>
+template <typename Iterator, bool CheckSafe>
 template <typename Buffer>
-void serializer<Iterator>::write_forward(const Buffer& data)
+void serializer<Iterator, CheckSafe>::write_forward(const Buffer& data)
 {
+    if (!safe(data.size()))
+        return;
+
     iterator_ = std::copy(data.begin(), data.end(), iterator_);
 }
 
-template <typename Iterator>
+template <typename Iterator, bool CheckSafe>
 template <typename Buffer>
-void serializer<Iterator>::write_reverse(const Buffer& data)
+void serializer<Iterator, CheckSafe>::write_reverse(const Buffer& data)
 {
+    if (!safe(data.size()))
+        return;
+
     iterator_ = std::reverse_copy(data.begin(), data.end(), iterator_);
 }
 
-template <typename Iterator>
+template <typename Iterator, bool CheckSafe>
 template <typename Integer>
-void serializer<Iterator>::write_big_endian(Integer value)
+void serializer<Iterator, CheckSafe>::write_big_endian(Integer value)
 {
     return write_forward(to_big_endian(value));
 }
 
-template <typename Iterator>
+template <typename Iterator, bool CheckSafe>
 template <typename Integer>
-void serializer<Iterator>::write_little_endian(Integer value)
+void serializer<Iterator, CheckSafe>::write_little_endian(Integer value)
 {
     return write_forward(to_little_endian(value));
 }
 
-template <typename Iterator>
-size_t serializer<Iterator>::read_size_big_endian()
+template <typename Iterator, bool CheckSafe>
+size_t serializer<Iterator, CheckSafe>::read_size_big_endian()
 {
     static_assert(sizeof(size_t) >= sizeof(uint32_t), "unexpected size");
     const auto prefix = *iterator_++;
@@ -290,8 +327,8 @@ size_t serializer<Iterator>::read_size_big_endian()
     return 0;
 }
 
-template <typename Iterator>
-size_t serializer<Iterator>::read_size_little_endian()
+template <typename Iterator, bool CheckSafe>
+size_t serializer<Iterator, CheckSafe>::read_size_little_endian()
 {
     static_assert(sizeof(size_t) >= sizeof(uint32_t), "unexpected size");
     const auto prefix = *iterator_++;
@@ -322,13 +359,42 @@ size_t serializer<Iterator>::read_size_little_endian()
     return 0;
 }
 
+// private
+
+template <typename Iterator, bool CheckSafe>
+bool serializer<Iterator, CheckSafe>::safe(size_t size)
+{
+    // Bounds checking is disabled for unsafe serializers.
+    if (!CheckSafe)
+        return true;
+
+    // Drop the write and all that follow once the buffer would overflow.
+    if (valid_ && size <= remaining())
+        return true;
+
+    valid_ = false;
+    return false;
+}
+
+template <typename Iterator, bool CheckSafe>
+size_t serializer<Iterator, CheckSafe>::remaining() const
+{
+    return std::distance(iterator_, end_);
+}
+
 // Factories.
 //-----------------------------------------------------------------------------
 
 template <typename Iterator>
-serializer<Iterator> make_unsafe_serializer(Iterator begin)
+serializer<Iterator, true> make_safe_serializer(Iterator begin, Iterator end)
+{
+    return serializer<Iterator, true>(begin, end);
+}
+
+template <typename Iterator>
+serializer<Iterator, false> make_unsafe_serializer(Iterator begin)
 {
-    return serializer<Iterator>(begin);
+    return serializer<Iterator, false>(begin);
 }
 
 } // namespace libbitcoin
@@ -19,7 +19,10 @@
 #define LIBBITCOIN_LOG_FILE_COLLECTOR_HPP
 
 #include <ctime>
+#include <deque>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/filesystem/path.hpp>
@@ -34,8 +37,11 @@
 #include <boost/thread/mutex.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/log/file_counter_formatter.hpp>
+#include <bitcoin/bitcoin/log/rotable_file.hpp>
 
 namespace libbitcoin {
 namespace log {
@@ -50,6 +56,11 @@ typedef boost::filesystem::path::string_type path_string_type;
 typedef boost::intrusive::list_base_hook<boost::intrusive::link_mode<
     boost::intrusive::safe_link>> file_collector_hook;
 
+//! Rotated files are renamed aside in the write path and then moved,
+//! optionally compressed, and aged out of the storage directory on a
+//! background thread, so rotation never blocks the logging thread.
+//! Files left renamed aside by a crash are stored when the log directory is
+//! scanned. zstd compression throws std::invalid_argument before boost 1.70.
 class BC_API file_collector :
     public boost::log::sinks::file::collector,
     public file_collector_hook,
@@ -61,13 +72,18 @@ public:
         boost::filesystem::path const& target_dir,
         size_t max_size,
         size_t min_free_space,
-        size_t max_files);
+        size_t max_files,
+        file_compression compression=file_compression::none);
 
+    //! Archives any pending files before returning
     virtual ~file_collector();
 
-    //! The function stores the specified file in the storage
+    //! The function queues the specified file for storage
     void store_file(boost::filesystem::path const& src_path) override;
 
+    //! Blocks until all queued files have been stored
+    void flush();
+
     //! Scans the target directory for the files that have already been stored
     uintmax_t scan_for_files(boost::log::sinks::file::scan_method method,
         boost::filesystem::path const& pattern, unsigned int* counter) override;
@@ -89,7 +105,33 @@ private:
     //! A list of the stored files
     typedef std::list<file_info> file_list;
 
+    //! A file renamed aside in the write path and awaiting storage
+    struct pending_file
+    {
+        boost::filesystem::path original;
+        boost::filesystem::path renamed;
+    };
+    //! A queue of the files awaiting storage
+    typedef std::deque<pending_file> file_queue;
+
 private:
+    //! The background thread loop, stores queued files until stopped
+    void archive_files();
+
+    //! Moves or compresses a queued file into the storage directory
+    void archive_file(pending_file const& file);
+
+    //! Reserves an unused storage name derived from the original file name
+    boost::filesystem::path reserve_path(
+        boost::filesystem::path const& original);
+
+    //! Queues the files left renamed aside by a previous process
+    void recover_files(boost::filesystem::path const& dir,
+        path_string_type const& mask);
+
+    //! Removes the oldest files until the new file fits the restrictions
+    void erase_files(uintmax_t size);
+
     //! Makes relative path absolute with respect to the base path
     boost::filesystem::path make_absolute(boost::filesystem::path const& path);
 
@@ -130,7 +172,24 @@ private:
     //! Total size of the stored files
     uintmax_t total_size_;
 
+    //! Names of the stored and reserved files, avoids rescanning
+    std::set<path_string_type> names_;
+    //! Next unused counter for each stored file stem and extension
+    std::map<path_string_type, unsigned int> counters_;
+
     file_counter_formatter formatter_;
+    const file_compression compression_;
+
+    //! Queue of renamed files, guarded by queue_mutex_
+    boost::mutex queue_mutex_;
+    boost::condition_variable queue_condition_;
+    file_queue queue_;
+    size_t pending_;
+    size_t sequence_;
+    bool stopped_;
+
+    //! The background archive thread, started last
+    boost::thread worker_;
 };
 
 } // namespace log
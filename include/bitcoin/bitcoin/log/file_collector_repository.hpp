@@ -38,7 +38,8 @@ public:
     //! Finds or creates a file collector
     boost::shared_ptr<boost::log::sinks::file::collector> get_collector(
         boost::filesystem::path const& target_dir, size_t max_size,
-        size_t min_free_space, size_t max_files);
+        size_t min_free_space, size_t max_files,
+        file_compression compression=file_compression::none);
 
     //! Removes the file collector from the list
     void remove_collector(file_collector* collector);
@@ -80,7 +81,8 @@ BC_API boost::shared_ptr<boost::log::sinks::file::collector> make_collector(
     boost::filesystem::path const& target_dir,
     size_t max_size,
     size_t min_free_space,
-    size_t max_files = (std::numeric_limits<size_t>::max)()
+    size_t max_files = (std::numeric_limits<size_t>::max)(),
+    file_compression compression = file_compression::none
 );
 
 } // namespace log
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_LOG_RING_BUFFER_QUEUE_HPP
+#define LIBBITCOIN_LOG_RING_BUFFER_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <boost/log/core/record_view.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+/// Behavior of an asynchronous sink when its queue is full.
+enum class overflow_policy
+{
+    /// Discard the record.
+    drop,
+
+    /// Wait for the writer thread to make space.
+    block,
+
+    /// Above three quarters full admit one of each sample_rate records,
+    /// excluding warnings and errors, and discard when full.
+    sample
+};
+
+/// This class is thread safe.
+/// Boost log queueing strategy for asynchronous_sink, a bounded lock-free
+/// ring buffer (multiple producer, multiple consumer). Producers take a lock
+/// only to sleep when blocked on a full queue, the consuming writer thread
+/// sleeps only when the queue is empty.
+/// Capacity must be a power of two.
+template <size_t Capacity>
+class ring_buffer_queue
+{
+public:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two.");
+
+    /// One of this many records is admitted while sampling.
+    static const size_t sample_rate = 16;
+
+    /// Set the overflow policy, block by default.
+    void set_overflow_policy(overflow_policy policy);
+
+    /// The number of records discarded due to overflow.
+    size_t dropped() const;
+
+protected:
+    ring_buffer_queue();
+
+    template <typename Arguments>
+    explicit ring_buffer_queue(const Arguments& arguments);
+
+    // Queueing strategy interface.
+    void enqueue(const boost::log::record_view& record);
+    bool try_enqueue(const boost::log::record_view& record);
+    bool try_dequeue_ready(boost::log::record_view& record);
+    bool try_dequeue(boost::log::record_view& record);
+    bool dequeue_ready(boost::log::record_view& record);
+    void interrupt_dequeue();
+
+private:
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        boost::log::record_view record;
+    };
+
+    size_t size() const;
+    bool admit(const boost::log::record_view& record);
+    bool push(const boost::log::record_view& record);
+    bool pop(boost::log::record_view& record);
+    bool take(boost::log::record_view& record);
+    void wait_for_space();
+    void notify();
+
+    // These are thread safe.
+    std::vector<cell> cells_;
+    std::atomic<size_t> enqueue_;
+    std::atomic<size_t> dequeue_;
+    std::atomic<size_t> dropped_;
+    std::atomic<size_t> sampled_;
+    std::atomic<overflow_policy> policy_;
+    std::atomic<size_t> blocked_;
+    std::atomic<bool> waiting_;
+    std::atomic<bool> interrupted_;
+
+    // These are used only to sleep the consumer while the queue is empty.
+    boost::mutex mutex_;
+    boost::condition_variable condition_;
+
+    // These are used only to sleep blocked producers while the queue is full.
+    boost::mutex space_mutex_;
+    boost::condition_variable space_;
+};
+
+} // namespace log
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/log/ring_buffer_queue.ipp>
+
+#endif
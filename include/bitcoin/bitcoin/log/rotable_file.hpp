@@ -29,6 +29,16 @@ namespace log {
 typedef boost::shared_ptr<std::ostream> stream;
 typedef boost::log::formatting_ostream::ostream_type formatter;
 
+/// Compression applied to rotated files as they are archived.
+/// The zero value is none, so an aggregate initializer that omits the
+/// member (as existing callers do) archives without compression.
+enum class file_compression
+{
+    none,
+    gzip,
+    zstd
+};
+
 struct rotable_file
 {
     boost::filesystem::path original_log;
@@ -37,6 +47,7 @@ struct rotable_file
     size_t minimum_free_space;
     size_t maximum_archive_size;
     size_t maximum_archive_files;
+    file_compression archive_compression;
 };
 
 } // namespace log
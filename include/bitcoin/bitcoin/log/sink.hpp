@@ -22,6 +22,7 @@
 #include <iostream>
 #include <boost/smart_ptr.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/log/ring_buffer_queue.hpp>
 #include <bitcoin/bitcoin/log/rotable_file.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 #include <bitcoin/bitcoin/unicode/ofstream.hpp>
@@ -39,6 +40,20 @@ void initialize(log::file& debug_file, log::file& error_file,
 void initialize(const rotable_file& debug_file, const rotable_file& error_file,
     log::stream& output_stream, log::stream& error_stream, bool verbose);
 
+/// Initializes default non-rotable libbitcoin logging sinks and formats.
+/// Each sink queues records to its own writer thread, formatting and i/o are
+/// performed by the writer. Flush the logging core before exit.
+void initialize(log::file& debug_file, log::file& error_file,
+    log::stream& output_stream, log::stream& error_stream, bool verbose,
+    overflow_policy policy);
+
+/// Initializes default rotable libbitcoin logging sinks and formats.
+/// Each sink queues records to its own writer thread, formatting and i/o are
+/// performed by the writer. Flush the logging core before exit.
+void initialize(const rotable_file& debug_file, const rotable_file& error_file,
+    log::stream& output_stream, log::stream& error_stream, bool verbose,
+    overflow_policy policy);
+
 /// Log stream operator.
 formatter& operator<<(formatter& stream, severity value);
 
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_LOG_STATSD_AGGREGATOR_HPP
+#define LIBBITCOIN_LOG_STATSD_AGGREGATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/tss.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+/// This class is thread safe.
+/// Asynchronous statsd pipeline. Metrics are aggregated in per-thread
+/// buffers, without formatting, locking of shared state or system calls.
+/// On each interval the buffers are merged, timer percentiles are computed
+/// locally, and the result is sent as multi-metric packets up to mtu bytes.
+/// As a boost log backend this consumes records of the BC_STATS macros, and
+/// it may also be fed directly for the lowest possible emission cost.
+/// The instance is stopped and flushed when its last owner releases it.
+class BC_API statsd_aggregator
+  : public boost::log::sinks::basic_sink_backend<
+        boost::log::sinks::concurrent_feeding>,
+    public boost::enable_shared_from_this<statsd_aggregator>
+{
+public:
+    using udp = boost::asio::ip::udp;
+    typedef boost::shared_ptr<statsd_aggregator> ptr;
+    typedef boost::shared_ptr<udp::socket> socket_ptr;
+    typedef boost::shared_ptr<udp::endpoint> endpoint_ptr;
+
+    /// Safe payload size for internet paths, use 8932 for jumbo frames.
+    static const size_t default_mtu;
+
+    /// The statsd default flush interval.
+    static const asio::duration default_interval;
+
+    statsd_aggregator(threadpool& pool, socket_ptr socket,
+        endpoint_ptr endpoint, const asio::duration& interval=default_interval,
+        size_t mtu=default_mtu);
+
+    ~statsd_aggregator();
+
+    /// Begin periodic flushing.
+    void start();
+
+    /// Stop periodic flushing and flush any remaining metrics.
+    void stop();
+
+    /// Add to a counter, scaled by the inverse of the sample rate.
+    void counter(const std::string& name, int64_t value, float rate=1.0f);
+
+    /// Set a gauge, the most recent value of any thread is retained.
+    void gauge(const std::string& name, uint64_t value);
+
+    /// Add a timer sample, summarized as count, bounds, mean and percentiles.
+    void timer(const std::string& name, const asio::milliseconds& value);
+
+    /// Merge all thread buffers and send the result.
+    void flush();
+
+    /// Boost log backend record consumer.
+    void consume(const boost::log::record_view& record);
+
+protected:
+    typedef std::vector<std::string> lines;
+    typedef boost::shared_ptr<std::string> message_ptr;
+
+    struct gauge_value
+    {
+        uint64_t value;
+        uint64_t sequence;
+    };
+
+    struct buffer
+    {
+        std::map<std::string, double> counters;
+        std::map<std::string, gauge_value> gauges;
+        std::map<std::string, std::vector<uint64_t>> timers;
+        mutable shared_mutex mutex;
+    };
+
+    typedef std::shared_ptr<buffer> buffer_ptr;
+
+    buffer& local();
+    void summarize(const std::string& name, std::vector<uint64_t>& samples,
+        lines& out) const;
+    void send(const lines& out);
+    void send(message_ptr payload);
+    void schedule();
+    void handle_timer(const code& ec);
+
+private:
+    // These are thread safe.
+    threadpool& pool_;
+    socket_ptr socket_;
+    const endpoint_ptr endpoint_;
+    const asio::duration interval_;
+    const size_t mtu_;
+    std::atomic<bool> stopped_;
+    std::atomic<uint64_t> sequence_;
+    deadline::ptr timer_;
+    boost::thread_specific_ptr<buffer_ptr> local_;
+
+    // These are protected by mutex.
+    std::vector<buffer_ptr> buffers_;
+    mutable shared_mutex buffers_mutex_;
+
+    // This serializes flushes.
+    mutable shared_mutex flush_mutex_;
+};
+
+} // namespace log
+} // namespace libbitcoin
+
+#endif
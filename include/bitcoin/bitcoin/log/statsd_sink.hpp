@@ -23,6 +23,8 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/log/rotable_file.hpp>
+#include <bitcoin/bitcoin/log/statsd_aggregator.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
@@ -32,6 +34,14 @@ void initialize_statsd(const rotable_file& file);
 
 void initialize_statsd(threadpool& pool, const config::authority& server);
 
+/// Initializes an aggregating statsd sink that sends on the given interval.
+/// Records are consumed without a sink lock and without formatting or i/o on
+/// the emitting thread. The aggregator may also be fed directly. Stop it
+/// before the threadpool is joined, so that the final interval is sent.
+statsd_aggregator::ptr initialize_statsd(threadpool& pool,
+    const config::authority& server, const asio::duration& interval,
+    size_t mtu=statsd_aggregator::default_mtu);
+
 } // namespace log
 } // namespace libbitcoin
 
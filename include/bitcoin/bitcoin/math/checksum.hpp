@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -95,6 +96,12 @@ BC_API void append_checksum(data_chunk& data);
  */
 BC_API uint32_t bitcoin_checksum(data_slice data);
 
+/**
+ * Generate a bitcoin hash checksum of the concatenation of discontiguous
+ * slices, such as a payload serialized into a sequence of buffers.
+ */
+BC_API uint32_t bitcoin_checksum(const std::vector<data_slice>& slices);
+
 /**
  * Verifies the last four bytes of a data chunk are a valid checksum of the
  * earlier bytes. This is typically used to verify base58 data.
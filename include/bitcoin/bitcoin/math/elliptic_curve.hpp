@@ -34,6 +34,8 @@ static BC_CONSTEXPR uint8_t ec_even_sign = 2;
 static BC_CONSTEXPR size_t ec_secret_size = 32;
 typedef byte_array<ec_secret_size> ec_secret;
 
+typedef std::vector<ec_secret> secret_list;
+
 /// Compressed public key:
 static BC_CONSTEXPR size_t ec_compressed_size = 33;
 typedef byte_array<ec_compressed_size> ec_compressed;
@@ -44,6 +46,8 @@ typedef std::vector<ec_compressed> point_list;
 static BC_CONSTEXPR size_t ec_uncompressed_size = 65;
 typedef byte_array<ec_uncompressed_size> ec_uncompressed;
 
+typedef std::vector<ec_uncompressed> uncompressed_list;
+
 // Parsed ECDSA signature:
 static BC_CONSTEXPR size_t ec_signature_size = 64;
 typedef byte_array<ec_signature_size> ec_signature;
@@ -119,6 +123,18 @@ BC_API bool secret_to_public(ec_compressed& out, const ec_secret& secret);
 /// Convert a secret parameter to an uncompressed public point.
 BC_API bool secret_to_public(ec_uncompressed& out, const ec_secret& secret);
 
+/// Convert each of a set of secrets to a compressed public point, in
+/// parallel (threads zero for hardware concurrency). The point of an
+/// invalid secret is null and the result is false.
+BC_API bool secret_to_public(point_list& out, const secret_list& secrets,
+    size_t threads=0);
+
+/// Convert each of a set of secrets to an uncompressed public point, in
+/// parallel (threads zero for hardware concurrency). The point of an
+/// invalid secret is null and the result is false.
+BC_API bool secret_to_public(uncompressed_list& out,
+    const secret_list& secrets, size_t threads=0);
+
 // Verify keys
 // ----------------------------------------------------------------------------
 
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_GOLOMB_CODED_SET_HPP
+#define LIBBITCOIN_GOLOMB_CODED_SET_HPP
+
+#include <cstdint>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// Golomb-coded sets (BIP158). Each item is hashed with siphash to the range
+/// [0, count * rate), and the sorted differences are Golomb-Rice coded with
+/// the given number of remainder bits (1-32). The item count is not encoded.
+
+/// Construct the set of the items, which should be distinct.
+BC_API data_chunk golomb_construct(const data_stack& items, uint8_t bits,
+    uint64_t rate, const siphash_key& key);
+
+/// True if the set of count items contains the target (or a collision).
+BC_API bool golomb_match(data_slice set, uint64_t count, data_slice target,
+    uint8_t bits, uint64_t rate, const siphash_key& key);
+
+/// True if the set of count items contains any of the targets.
+/// The targets are hashed and sorted and the set is decoded only once.
+BC_API bool golomb_match(data_slice set, uint64_t count,
+    const data_stack& targets, uint8_t bits, uint64_t rate,
+    const siphash_key& key);
+
+} // namespace libbitcoin
+
+#endif
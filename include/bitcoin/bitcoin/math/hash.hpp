@@ -115,18 +115,34 @@ inline uint256_t to_uint256(const hash_digest& hash)
 /// Generate a scrypt hash to fill a byte array.
 template <size_t Size>
 byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
-    uint32_t p, uint32_t r);
+    uint32_t p, uint32_t r, size_t threads=1);
 
 /// Generate a scrypt hash of specified length.
+/// The p lanes are mixed on up to threads threads (zero for the hardware
+/// concurrency), each thread allocating 128 * r * N bytes. By default the
+/// lanes are mixed in turn on the calling thread.
 BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
-    uint32_t p, uint32_t r, size_t length);
+    uint32_t p, uint32_t r, size_t length, size_t threads=1);
 
 /// Generate a bitcoin hash.
 BC_API hash_digest bitcoin_hash(data_slice data);
 
+/// Generate a bitcoin hash of the concatenation of discontiguous slices.
+BC_API hash_digest bitcoin_hash(const std::vector<data_slice>& slices);
+
+/// Generate a bitcoin hash of an 80 byte message (a block header). The
+/// padding of both rounds is fixed, so the three sha256 blocks are
+/// transformed directly, without buffering.
+BC_API hash_digest bitcoin_hash(const byte_array<80>& message);
+
 /// Generate a bitcoin short hash.
 BC_API short_hash bitcoin_short_hash(data_slice data);
 
+/// Generate the bitcoin short hash of each of the independent slices.
+/// Slices are hashed four at a time, in lanes of similar length.
+BC_API short_hash_list bitcoin_short_hashes(
+    const std::vector<data_slice>& data);
+
 /// Generate a ripemd160 hash
 BC_API short_hash ripemd160_hash(data_slice data);
 BC_API data_chunk ripemd160_hash_chunk(data_slice data);
@@ -152,6 +168,11 @@ BC_API long_hash sha512_hash(data_slice data);
 /// Generate a hmac sha512 hash.
 BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 
+/// Generate a hmac sha512 hash of each data element under the same key.
+/// The keyed (padded) hash state is computed once for the set.
+BC_API long_hash_list hmac_sha512_hash(const data_stack& data,
+    data_slice key);
+
 /// Generate a pkcs5 pbkdf2 hmac sha512 hash.
 BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations);
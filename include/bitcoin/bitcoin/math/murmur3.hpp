@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MURMUR3_HPP
+#define LIBBITCOIN_MURMUR3_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// Generate a murmur3 (x86, 32 bit) hash of the data.
+BC_API uint32_t murmur3(data_slice data, uint32_t seed);
+
+/// Generate a murmur3 (x86, 32 bit) hash of the data for each of count seeds.
+/// The data is read once and seeds are processed in interleaved groups.
+BC_API void murmur3(data_slice data, const uint32_t* seeds, uint32_t* hashes,
+    size_t count);
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIPHASH_HPP
+#define LIBBITCOIN_SIPHASH_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// A siphash key is a pair of 64 bit integers (k0, k1).
+typedef std::pair<uint64_t, uint64_t> siphash_key;
+typedef std::vector<siphash_key> siphash_key_list;
+
+/// Convert a 16 byte value to a siphash key (two little endian integers).
+BC_API siphash_key to_siphash_key(const half_hash& value);
+
+/// Generate a siphash-2-4 hash of the message.
+BC_API uint64_t siphash(const siphash_key& key, data_slice message);
+
+/// Generate a siphash-2-4 hash of a 32 byte hash (fixed length).
+BC_API uint64_t siphash(const siphash_key& key, const hash_digest& hash);
+
+/// Generate a siphash-2-4 hash of each hash, for one key.
+/// The key is expanded once for all hashes.
+BC_API std::vector<uint64_t> siphash(const siphash_key& key,
+    const hash_list& hashes);
+
+/// Generate a siphash-2-4 hash of the hash, for each of a list of keys.
+/// The message is decoded once and keys are processed in interleaved groups.
+BC_API std::vector<uint64_t> siphash(const siphash_key_list& keys,
+    const hash_digest& hash);
+
+} // namespace libbitcoin
+
+#endif
@@ -27,9 +27,11 @@
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/encoding.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -69,6 +71,17 @@ public:
     void to_data(uint32_t version, writer& sink) const;
     size_t serialized_size(uint32_t version) const;
 
+    /// The wire encoding for the magic, serialized and checksummed once and
+    /// then shared by all callers. The block payload does not vary by
+    /// protocol version, so the cached encoding serves any version. The cache
+    /// is reset by deserialization and assignment of this class, the block
+    /// should not otherwise be modified once encoded.
+    encoding::const_ptr encode(uint32_t version, uint32_t magic) const;
+
+    /// Retain the encoding from which the block was received, so that it may
+    /// be relayed or stored without reencoding.
+    void set_encoding(encoding::const_ptr value);
+
     block& operator=(chain::block&& other);
 
     // This class is move assignable but not copy assignable.
@@ -84,6 +97,10 @@ public:
     static const std::string command;
     static const uint32_t version_minimum;
     static const uint32_t version_maximum;
+
+private:
+    mutable encoding::const_ptr encoding_;
+    mutable upgrade_mutex encoding_mutex_;
 };
 
 } // namespace message
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOCK_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_BLOCK_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// Compact block filter (BIP158) of the basic type, for light clients. The
+/// filter is the element count (variable integer) followed by a Golomb-coded
+/// set keyed by the block hash. Matching decodes the set once for any number
+/// of elements. Filters commit to the chain through the filter header chain.
+class BC_API block_filter
+{
+public:
+    /// Basic filter parameters (P and M).
+    static const uint8_t basic_bits;
+    static const uint64_t basic_rate;
+
+    /// The filter header of the filter hash, given the previous filter header
+    /// (null_hash for the genesis block).
+    static hash_digest to_header(const hash_digest& filter_hash,
+        const hash_digest& previous_header);
+
+    /// The filter headers of a sequence of filter hashes.
+    static hash_list to_headers(const hash_list& filter_hashes,
+        const hash_digest& previous_header);
+
+    /// An empty (invalid) filter.
+    block_filter();
+
+    /// The serialized filter of the block with the given hash.
+    block_filter(const hash_digest& block_hash, const data_chunk& data);
+    block_filter(const hash_digest& block_hash, data_chunk&& data);
+
+    /// The basic filter of the block, from all output scripts (excluding
+    /// empty and null data) and the previous output scripts spent by the
+    /// block. Previous outputs must be populated (previous_output().validation
+    /// .cache), otherwise the filter is invalid.
+    block_filter(const chain::block& block);
+
+    /// True if the filter was constructed or its element count was parsed.
+    bool is_valid() const;
+
+    const hash_digest& block_hash() const;
+    const data_chunk& data() const;
+
+    /// The number of elements in the filter.
+    uint64_t size() const;
+
+    /// The hash of the serialized filter.
+    hash_digest hash() const;
+
+    /// The filter header, given the previous filter header.
+    hash_digest header(const hash_digest& previous_header) const;
+
+    /// True if the element is in the filter (or a false positive).
+    bool match(data_slice element) const;
+
+    /// True if any of the elements is in the filter (or a false positive).
+    bool match(const data_stack& elements) const;
+
+private:
+    void parse();
+    siphash_key key() const;
+
+    hash_digest block_hash_;
+    data_chunk data_;
+    uint64_t size_;
+    size_t offset_;
+    bool valid_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
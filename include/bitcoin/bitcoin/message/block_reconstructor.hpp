@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOCK_RECONSTRUCTOR_HPP
+#define LIBBITCOIN_MESSAGE_BLOCK_RECONSTRUCTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// Reconstructs a block from a compact block (BIP152) and candidate
+/// transactions, such as those of the memory pool. Slots that are not
+/// prefilled or matched by short id are requested as get_block_transactions
+/// and filled from the block_transactions response.
+/// Indexes in these messages are differentially encoded, as on the wire.
+/// This class is not thread safe.
+class BC_API block_reconstructor
+  : noncopyable
+{
+public:
+    block_reconstructor(const compact_block& block);
+
+    /// False if the compact block is malformed or its short ids collide,
+    /// in which case the full block should be requested.
+    bool is_valid() const;
+
+    /// True if all slots have been filled.
+    bool is_complete() const;
+
+    /// The number of slots not yet filled.
+    size_t missing_count() const;
+
+    /// Fill empty slots from candidates matching their short id, returning
+    /// the number of slots filled by this call. A slot matched by more than
+    /// one distinct candidate, in this or a prior call, is emptied and left
+    /// to be requested.
+    size_t fill(const transaction::const_ptr_list& candidates);
+
+    /// The request for all empty slots.
+    get_block_transactions missing() const;
+
+    /// Fill all empty slots from the response to missing(), in order.
+    /// False if the response is for another block or of the wrong size.
+    bool fill(const block_transactions& response);
+
+    /// Obtain the reconstructed block, false if incomplete or if the merkle
+    /// root does not match (a short id collision), in which case the full
+    /// block should be requested.
+    bool to_block(chain::block& out) const;
+
+private:
+    typedef std::unordered_map<uint64_t, size_t> slot_map;
+
+    static uint64_t to_key(const compact_block::short_id& id);
+    bool initialize(const compact_block& block);
+
+    const chain::header header_;
+    const siphash_key key_;
+    slot_map slots_;
+    transaction::const_ptr_list transactions_;
+    std::vector<bool> ambiguous_;
+    size_t missing_;
+    bool valid_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
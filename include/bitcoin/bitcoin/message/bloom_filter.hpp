@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/filter_add.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// Connection bloom filter (BIP37), as loaded by filter_load and extended by
+/// filter_add. Each element is hashed with murmur3 for all of the filter's
+/// hash function seeds at once. Transaction hashes and script operations are
+/// cached on the transaction, so matching one block against the filters of
+/// many peers hashes each element but parses each script only once.
+/// This class is not thread safe.
+class BC_API bloom_filter
+{
+public:
+    /// Filter update flags, applied to matched outputs.
+    enum update: uint8_t
+    {
+        // Do not update the filter.
+        none = 0,
+
+        // Insert the outpoint of any output with a matching data push.
+        all = 1,
+
+        // As all, but only for pay to public key and multisig outputs.
+        p2pubkey_only = 2,
+
+        mask = 3
+    };
+
+    /// An empty filter, which matches nothing.
+    bloom_filter();
+
+    /// The filter loaded by the message.
+    bloom_filter(const filter_load& message);
+
+    /// A filter sized for the number of elements and false positive rate.
+    bloom_filter(size_t elements, double false_positive_rate, uint32_t tweak,
+        uint8_t flags);
+
+    /// True if the filter is within the protocol size limits.
+    bool is_valid() const;
+
+    const data_chunk& data() const;
+    size_t hash_functions() const;
+    uint32_t tweak() const;
+    uint8_t flags() const;
+
+    /// The message to load this filter into a peer.
+    filter_load to_filter_load() const;
+
+    /// Insert the data of the message, false if the data is oversized.
+    bool add(const filter_add& message);
+
+    void insert(data_slice element);
+    void insert(const chain::point& point);
+    bool contains(data_slice element) const;
+    bool contains(const chain::point& point) const;
+
+    /// Match a transaction by hash, output data pushes, previous outpoints
+    /// and input data pushes, inserting matched outpoints per the flags.
+    bool match(const chain::transaction& tx);
+
+    /// Match each transaction of the block (in order, as updates apply to
+    /// subsequent transactions), for construction of a merkle_block.
+    std::vector<bool> match(const chain::block& block);
+
+private:
+    void hash(data_slice element, uint32_t* indexes) const;
+
+    data_chunk filter_;
+    std::vector<uint32_t> seeds_;
+    uint32_t tweak_;
+    uint8_t flags_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
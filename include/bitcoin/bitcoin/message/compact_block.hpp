@@ -21,7 +21,10 @@
 
 #include <istream>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/message/prefilled_transaction.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -53,6 +56,9 @@ public:
     compact_block(const compact_block& other);
     compact_block(compact_block&& other);
 
+    /// Construct from a block, prefilling the coinbase (BIP152).
+    compact_block(const chain::block& block, uint64_t nonce);
+
     chain::header& header();
     const chain::header& header() const;
     void set_header(const chain::header& value);
@@ -71,6 +77,13 @@ public:
     void set_transactions(const prefilled_transaction::list& value);
     void set_transactions(prefilled_transaction::list&& value);
 
+    /// The short id siphash key, from the header and nonce (BIP152).
+    siphash_key short_id_key() const;
+
+    /// The short id of a transaction hash for the key (BIP152).
+    static short_id to_short_id(const siphash_key& key,
+        const hash_digest& hash);
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_ENCODING_HPP
+#define LIBBITCOIN_MESSAGE_ENCODING_HPP
+
+#include <cstdint>
+#include <memory>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// An immutable wire encoding of a message, the heading and its payload.
+/// This is shared by pointer so that a message sent to many peers is
+/// serialized and checksummed only once.
+class BC_API encoding
+{
+public:
+    typedef std::shared_ptr<const encoding> const_ptr;
+
+    /// Take ownership of a complete encoding (heading and payload).
+    encoding(uint32_t version, uint32_t magic, data_chunk&& data);
+
+    /// Copy a received payload behind its (checksum verified) heading.
+    encoding(uint32_t version, const heading& head, data_slice payload);
+
+    encoding(const encoding&) = delete;
+    void operator=(const encoding&) = delete;
+
+    /// The protocol version with which the payload was encoded.
+    uint32_t version() const;
+
+    /// The network magic of the heading.
+    uint32_t magic() const;
+
+    /// The heading followed by the payload.
+    const data_chunk& data() const;
+
+    /// The payload without the heading.
+    data_slice payload() const;
+
+private:
+    const uint32_t version_;
+    const uint32_t magic_;
+    const data_chunk data_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
@@ -24,7 +24,9 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/header.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
@@ -59,6 +61,16 @@ public:
     void set_elements(header::list&& values);
 
     bool is_sequential() const;
+
+    /// Hash each header and check its proof of work and timestamp in
+    /// parallel (caching each hash), then verify that each header links to
+    /// the one before it. Returns the first failure in header order.
+    code check() const;
+
+    /// Accept each header in order against the chain state derived from its
+    /// parent, starting from the state of the first header's parent, and set
+    /// each accepted header's validation state and height.
+    code accept(chain::chain_state::ptr parent) const;
     void to_hashes(hash_list& out) const;
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
@@ -22,6 +22,7 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
@@ -49,6 +50,10 @@ public:
     merkle_block(chain::header&& header, size_t total_transactions,
         hash_list&& hashes, data_chunk&& flags);
     merkle_block(const chain::block& block);
+
+    /// A partial merkle tree (BIP37) of the block for the matched
+    /// transactions, with one match flag for each transaction of the block.
+    merkle_block(const chain::block& block, const std::vector<bool>& matches);
     merkle_block(const merkle_block& other);
     merkle_block(merkle_block&& other);
 
@@ -70,6 +75,11 @@ public:
     void set_flags(const data_chunk& value);
     void set_flags(data_chunk&& value);
 
+    /// Extract the matched transaction hashes and their block positions,
+    /// false if the partial merkle tree is malformed or does not commit to
+    /// the merkle root of the header.
+    bool extract(hash_list& matches, std::vector<size_t>& positions) const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstddef>
+#include <memory>
+#include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/address.hpp>
 #include <bitcoin/bitcoin/message/alert.hpp>
@@ -29,6 +31,7 @@
 #include <bitcoin/bitcoin/message/block.hpp>
 #include <bitcoin/bitcoin/message/block_transactions.hpp>
 #include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/encoding.hpp>
 #include <bitcoin/bitcoin/message/fee_filter.hpp>
 #include <bitcoin/bitcoin/message/filter_add.hpp>
 #include <bitcoin/bitcoin/message/filter_clear.hpp>
@@ -54,8 +57,9 @@
 #include <bitcoin/bitcoin/message/transaction.hpp>
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
+#include <bitcoin/bitcoin/utility/buffer_writer.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 
 // Minimum current libbitcoin protocol version:     31402
 // Minimum current satoshi client protocol version: 31800
@@ -147,6 +151,7 @@ DECLARE_MESSAGE_POINTER_LIST_POINTER_TYPES(transaction);
 namespace message {
 
 /// Serialize a message object to the Bitcoin wire protocol encoding.
+/// Returns empty if the payload does not match its serialized size.
 template <typename Message>
 data_chunk serialize(uint32_t version, const Message& packet,
     uint32_t magic)
@@ -155,37 +160,64 @@ data_chunk serialize(uint32_t version, const Message& packet,
     const auto payload_size = packet.serialized_size(version);
     const auto message_size = heading_size + payload_size;
 
-    // Unfortunately data_sink doesn't support seek, so this is a little ugly.
-    // The header requires payload size and checksum but prepends the payload.
-    // Use a stream to prevent unnecessary copying of the payload.
-    data_chunk data;
+    // The heading requires payload size and checksum but prepends the payload.
+    // Size the buffer for the full message and serialize the payload directly
+    // into it following the heading, bypassing the stream. The serializer is
+    // bounded so that a serialized_size error cannot overflow the buffer.
+    data_chunk data(message_size);
+    auto payload = make_safe_serializer(data.begin() + heading_size,
+        data.end());
+    packet.to_data(version, payload);
 
-    // Reserve memory for the full message.
-    data.reserve(message_size);
-
-    // Size the vector for the heading so that payload insertion will follow.
-    data.resize(heading_size);
-
-    // Insert the payload after the heading and into the reservation.
-    data_sink ostream(data);
-    packet.to_data(version, ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == message_size);
+    if (!payload || payload.position() != data.end())
+        return{};
 
     // Create the payload checksum without copying the buffer.
     data_slice slice(data.data() + heading_size, data.data() + message_size);
     const auto check = bitcoin_checksum(slice);
     const auto payload_size32 = safe_unsigned<uint32_t>(payload_size);
 
-    // Create and serialize the heading to a temporary variable (12 bytes).
+    // Serialize the heading into the beginning of the message buffer.
     heading head(magic, Message::command, payload_size32, check);
-    auto heading = head.to_data();
-
-    // Move the heading into the allocated beginning of the message buffer.
-    std::move(heading.begin(), heading.end(), data.begin());
+    auto prefix = make_unsafe_serializer(data.begin());
+    head.to_data(prefix);
     return data;
 }
 
+/// Serialize a message object to the Bitcoin wire protocol encoding, appended
+/// to the pooled buffers of the sink, for a vectored write of sink.buffers().
+/// This avoids allocating a contiguous buffer for large messages.
+template <typename Message>
+void serialize(uint32_t version, const Message& packet, uint32_t magic,
+    buffer_writer& sink)
+{
+    const auto heading_size = heading::satoshi_fixed_size();
+    const auto start = sink.size();
+
+    // Reserve the heading, which requires the payload size and checksum.
+    sink.skip(heading_size);
+    packet.to_data(version, sink);
+
+    // Create the payload checksum across the buffers without copying them.
+    const auto payload_size = sink.size() - start - heading_size;
+    const auto check = bitcoin_checksum(sink.slices(start + heading_size));
+    const auto payload_size32 = safe_unsigned<uint32_t>(payload_size);
+
+    // Serialize the heading into its reservation.
+    heading head(magic, Message::command, payload_size32, check);
+    sink.write_at(start, head.to_data());
+}
+
+/// Serialize a message object once into a shareable wire encoding.
+/// Blocks and transactions cache this, see block::encode.
+template <typename Message>
+encoding::const_ptr encode(uint32_t version, const Message& packet,
+    uint32_t magic)
+{
+    return std::make_shared<const encoding>(version, magic,
+        serialize(version, packet, magic));
+}
+
 BC_API size_t variable_uint_size(uint64_t value);
 
 } // namespace message
@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_PARSER_HPP
+#define LIBBITCOIN_MESSAGE_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/message/block.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// Resumable, non-blocking parser for the wire protocol message framing.
+/// Bytes are accepted in pieces of any size as they arrive from a socket.
+/// Each heading is validated as soon as it is complete. Each payload is
+/// checksummed as it arrives and deserialized into its subscribed type.
+/// A payload that arrives whole in one piece is deserialized in place.
+/// Otherwise it is accumulated into a buffer that is reused across messages.
+/// Payloads of unsubscribed commands are skipped without buffering.
+/// Blocks and transactions may retain their received encoding for relay.
+/// This class is not thread safe.
+class BC_API parser
+  : noncopyable
+{
+public:
+    template <class Message>
+    using handler = std::function<void(typename Message::const_ptr)>;
+
+    parser(uint32_t magic, uint32_t version);
+    ~parser();
+
+    /// The protocol version used to deserialize payloads.
+    uint32_t version() const;
+    void set_version(uint32_t version);
+
+    /// The number of payload bytes held in the buffer.
+    size_t buffered() const;
+
+    /// Set received blocks and transactions to retain their encoding, so
+    /// that they may be relayed or stored without reencoding (one copy).
+    void set_retain_encoding(bool value);
+
+    /// Deserialize messages of the command of Message and pass to handler.
+    /// Subscribe before parsing, a subsequent subscription replaces this.
+    template <class Message>
+    void subscribe(handler<Message>&& handler);
+
+    /// Parse the next piece of the byte stream, invoking handlers in order.
+    /// Returns error::bad_stream on an invalid heading, oversized payload,
+    /// checksum mismatch or undeserializable payload. After failure the
+    /// parser returns the same failure until reset.
+    code parse(data_slice data);
+
+    /// Clear all partial state and any failure, retaining subscriptions.
+    void reset();
+
+private:
+    typedef std::function<bool(uint32_t, const heading&, data_slice, bool)>
+        loader;
+    typedef std::unordered_map<std::string, loader> loaders;
+    struct checksum_context;
+
+    template <class Message>
+    static void retain(Message& message, uint32_t version,
+        const heading& head, data_slice payload);
+    static void retain(block& message, uint32_t version, const heading& head,
+        data_slice payload);
+    static void retain(transaction& message, uint32_t version,
+        const heading& head, data_slice payload);
+
+    void subscribe(const std::string& command, loader&& load);
+    size_t parse_heading(const uint8_t* begin, size_t size);
+    size_t parse_payload(const uint8_t* begin, size_t size);
+    code start_payload();
+    code complete_payload(const uint8_t* begin, size_t size,
+        uint32_t checksum);
+
+    const uint32_t magic_;
+    uint32_t version_;
+    loaders loaders_;
+    bool retain_encoding_;
+    code error_;
+
+    // Heading state, the heading is of fixed size (24 bytes).
+    byte_array<24> heading_buffer_;
+    size_t heading_filled_;
+    heading heading_;
+
+    // Payload state.
+    const loader* loader_;
+    size_t payload_remaining_;
+    data_chunk payload_;
+    std::unique_ptr<checksum_context> checksum_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/message/parser.ipp>
+
+#endif
@@ -27,9 +27,11 @@
 #include <bitcoin/bitcoin/chain/input.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/message/encoding.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -70,6 +72,17 @@ public:
     void to_data(uint32_t version, writer& sink) const;
     size_t serialized_size(uint32_t version) const;
 
+    /// The wire encoding for the magic, created once and shared by each
+    /// relay of the transaction to peers. The serialization of a transaction
+    /// does not vary by protocol version, so neither does the encoding.
+    /// Deserialization and assignment reset the cache, so do not otherwise
+    /// modify an encoded transaction.
+    encoding::const_ptr encode(uint32_t version, uint32_t magic) const;
+
+    /// Retain the encoding of a received transaction, such as for relay from
+    /// the memory pool without reencoding.
+    void set_encoding(encoding::const_ptr value);
+
     transaction& operator=(chain::transaction&& other);
 
     /// This class is move assignable but not copy assignable.
@@ -85,6 +98,10 @@ public:
     static const std::string command;
     static const uint32_t version_minimum;
     static const uint32_t version_maximum;
+
+private:
+    mutable encoding::const_ptr encoding_;
+    mutable upgrade_mutex encoding_mutex_;
 };
 
 } // namespace message
@@ -21,6 +21,7 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
 #include <bitcoin/bitcoin/compat.hpp>
@@ -57,6 +58,9 @@ typedef tcp::resolver resolver;
 typedef tcp::resolver::query query;
 typedef tcp::resolver::iterator iterator;
 
+typedef boost::asio::const_buffer const_buffer;
+typedef std::vector<const_buffer> const_buffers;
+
 // Boost thread is used because of thread_specific_ptr limitation:
 // stackoverflow.com/q/22448022/1172329
 typedef boost::thread thread;
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BUFFER_POOL_HPP
+#define LIBBITCOIN_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+/// Thread safe pool of fixed size buffers, for reuse across serializations.
+/// Buffers are moved in and out of the pool, so their memory is not copied.
+class BC_API buffer_pool
+  : noncopyable
+{
+public:
+    static const size_t default_buffer_size;
+    static const size_t default_capacity;
+
+    /// Retain at most capacity released buffers of buffer_size bytes.
+    buffer_pool(size_t buffer_size=default_buffer_size,
+        size_t capacity=default_capacity);
+
+    /// The size of each buffer.
+    size_t buffer_size() const;
+
+    /// The number of buffers held for reuse.
+    size_t available() const;
+
+    /// Obtain a buffer of buffer_size bytes, reused if one is available.
+    /// The contents of a reused buffer are not cleared.
+    data_chunk acquire();
+
+    /// Return a buffer to the pool, discarded if the pool is full.
+    void release(data_chunk&& buffer);
+
+private:
+    const size_t buffer_size_;
+    const size_t capacity_;
+
+    // Protected by mutex.
+    data_stack buffers_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace libbitcoin
+
+#endif
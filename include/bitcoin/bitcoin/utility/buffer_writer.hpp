@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BUFFER_WRITER_HPP
+#define LIBBITCOIN_BUFFER_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/writer.hpp>
+
+namespace libbitcoin {
+
+/// Writer into a chain of fixed size buffers obtained from a buffer pool.
+/// The buffers are exposed as a const buffer sequence for vectored writes,
+/// and are returned to the pool on clear or destruction. The pool must
+/// outlive the writer and the writer must outlive any pending write.
+/// This class is not thread safe.
+class BC_API buffer_writer
+  : public writer, noncopyable
+{
+public:
+    buffer_writer(buffer_pool& pool);
+    ~buffer_writer();
+
+    template <unsigned Size>
+    void write_forward(const byte_array<Size>& value);
+
+    template <unsigned Size>
+    void write_reverse(const byte_array<Size>& value);
+
+    template <typename Integer>
+    void write_big_endian(Integer value);
+
+    template <typename Integer>
+    void write_little_endian(Integer value);
+
+    /// The number of bytes written.
+    size_t size() const;
+
+    /// The written bytes as a sequence of buffers, for vectored writes.
+    asio::const_buffers buffers() const;
+
+    /// The written bytes from offset as a sequence of slices.
+    std::vector<data_slice> slices(size_t offset=0) const;
+
+    /// The written bytes copied into a contiguous chunk.
+    data_chunk to_data() const;
+
+    /// Overwrite previously written (or skipped) bytes from offset.
+    /// The writer is invalidated if this would extend the written size.
+    void write_at(size_t offset, data_slice data);
+
+    /// Return all buffers to the pool and reset the writer.
+    void clear();
+
+    /// Context.
+    operator bool() const;
+    bool operator!() const;
+
+    /// Write hashes.
+    void write_hash(const hash_digest& value);
+    void write_short_hash(const short_hash& value);
+    void write_mini_hash(const mini_hash& value);
+
+    /// Write big endian integers.
+    void write_2_bytes_big_endian(uint16_t value);
+    void write_4_bytes_big_endian(uint32_t value);
+    void write_8_bytes_big_endian(uint64_t value);
+    void write_variable_big_endian(uint64_t value);
+    void write_size_big_endian(size_t value);
+
+    /// Write little endian integers.
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_little_endian(uint64_t value);
+    void write_size_little_endian(size_t value);
+
+    /// Write one byte.
+    void write_byte(uint8_t value);
+
+    /// Write all bytes.
+    void write_bytes(const data_chunk& data);
+
+    /// Write required size buffer.
+    void write_bytes(const uint8_t* data, size_t size);
+
+    /// Write variable length string.
+    void write_string(const std::string& value);
+
+    /// Write required length string, padded with nulls.
+    void write_string(const std::string& value, size_t size);
+
+    /// Advance iterator, writing nulls.
+    void skip(size_t size);
+
+private:
+    uint8_t* next(size_t& size);
+
+    buffer_pool& pool_;
+    data_stack buffers_;
+    size_t position_;
+    size_t size_;
+    bool valid_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/buffer_writer.ipp>
+
+#endif
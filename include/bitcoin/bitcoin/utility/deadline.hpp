@@ -28,6 +28,7 @@
 #include <bitcoin/bitcoin/utility/noncopyable.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/utility/timing_wheel.hpp>
 ////#include <bitcoin/bitcoin/utility/track.hpp>
 
 namespace libbitcoin {
@@ -37,6 +38,9 @@ namespace libbitcoin {
  * This simplifies invocation, eliminates boost-specific error handling and
  * makes timer firing and cancellation conditions safer.
  */
+/// This class is thread safe.
+/// Deadlines are scheduled on the timing wheel of the thread pool, so any
+/// number of deadlines share a single asio timer.
 class BC_API deadline
   : public enable_shared_from_base<deadline>,
     noncopyable
@@ -82,10 +86,11 @@ public:
     void stop();
 
 private:
-    void handle_timer(const boost_code& ec, handler handle) const;
+    void handle_timer(const code& ec, handler handle) const;
 
-    asio::timer timer_;
+    timing_wheel& wheel_;
     asio::duration duration_;
+    timing_wheel::entry_ptr timer_;
     mutable shared_mutex mutex_;
 };
 
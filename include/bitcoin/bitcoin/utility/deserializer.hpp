@@ -83,7 +83,7 @@ public:
     /// Read all remaining bytes (always safe).
     data_chunk read_bytes();
 
-    /// Read required size buffer.
+    /// Read required size buffer (empty if the read is invalid).
     data_chunk read_bytes(size_t size);
 
     /// Read variable length string.
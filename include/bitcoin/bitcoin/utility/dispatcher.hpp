@@ -111,14 +111,11 @@ public:
 
     /// Posts job to service after specified delay. Concurrent and not ordered.
     /// The timer cannot be canceled so delay should be within stop criteria.
+    /// The job is scheduled directly on the pool's timing wheel, no deadline
+    /// or asio timer is allocated.
     inline void delayed(const asio::duration& delay, delay_handler handler)
     {
-        auto timer = std::make_shared<deadline>(pool_, delay);
-        timer->start([handler, timer](const code& ec)
-        {
-            handler(ec);
-            timer->stop();
-        });
+        pool_.timers().start(std::move(handler), delay);
     }
 
     /// Returns a delegate that will execute the job on the current thread.
@@ -252,6 +249,12 @@ public:
         return pool_.size();
     }
 
+    /// The numa node on which the dispatcher's work runs, or any_node.
+    inline size_t node() const
+    {
+        return pool_.node();
+    }
+
 private:
 
     // This is thread safe.
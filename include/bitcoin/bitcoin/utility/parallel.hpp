@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_HPP
+#define LIBBITCOIN_PARALLEL_HPP
+
+#include <cstddef>
+
+namespace libbitcoin {
+
+/// Invoke handler(first, last) over contiguous ranges partitioning [0, count)
+/// on up to threads threads (zero for the hardware concurrency), including
+/// the calling thread. Each range but the last is at least grain, and the
+/// last may be smaller. Blocks until all ranges are complete, then rethrows
+/// the first exception thrown by the handler, if any. Threads are created
+/// for each call, so grain should make each range outweigh the creation of
+/// a thread, and a count below twice grain runs on the caller.
+template <typename Handler>
+void parallel_for(size_t count, size_t grain, Handler&& handler,
+    size_t threads=0);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/parallel.ipp>
+
+#endif
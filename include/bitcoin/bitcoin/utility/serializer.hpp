@@ -31,14 +31,15 @@
 namespace libbitcoin {
 
 /// Writer to wrap arbitrary iterator.
-template <typename Iterator>
+template <typename Iterator, bool CheckSafe=false>
 class serializer
   : public writer/*, noncopyable*/
 {
 public:
-    typedef std::function<void(serializer<Iterator>&)> functor;
+    typedef std::function<void(serializer<Iterator, CheckSafe>&)> functor;
 
     serializer(const Iterator begin);
+    serializer(const Iterator begin, const Iterator end);
 
     template <typename Buffer>
     void write_forward(const Buffer& data);
@@ -106,16 +107,34 @@ public:
     /// Utility for variable skipping of writer.
     size_t read_size_little_endian();
 
+    /// The position of the next write.
+    Iterator position() const;
+
 private:
+    // True if valid and, if a safe serializer, size fits the remaining bytes.
+    bool safe(size_t size);
+
+    // The number of bytes remaining in the buffer.
+    size_t remaining() const;
+
     bool valid_;
     Iterator iterator_;
+    const Iterator end_;
 };
 
 // Factories.
 //-----------------------------------------------------------------------------
 
+/// Slower serializer (with bounds checking).
+/// Writes that exceed the end are dropped and invalidate the serializer.
+template <typename Iterator>
+serializer<Iterator, true> make_safe_serializer(Iterator begin,
+    Iterator end);
+
+/// Faster serializer (without bounds checking).
+/// Intended for use with buffers presized to the exact write only.
 template <typename Iterator>
-serializer<Iterator> make_unsafe_serializer(Iterator begin);
+serializer<Iterator, false> make_unsafe_serializer(Iterator begin);
 
 } // namespace libbitcoin
 
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include <boost/thread.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 
@@ -57,7 +58,14 @@ typedef boost::shared_lock<shared_mutex> shared_lock;
 typedef std::shared_ptr<boost::shared_mutex> shared_mutex_ptr;
 typedef std::shared_ptr<boost::upgrade_mutex> upgrade_mutex_ptr;
 
+/// Sentinel for a thread or pool that is not bound to a single numa node.
+BC_CONSTEXPR size_t any_node = static_cast<size_t>(-1);
+
 BC_API void set_priority(thread_priority priority);
+BC_API bool set_affinity(const std::vector<size_t>& cores);
+BC_API size_t numa_nodes();
+BC_API std::vector<size_t> node_cores(size_t node);
+BC_API size_t current_node();
 BC_API thread_priority priority(bool priority);
 BC_API size_t thread_default(size_t configured);
 BC_API size_t thread_ceiling(size_t configured);
@@ -24,10 +24,12 @@
 #include <memory>
 #include <functional>
 #include <thread>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/noncopyable.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/timing_wheel.hpp>
 
 namespace libbitcoin {
 
@@ -44,9 +46,11 @@ public:
      * Threadpool constructor, spawns the specified number of threads.
      * @param[in]   number_threads  Number of threads to spawn.
      * @param[in]   priority        Priority of threads to spawn.
+     * @param[in]   resolution      Tick period of the pool's timing wheel.
      */
      threadpool(size_t number_threads=0,
-        thread_priority priority=thread_priority::normal);
+        thread_priority priority=thread_priority::normal,
+        const asio::duration& resolution=timing_wheel::default_resolution);
 
     virtual ~threadpool();
 
@@ -68,6 +72,29 @@ public:
     void spawn(size_t number_threads=1,
         thread_priority priority=thread_priority::normal);
 
+    /**
+     * Add the specified number of threads bound to the cores of a numa node.
+     * Memory first touched by a job of this pool is allocated node-local by
+     * the default operating system policy, so buffers used by node-bound
+     * work should be allocated from within that work.
+     * @param[in]   number_threads  Number of threads to add.
+     * @param[in]   node            The numa node to which threads are bound.
+     * @param[in]   pin_cores       Pin each thread to a single core of the
+     *                              node (round robin), otherwise any core of
+     *                              the node may be used by each thread.
+     * @param[in]   priority        Priority of threads to add.
+     * @return  False if any thread could not be bound to the node (such as
+     *          an unknown node), in which case the pool is not bound.
+     */
+    bool spawn_on_node(size_t number_threads, size_t node,
+        bool pin_cores=false,
+        thread_priority priority=thread_priority::normal);
+
+    /**
+     * The numa node to which all threads of the pool are bound, or any_node.
+     */
+    size_t node() const;
+
     /**
      * Abandon outstanding operations without dispatching handlers.
      * WARNING: This call is unsave and should be avoided.
@@ -96,15 +123,23 @@ public:
      */
     const asio::service& service() const;
 
+    /**
+     * Timing wheel shared by all deadlines and delayed jobs of this pool.
+     */
+    timing_wheel& timers();
+
 private:
-    void spawn_once(thread_priority priority=thread_priority::normal);
+    bool spawn_once(thread_priority priority=thread_priority::normal,
+        const std::vector<size_t>& cores={});
 
     // This is thread safe.
     asio::service service_;
+    timing_wheel timers_;
 
     // These are protected by mutex.
 
     std::atomic<size_t> size_;
+    std::atomic<size_t> node_;
     std::vector<asio::thread> threads_;
     mutable upgrade_mutex threads_mutex_;
 
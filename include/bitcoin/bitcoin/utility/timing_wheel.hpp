@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_TIMING_WHEEL_HPP
+#define LIBBITCOIN_TIMING_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+/// This class is thread safe.
+/// Hashed timing wheel, multiplexes any number of timers onto one asio timer.
+/// Start and cancel are O(1), each tick visits only the entries of one slot.
+/// Expiration is never early and is late by at most two resolution periods.
+class BC_API timing_wheel
+  : noncopyable
+{
+public:
+    typedef std::function<void(const code&)> handler;
+
+    /// Opaque scheduled timer, retained by the caller to allow cancelation.
+    struct entry;
+    typedef std::shared_ptr<entry> entry_ptr;
+
+    /// Ten milliseconds, well below any network protocol timeout.
+    static const asio::duration default_resolution;
+
+    /// Slot count, one rotation at default resolution is about five seconds.
+    static const size_t default_slots;
+
+    /**
+     * Construct a timing wheel.
+     * @param[in]  service     The service on which handlers are posted.
+     * @param[in]  resolution  The tick period, the granularity of expiration.
+     * @param[in]  slots       The number of slots in one wheel rotation.
+     */
+    timing_wheel(asio::service& service,
+        const asio::duration& resolution=default_resolution,
+        size_t slots=default_slots);
+
+    /// The pending tick refers to the wheel, so the service must be stopped
+    /// and its threads joined before the wheel is destroyed.
+    ~timing_wheel();
+
+    /// The tick period of the wheel.
+    asio::duration resolution() const;
+
+    /// The number of timers that are scheduled and not yet expired.
+    size_t size() const;
+
+    /**
+     * Schedule a handler for expiration after the specified duration.
+     * The handler will not be invoked within the scope of this call.
+     * Upon expiration the handler is posted to the service with success.
+     * @param[in]  handle    Callback invoked upon expiration.
+     * @param[in]  duration  The time period from start to expiration.
+     * @return               The entry to be used for cancelation.
+     */
+    entry_ptr start(handler handle, const asio::duration& duration);
+
+    /**
+     * Cancel a scheduled timer, the handler will not be invoked.
+     * @param[in]  timer  The entry returned from start, may be empty.
+     * @return            True if the timer was pending and is now canceled.
+     */
+    bool stop(const entry_ptr& timer);
+
+private:
+    typedef std::vector<entry_ptr> entries;
+
+    uint64_t elapsed(const asio::time_point& now) const;
+    void link(entry_ptr timer, uint64_t expiry);
+    void unlink(entry& timer);
+    void advance(uint64_t target, entries& expired);
+    void arm();
+    void handle_tick(const boost_code& ec);
+
+    // These are thread safe.
+    asio::service& service_;
+    const asio::duration resolution_;
+    const asio::time_point epoch_;
+
+    // These are protected by mutex.
+    asio::timer timer_;
+    std::vector<entry*> slots_;
+    uint64_t tick_;
+    size_t pending_;
+    bool ticking_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
@@ -43,6 +44,12 @@ public:
     static const uint8_t uncompressed;
     static const uint8_t mainnet_p2kh;
 
+    typedef std::vector<ec_public> list;
+
+    /// Bulk constructor, the public keys of a set of secrets in parallel.
+    /// The public key of an invalid secret is invalid.
+    static list from_secrets(const secret_list& secrets, bool compress=true);
+
     /// Constructors.
     ec_public();
     ec_public(const ec_public& other);
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_ENCRYPTED_KEYS_HPP
 
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
@@ -53,6 +54,7 @@ typedef byte_array<ek_entropy_size> ek_entropy;
  */
 static BC_CONSTEXPR size_t ek_seed_size = 24;
 typedef byte_array<ek_seed_size> ek_seed;
+typedef std::vector<ek_seed> ek_seed_list;
 
 /**
  * An intermediate passphrase (token) type (checked but not base58 encoded).
@@ -67,6 +69,7 @@ typedef byte_array<encrypted_token_decoded_size> encrypted_token;
 static BC_CONSTEXPR size_t ek_private_encoded_size = 58;
 static BC_CONSTEXPR size_t ek_private_decoded_size = 43;
 typedef byte_array<ek_private_decoded_size> encrypted_private;
+typedef std::vector<encrypted_private> encrypted_private_list;
 
 /**
  * DEPRECATED
@@ -131,6 +134,21 @@ BC_API bool create_key_pair(encrypted_private& out_private,
     ec_compressed& out_point, const encrypted_token& token,
     const ek_seed& seed, uint8_t version, bool compressed=true);
 
+/**
+ * Create an encrypted private key from an intermediate passphrase for each
+ * of a set of seeds. The key pairs are created in parallel.
+ * @param[out] out_privates  The new encrypted private keys, in seed order.
+ * @param[out] out_points    The ec compressed public keys of the key pairs.
+ * @param[in]  token         An intermediate passphrase string.
+ * @param[in]  seeds         Random values for use in the encryption.
+ * @param[in]  version       The coin address version byte.
+ * @param[in]  compressed    Set true to associate ec public key compression.
+ * @return false if the token checksum is not valid or any pair fails.
+ */
+BC_API bool create_key_pairs(encrypted_private_list& out_privates,
+    point_list& out_points, const encrypted_token& token,
+    const ek_seed_list& seeds, uint8_t version, bool compressed=true);
+
 /**
  * DEPRECATED
  * Create an encrypted key pair from an intermediate passphrase.
@@ -164,6 +182,19 @@ BC_API bool create_key_pair(encrypted_private& out_private,
 BC_API bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     const std::string& passphrase, uint8_t version, bool compressed=true);
 
+/**
+ * Encrypt each of a set of ec secrets using the passphrase, in parallel.
+ * @param[out] out_privates  The new encrypted private keys, in secret order.
+ * @param[in]  secrets       The ec secrets to encrypt.
+ * @param[in]  passphrase    A passphrase for use in the encryption.
+ * @param[in]  version       The coin address version byte.
+ * @param[in]  compressed    Set true to associate ec public key compression.
+ * @return false if any secret could not be converted to a public key.
+ */
+BC_API bool encrypt(encrypted_private_list& out_privates,
+    const secret_list& secrets, const std::string& passphrase,
+    uint8_t version, bool compressed=true);
+
 /**
  * Decrypt the ec secret associated with the encrypted private key.
  * @param[out] out_secret      The decrypted ec secret.
@@ -177,6 +208,17 @@ BC_API bool decrypt(ec_secret& out_secret, uint8_t& out_version,
     bool& out_compressed, const encrypted_private& key,
     const std::string& passphrase);
 
+/**
+ * Decrypt the ec secrets of a set of encrypted private keys, in parallel.
+ * Keys from one intermediate passphrase share a single passphrase scrypt.
+ * @param[out] out_secrets  The decrypted ec secrets, in key order.
+ * @param[in]  keys         The encrypted private keys.
+ * @param[in]  passphrase   The passphrase from the encryption or token.
+ * @return false if any key checksum or the passphrase is not valid.
+ */
+BC_API bool decrypt(secret_list& out_secrets,
+    const encrypted_private_list& keys, const std::string& passphrase);
+
 /**
  * DEPRECATED
  * Decrypt the ec point associated with the encrypted public key.
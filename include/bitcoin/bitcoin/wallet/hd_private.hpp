@@ -40,6 +40,8 @@ public:
     static const uint64_t mainnet;
     static const uint64_t testnet;
 
+    typedef std::vector<hd_private> list;
+
     static uint32_t to_prefix(uint64_t prefixes)
     {
         return prefixes >> 32;
@@ -89,6 +91,15 @@ public:
     hd_private derive_private(uint32_t index) const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count).
+    /// Returns an empty list if the range is not derivable from this key. An
+    /// element is invalid if derivation fails at its index (see BIP32).
+    list derive_private_range(uint32_t first, size_t count) const;
+
+    /// Derive the public keys of the (non-hardened) children
+    /// [first, first + count) without deriving the private keys.
+    hd_public::list derive_public_range(uint32_t first, size_t count) const;
+
 private:
     /// Factories.
     static hd_private from_seed(data_slice seed, uint64_t prefixes);
@@ -20,8 +20,10 @@
 #define LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -62,6 +64,8 @@ public:
     static const uint32_t mainnet;
     static const uint32_t testnet;
 
+    typedef std::vector<hd_public> list;
+
     static uint32_t to_prefix(uint64_t prefixes)
     {
         return prefixes & 0x00000000FFFFFFFF;
@@ -100,13 +104,28 @@ public:
     hd_key to_hd_key() const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the (non-hardened) children [first, first + count).
+    /// Returns an empty list if the range is not derivable from this key. An
+    /// element is invalid if derivation fails at its index (see BIP32).
+    list derive_public_range(uint32_t first, size_t count) const;
+
 protected:
     /// Factories.
     static hd_public from_secret(const ec_secret& secret,
         const hd_chain_code& chain_code, const hd_lineage& lineage);
 
+    /// The hmac message of the child at index.
+    typedef std::function<data_chunk(uint32_t index)> child_message;
+
+    /// Create the child at offset in the range from its hmac and lineage.
+    typedef std::function<void(size_t offset, const long_hash& hmac,
+        const hd_lineage& lineage)> child_creator;
+
     /// Helpers.
     uint32_t fingerprint() const;
+    bool is_derivable(uint32_t first, size_t count) const;
+    void derive_range(uint32_t first, size_t count,
+        const child_message& message, const child_creator& create) const;
 
     /// Members.
     /// These should be const, apart from the need to implement assignment.
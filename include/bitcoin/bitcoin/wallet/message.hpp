@@ -19,7 +19,9 @@
 #ifndef LIBBITCOIN_WALLET_MESSAGE_HPP
 #define LIBBITCOIN_WALLET_MESSAGE_HPP
 
+#include <cstddef>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
@@ -35,6 +37,18 @@ namespace wallet {
 static BC_CONSTEXPR size_t message_signature_size = 1 + ec_signature_size;
 typedef byte_array<message_signature_size> message_signature;
 
+/**
+ * A message with its signature and the address of the signer.
+ */
+struct BC_API signed_message
+{
+    typedef std::vector<signed_message> list;
+
+    data_chunk message;
+    payment_address address;
+    message_signature signature;
+};
+
 /**
  * Hashes a messages in preparation for signing.
  */
@@ -80,6 +94,14 @@ BC_API bool sign_message(message_signature& out_signature, data_slice message,
 BC_API bool verify_message(data_slice message, const payment_address& address,
     const message_signature& signature);
 
+/**
+ * Verifies each of a set of messages, on up to threads threads (zero for
+ * the hardware concurrency).
+ * @return the result of verify_message for each message, in message order.
+ */
+BC_API std::vector<bool> verify_messages(
+    const signed_message::list& messages, size_t threads=0);
+
 /// Exposed primarily for independent testability.
 BC_API bool recovery_id_to_magic(uint8_t& out_magic, uint8_t recovery_id,
     bool compressed);
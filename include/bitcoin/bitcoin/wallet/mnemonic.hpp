@@ -70,11 +70,27 @@ BC_API bool validate_mnemonic(const word_list& mnemonic,
 BC_API bool validate_mnemonic(const word_list& mnemonic,
     const dictionary_list& lexicons=language::all);
 
+/**
+ * Find the first of the provided languages in which the mnemonic is valid.
+ * Built-in dictionaries are searched by a shared sorted index, so the words
+ * are looked up once for all languages.
+ * @return the matching dictionary, or nullptr if none.
+ */
+BC_API const dictionary* find_lexicon(const word_list& mnemonic,
+    const dictionary_list& lexicons=language::all);
+
 /**
  * Convert a mnemonic with no passphrase to a wallet-generation seed.
  */
 BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 
+/**
+ * Convert each of a set of mnemonics with no passphrase to a seed.
+ * The seeds are derived in parallel, in the order of the mnemonics.
+ */
+BC_API long_hash_list decode_mnemonics(
+    const std::vector<word_list>& mnemonics);
+
 #ifdef WITH_ICU
 
 /**
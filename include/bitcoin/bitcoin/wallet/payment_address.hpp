@@ -54,6 +54,11 @@ public:
     typedef std::vector<payment_address> list;
     typedef std::shared_ptr<payment_address> ptr;
 
+    /// Bulk constructor, the addresses of a set of public keys in parallel.
+    /// The address of an invalid public key is invalid.
+    static list from_points(const ec_public::list& points,
+        uint8_t version=mainnet_p2kh);
+
     /// Extract a payment address list from an input or output script.
     static list extract(const chain::script& script,
         uint8_t p2kh_version=mainnet_p2kh, uint8_t p2sh_version=mainnet_p2sh);
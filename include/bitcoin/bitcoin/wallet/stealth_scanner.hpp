@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_STEALTH_SCANNER_HPP
+#define LIBBITCOIN_WALLET_STEALTH_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/stealth_record.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/// Scans stealth records for payments to any of a set of spend keys that
+/// share a scan key. Records are filtered by prefix before the shared secret
+/// is computed (once per record) and the work is divided among threads.
+/// This class does not support multisignature stealth addresses.
+class BC_API stealth_scanner
+{
+public:
+    /// A record that pays to one of the spend keys.
+    struct match
+    {
+        chain::stealth_record record;
+
+        /// The index of the spend key to which the payment is made.
+        size_t spend_index;
+
+        /// The payment address of the record.
+        wallet::payment_address address;
+
+        /// The spend private key plus this secret is the payment private key.
+        ec_secret shared;
+    };
+
+    typedef std::vector<match> matches;
+
+    /// Constructors.
+    /// The filter may not exceed the stealth prefix (32 bits).
+    stealth_scanner(const ec_secret& scan_private,
+        const point_list& spend_keys, const binary& filter,
+        uint8_t version=payment_address::mainnet_p2kh);
+
+    /// Caller must test after construct.
+    operator const bool() const;
+
+    /// Determine if the prefix of a record matches the filter.
+    bool is_candidate(uint32_t prefix) const;
+
+    /// Get the matches in the order of the records.
+    matches scan(const chain::stealth_record::list& records) const;
+
+    /// Once a match is found, derive its private key from the spend key.
+    static bool derive_private(ec_secret& out_private, const match& match,
+        const ec_secret& spend_private);
+
+private:
+    bool match_record(match& out_match,
+        const chain::stealth_record& record) const;
+
+    const uint8_t version_;
+    const ec_secret scan_private_;
+    const point_list spend_keys_;
+    bool valid_;
+    uint32_t mask_;
+    uint32_t value_;
+};
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_UNSPENT_INDEX_HPP
+#define LIBBITCOIN_WALLET_UNSPENT_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/point_value.hpp>
+#include <bitcoin/bitcoin/chain/points_value.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/wallet/select_outputs.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/// A persistent value-ordered set of unspent outputs, maintained as outputs
+/// are received and spent, for selection from very large wallets. The
+/// select_outputs algorithms locate their first output in logarithmic time
+/// and then visit only the outputs that they return.
+/// This class is not thread safe.
+class BC_API unspent_index
+{
+public:
+    static const asio::duration default_budget;
+
+    unspent_index();
+
+    /// Add an unspent output, false if the point is already indexed.
+    bool insert(const chain::point_value& unspent);
+
+    /// Remove a spent output, false if the point is not indexed.
+    bool remove(const chain::point& spent);
+
+    /// True if the point is indexed.
+    bool contains(const chain::point& point) const;
+
+    /// The number of indexed outputs.
+    size_t size() const;
+
+    /// The total value of the indexed outputs.
+    uint64_t value() const;
+
+    /// Remove all outputs.
+    void clear();
+
+    /// Select outpoints for a spend, as select_outputs::select. The values
+    /// selected are the same, but of outputs with equal value the one with
+    /// the lesser point is taken, where select_outputs takes the first in
+    /// list order, so the points selected may differ.
+    void select(chain::points_value& out, uint64_t minimum_value,
+        select_outputs::algorithm option=
+            select_outputs::algorithm::greedy) const;
+
+    /// Search (branch and bound) for the set of outputs with a value in
+    /// [minimum_value, minimum_value + tolerance] that is closest to the
+    /// minimum, so that no change output is required. Outputs are visited
+    /// in descending order of value and the search ends when an exact match
+    /// is found, the space is exhausted or the budget is spent. Returns false
+    /// (with an empty set) if no match is found within the budget.
+    bool select_exact(chain::points_value& out, uint64_t minimum_value,
+        uint64_t tolerance=0,
+        const asio::duration& budget=default_budget) const;
+
+private:
+    // Order by value, then by point so that equal values may be indexed.
+    struct lesser
+    {
+        bool operator()(const chain::point_value& left,
+            const chain::point_value& right) const;
+    };
+
+    typedef std::set<chain::point_value, lesser> ordered;
+
+    void greedy(chain::points_value& out, uint64_t minimum_value) const;
+    void individual(chain::points_value& out, uint64_t minimum_value) const;
+
+    ordered outputs_;
+    std::unordered_map<chain::point, uint64_t> values_;
+    uint64_t value_;
+};
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
@@ -45,7 +45,7 @@
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -201,8 +201,8 @@ block block::factory(reader& source)
 
 bool block::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source);
 }
 
 bool block::from_data(std::istream& stream)
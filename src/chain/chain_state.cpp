@@ -21,6 +21,9 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/compact.hpp>
@@ -119,14 +122,147 @@ inline bool bip65(size_t height, bool frozen, bool testnet)
         (!testnet && height >= mainnet_bip65_freeze));
 }
 
-inline uint32_t timestamp_high(const chain_state::data& values)
+//*****************************************************************************
+// CONSENSUS: Though unspecified in bip34, the satoshi implementation
+// performed this comparison using the signed integer version value.
+//*****************************************************************************
+inline bool is_at_least(uint32_t value, size_t version)
 {
-    return values.timestamp.ordered.back();
+    return static_cast<int32_t>(value) >= version;
 }
 
-inline uint32_t bits_high(const chain_state::data& values)
+// Version history.
+//-----------------------------------------------------------------------------
+
+// Versions are appended to chunks of this size. A partial chunk is copied on
+// append, and a full chunk references the (shared) chunks below it that may
+// still be within a sample, so states share history and unreachable chunks
+// are released.
+static const size_t version_chunk_size = 32;
+
+struct chain_state::version_chunk
+{
+    typedef std::vector<version_chunk_ptr> list;
+
+    // The height of the first version.
+    size_t first;
+    std::vector<uint32_t> values;
+
+    // Preceding full chunks, contiguous and in height order.
+    std::shared_ptr<const list> older;
+};
+
+// Push the version of the block at values.height into the sample of count.
+void chain_state::push_version(window& values, uint32_t version,
+    size_t count)
+{
+    if (count == 0)
+    {
+        values.version_first = values.height + 1;
+        values.version_count = 0;
+        values.version_bip34 = 0;
+        values.version_bip66 = 0;
+        values.version_bip65 = 0;
+        values.versions.reset();
+        return;
+    }
+
+    const auto height = values.height;
+    const auto first = height + 1 - std::min(count, height + 1);
+    const auto& head = values.versions;
+    const auto contiguous = head &&
+        head->first + head->values.size() == height;
+    auto chunk = std::make_shared<version_chunk>();
+    chunk->values.reserve(version_chunk_size);
+
+    if (contiguous && head->values.size() < version_chunk_size)
+    {
+        // Copy the partial chunk and append.
+        chunk->first = head->first;
+        chunk->values = head->values;
+        chunk->older = head->older;
+    }
+    else
+    {
+        // Start a chunk referencing the full chunks still within the sample.
+        chunk->first = height;
+        auto older = std::make_shared<version_chunk::list>();
+
+        if (contiguous)
+        {
+            // Retain chunks holding versions that have yet to leave.
+            for (const auto& full: *head->older)
+                if (full->first + version_chunk_size > values.version_first)
+                    older->push_back(full);
+
+            older->push_back(head);
+        }
+
+        chunk->older = older;
+    }
+
+    chunk->values.push_back(version);
+
+    if (!contiguous)
+    {
+        values.version_first = height;
+        values.version_count = 0;
+        values.version_bip34 = 0;
+        values.version_bip66 = 0;
+        values.version_bip65 = 0;
+    }
+
+    ++values.version_count;
+    values.version_bip34 += is_at_least(version, bip34_version) ? 1 : 0;
+    values.version_bip66 += is_at_least(version, bip66_version) ? 1 : 0;
+    values.version_bip65 += is_at_least(version, bip65_version) ? 1 : 0;
+
+    // Remove the versions that have left the sample.
+    for (; values.version_first < first; ++values.version_first)
+    {
+        const auto at = values.version_first;
+        const auto& older = *chunk->older;
+        const auto& source = at >= chunk->first ? *chunk :
+            *older[(at - older.front()->first) / version_chunk_size];
+        const auto leaving = source.values[at - source.first];
+
+        --values.version_count;
+        values.version_bip34 -= is_at_least(leaving, bip34_version) ? 1 : 0;
+        values.version_bip66 -= is_at_least(leaving, bip66_version) ? 1 : 0;
+        values.version_bip65 -= is_at_least(leaving, bip65_version) ? 1 : 0;
+    }
+
+    values.versions = chunk;
+}
+
+// Timestamp history.
+//-----------------------------------------------------------------------------
+
+// Push the timestamp into the median time past sample of count (at most the
+// interval), in height order and in value order.
+void chain_state::push_timestamp(window& values, uint32_t timestamp,
+    size_t count)
 {
-    return values.bits.ordered.back();
+    auto& size = values.timestamp_count;
+    const auto timestamps = values.timestamps.begin();
+    const auto sorted = values.sorted.begin();
+
+    for (; size != 0 && size + 1 > count; --size)
+    {
+        const auto leaving = *timestamps;
+        std::copy(timestamps + 1, timestamps + size, timestamps);
+        const auto it = std::lower_bound(sorted, sorted + size, leaving);
+        std::copy(it + 1, sorted + size, it);
+    }
+
+    if (size < count)
+    {
+        timestamps[size] = timestamp;
+        const auto it = std::upper_bound(sorted, sorted + size, timestamp);
+        std::copy_backward(it, sorted + size, sorted + size + 1);
+        *it = timestamp;
+        ++size;
+    }
 }
 
 // activation
@@ -134,31 +270,22 @@ inline uint32_t bits_high(const chain_state::data& values)
 
 chain_state::activations chain_state::activation(const data& values,
     uint32_t forks)
+{
+    return activation(to_window(values), forks);
+}
+
+chain_state::activations chain_state::activation(const window& values,
+    uint32_t forks)
 {
     const auto height = values.height;
-    const auto version = values.version.self;
-    const auto& history = values.version.ordered;
+    const auto version = values.version_self;
     const auto frozen = script::is_enabled(forks, rule_fork::bip90_rule);
     const auto testnet = script::is_enabled(forks, rule_fork::easy_blocks);
 
-    //*************************************************************************
-    // CONSENSUS: Though unspecified in bip34, the satoshi implementation
-    // performed this comparison using the signed integer version value.
-    //*************************************************************************
-    const auto ge = [](uint32_t value, size_t version)
-    {
-        return static_cast<int32_t>(value) >= version;
-    };
-
-    // Declare bip34-based version predicates.
-    const auto ge_2 = [=](uint32_t value) { return ge(value, bip34_version); };
-    const auto ge_3 = [=](uint32_t value) { return ge(value, bip66_version); };
-    const auto ge_4 = [=](uint32_t value) { return ge(value, bip65_version); };
-
-    // Compute bip34-based activation version summaries.
-    const auto count_2 = std::count_if(history.begin(), history.end(), ge_2);
-    const auto count_3 = std::count_if(history.begin(), history.end(), ge_3);
-    const auto count_4 = std::count_if(history.begin(), history.end(), ge_4);
+    // The bip34-based activation version summaries are maintained on push.
+    const auto count_2 = values.version_bip34;
+    const auto count_3 = values.version_bip66;
+    const auto count_4 = values.version_bip65;
 
     // Frozen activations (require version and enforce above freeze height).
     const auto bip34_ice = bip34(height, frozen, testnet);
@@ -176,7 +303,7 @@ chain_state::activations chain_state::activation(const data& values,
 
     // bip16 is activated with a one-time test on mainnet/testnet (~55% rule).
     // There was one invalid p2sh tx mined after that time (code shipped late).
-    if (values.timestamp.self >= bip16_activation_time &&
+    if (values.timestamp_self >= bip16_activation_time &&
         !is_bip16_exception({ values.hash, height }, testnet))
     {
         result.forks |= (rule_fork::bip16_rule & forks);
@@ -304,21 +431,27 @@ size_t chain_state::bip9_bit0_height(size_t height, uint32_t forks)
 
 uint32_t chain_state::median_time_past(const data& values, uint32_t)
 {
-    // Create a copy for the in-place sort.
-    auto times = values.timestamp.ordered;
-
-    // Sort the times by value to obtain the median.
-    std::sort(times.begin(), times.end());
+    return median_time_past(to_window(values));
+}
 
+uint32_t chain_state::median_time_past(const window& values)
+{
+    // The sample is maintained in value order on push.
     // Consensus defines median time using modulo 2 element selection.
     // This differs from arithmetic median which averages two middle values.
-    return times.empty() ? 0 : times[times.size() / 2];
+    const auto size = values.timestamp_count;
+    return size == 0 ? 0 : values.sorted[size / 2];
 }
 
 // work_required
 //-----------------------------------------------------------------------------
 
 uint32_t chain_state::work_required(const data& values, uint32_t forks)
+{
+    return work_required(to_window(values), forks);
+}
+
+uint32_t chain_state::work_required(const window& values, uint32_t forks)
 {
     // Invalid parameter via public interface, test is_valid for results.
     if (values.height == 0)
@@ -330,14 +463,14 @@ uint32_t chain_state::work_required(const data& values, uint32_t forks)
     if (script::is_enabled(forks, rule_fork::easy_blocks))
         return easy_work_required(values);
 
-    return bits_high(values);
+    return values.bits_high;
 }
 
-uint32_t chain_state::work_required_retarget(const data& values)
+uint32_t chain_state::work_required_retarget(const window& values)
 {
     static const uint256_t pow_limit(compact{ proof_of_work_limit });
 
-    const compact bits(bits_high(values));
+    const compact bits(values.bits_high);
     BITCOIN_ASSERT_MSG(!bits.is_overflowed(), "previous block has bad bits");
 
     uint256_t target(bits);
@@ -349,10 +482,10 @@ uint32_t chain_state::work_required_retarget(const data& values)
 }
 
 // Get the bounded total time spanning the highest 2016 blocks.
-uint32_t chain_state::retarget_timespan(const data& values)
+uint32_t chain_state::retarget_timespan(const window& values)
 {
-    const auto high = timestamp_high(values);
-    const auto retarget = values.timestamp.retarget;
+    const auto high = values.timestamps[values.timestamp_count - 1];
+    const auto retarget = values.timestamp_retarget;
 
     //*************************************************************************
     // CONSENSUS: subtract unsigned 32 bit numbers in signed 64 bit space in
@@ -362,31 +495,21 @@ uint32_t chain_state::retarget_timespan(const data& values)
     return range_constrain(timespan, min_timespan, max_timespan);
 }
 
-uint32_t chain_state::easy_work_required(const data& values)
+uint32_t chain_state::easy_work_required(const window& values)
 {
     BITCOIN_ASSERT(values.height != 0);
 
     // If the time limit has passed allow a minimum difficulty block.
-    if (values.timestamp.self > easy_time_limit(values))
+    if (values.timestamp_self > easy_time_limit(values))
         return proof_of_work_limit;
 
-    auto height = values.height;
-    auto& bits = values.bits.ordered;
-
-    // Reverse iterate the ordered-by-height list of header bits.
-    for (auto bit = bits.rbegin(); bit != bits.rend(); ++bit)
-        if (is_retarget_or_non_limit(--height, *bit))
-            return *bit;
-
-    // Since the set of heights is either a full retarget range or ends at
-    // zero this is not reachable unless the data set is invalid.
-    BITCOIN_ASSERT(false);
-    return proof_of_work_limit;
+    // The most recent retarget or non-limit bits are maintained on push.
+    return values.bits_easy;
 }
 
-uint32_t chain_state::easy_time_limit(const chain_state::data& values)
+uint32_t chain_state::easy_time_limit(const window& values)
 {
-    const int64_t high = timestamp_high(values);
+    const int64_t high = values.timestamps[values.timestamp_count - 1];
     const int64_t spacing = easy_spacing_seconds;
 
     //*************************************************************************
@@ -476,137 +599,184 @@ uint32_t chain_state::signal_version(uint32_t forks)
     return first_version;
 }
 
+// This is conversion from a raw data set, which may be of any height.
+chain_state::window chain_state::to_window(const data& values)
+{
+    window result{};
+    result.height = values.height;
+    result.hash = values.hash;
+    result.allow_collisions_hash = values.allow_collisions_hash;
+    result.bip9_bit0_hash = values.bip9_bit0_hash;
+
+    // Reverse iterate the ordered-by-height list of header bits to find the
+    // most recent retarget or non-limit bits. Since the set of heights is
+    // either a full retarget range or ends at zero, this is found unless the
+    // data set is invalid.
+    const auto& bits = values.bits.ordered;
+    result.bits_self = values.bits.self;
+    result.bits_high = bits.empty() ? proof_of_work_limit : bits.back();
+    result.bits_easy = proof_of_work_limit;
+    auto height = values.height;
+
+    for (auto bit = bits.rbegin(); bit != bits.rend() && height != 0; ++bit)
+    {
+        if (is_retarget_or_non_limit(--height, *bit))
+        {
+            result.bits_easy = *bit;
+            break;
+        }
+    }
+
+    // Push the versions in height order, ending at height - 1.
+    const auto& versions = values.version.ordered;
+    const auto count = std::min(versions.size(), values.height);
+    result.version_self = values.version.self;
+    result.version_first = values.height;
+
+    for (auto it = versions.end() - count; it != versions.end(); ++it)
+    {
+        result.height = values.height - std::distance(it, versions.end());
+        push_version(result, *it, count);
+    }
+
+    // Push the timestamps in height order.
+    const auto& timestamps = values.timestamp.ordered;
+    const auto sample = std::min(timestamps.size(), median_time_past_interval);
+    result.timestamp_self = values.timestamp.self;
+    result.timestamp_retarget = values.timestamp.retarget;
+
+    for (auto it = timestamps.end() - sample; it != timestamps.end(); ++it)
+        push_timestamp(result, *it, sample);
+
+    result.height = values.height;
+    return result;
+}
+
 // This is promotion from a preceding height to the next.
-chain_state::data chain_state::to_pool(const chain_state& top)
+chain_state::window chain_state::to_pool(const chain_state& top)
 {
-    // Copy data from presumed previous-height block state.
-    auto data = top.data_;
+    // Copy the window of the presumed previous-height block state, sharing
+    // its version history.
+    auto values = top.window_;
 
     // Alias configured forks, these don't change.
     const auto forks = top.forks_;
 
-    // Ppromotion is always valid because we thrown on chain overflow.
-    const auto height = safe_add(data.height, size_t(1));
-
-    // Enqueue previous block values to collections.
-    data.bits.ordered.push_back(data.bits.self);
-    data.version.ordered.push_back(data.version.self);
-    data.timestamp.ordered.push_back(data.timestamp.self);
+    // Promotion is always valid because we throw on chain overflow.
+    const auto height = safe_add(values.height, size_t(1));
 
-    // If bits collection overflows, dequeue oldest member.
-    if (data.bits.ordered.size() > bits_count(height, forks))
-        data.bits.ordered.pop_front();
+    // Push previous block values into the samples, dropping any that leave.
+    values.bits_high = values.bits_self;
 
-    // If version collection overflows, dequeue oldest member.
-    if (data.version.ordered.size() > version_count(height, forks))
-        data.version.ordered.pop_front();
+    if (is_retarget_or_non_limit(values.height, values.bits_self))
+        values.bits_easy = values.bits_self;
 
-    // If timestamp collection overflows, dequeue oldest member.
-    if (data.timestamp.ordered.size() > timestamp_count(height, forks))
-        data.timestamp.ordered.pop_front();
+    push_version(values, values.version_self, version_count(height, forks));
+    push_timestamp(values, values.timestamp_self,
+        timestamp_count(height, forks));
 
     // If promoting from retarget height, move that timestamp into retarget.
     if (is_retarget_height(height - 1u))
-        data.timestamp.retarget = data.timestamp.self;
+        values.timestamp_retarget = values.timestamp_self;
 
     // Replace previous block state with tx pool chain state for next height.
     // Only height and version used by tx pool, others promotable or unused.
-    // Preserve data.allow_collisions_hash promotion.
-    // Preserve data.bip9_bit0_hash promotion.
-    data.height = height;
-    data.hash = null_hash;
-    data.bits.self = proof_of_work_limit;
-    data.version.self = signal_version(forks);
-    data.timestamp.self = max_uint32;
-    return data;
+    // Preserve values.allow_collisions_hash promotion.
+    // Preserve values.bip9_bit0_hash promotion.
+    values.height = height;
+    values.hash = null_hash;
+    values.bits_self = proof_of_work_limit;
+    values.version_self = signal_version(forks);
+    values.timestamp_self = max_uint32;
+    return values;
 }
 
 // Constructor (top to pool).
 // This generates a state for the pool above the presumed top block state.
 chain_state::chain_state(const chain_state& top)
-  : data_(to_pool(top)),
+  : window_(to_pool(top)),
     forks_(top.forks_),
     checkpoints_(top.checkpoints_),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    active_(activation(window_, forks_)),
+    work_required_(work_required(window_, forks_)),
+    median_time_past_(median_time_past(window_))
 {
 }
 
-chain_state::data chain_state::to_block(const chain_state& pool,
+chain_state::window chain_state::to_block(const chain_state& pool,
     const block& block)
 {
     auto testnet = script::is_enabled(pool.forks_, rule_fork::easy_blocks);
 
-    // Copy data from presumed same-height pool state.
-    auto data = pool.data_;
+    // Copy the window of the presumed same-height pool state.
+    auto values = pool.window_;
 
     // Replace pool chain state with block state at same (next) height.
-    // Preserve data.timestamp.retarget promotion.
+    // Preserve values.timestamp_retarget promotion.
     const auto& header = block.header();
-    data.hash = header.hash();
-    data.bits.self = header.bits();
-    data.version.self = header.version();
-    data.timestamp.self = header.timestamp();
+    values.hash = header.hash();
+    values.bits_self = header.bits();
+    values.version_self = header.version();
+    values.timestamp_self = header.timestamp();
 
     // Cache hash of bip34 height block, otherwise use preceding state.
-    if (allow_collisions(data.height, testnet))
-        data.allow_collisions_hash = data.hash;
+    if (allow_collisions(values.height, testnet))
+        values.allow_collisions_hash = values.hash;
 
     // Cache hash of bip9 bit0 height block, otherwise use preceding state.
-    if (bip9_bit0_active(data.height, testnet))
-        data.bip9_bit0_hash = data.hash;
+    if (bip9_bit0_active(values.height, testnet))
+        values.bip9_bit0_hash = values.hash;
 
-    return data;
+    return values;
 }
 
 // Constructor (tx pool to block).
 // This assumes that the pool state is the same height as the block.
 chain_state::chain_state(const chain_state& pool, const block& block)
-  : data_(to_block(pool, block)),
+  : window_(to_block(pool, block)),
     forks_(pool.forks_),
     checkpoints_(pool.checkpoints_),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    active_(activation(window_, forks_)),
+    work_required_(work_required(window_, forks_)),
+    median_time_past_(median_time_past(window_))
 {
 }
 
-chain_state::data chain_state::to_header(const chain_state& parent,
+chain_state::window chain_state::to_header(const chain_state& parent,
     const header& header)
 {
     auto testnet = script::is_enabled(parent.forks_, rule_fork::easy_blocks);
 
-    // Copy and promote data from presumed parent-height header/block state.
-    auto data = to_pool(parent);
+    // Promote the window of the presumed parent-height header/block state.
+    auto values = to_pool(parent);
 
     // Replace the pool (empty) current block state with given header state.
-    // Preserve data.timestamp.retarget promotion.
-    data.hash = header.hash();
-    data.bits.self = header.bits();
-    data.version.self = header.version();
-    data.timestamp.self = header.timestamp();
+    // Preserve values.timestamp_retarget promotion.
+    values.hash = header.hash();
+    values.bits_self = header.bits();
+    values.version_self = header.version();
+    values.timestamp_self = header.timestamp();
 
     // Cache hash of bip34 height block, otherwise use preceding state.
-    if (allow_collisions(data.height, testnet))
-        data.allow_collisions_hash = data.hash;
+    if (allow_collisions(values.height, testnet))
+        values.allow_collisions_hash = values.hash;
 
     // Cache hash of bip9 bit0 height block, otherwise use preceding state.
-    if (bip9_bit0_active(data.height, testnet))
-        data.bip9_bit0_hash = data.hash;
+    if (bip9_bit0_active(values.height, testnet))
+        values.bip9_bit0_hash = values.hash;
 
-    return data;
+    return values;
 }
 
 // Constructor (parent to header).
 // This assumes that parent is the state of the header's previous block.
 chain_state::chain_state(const chain_state& parent, const header& header)
-  : data_(to_header(parent, header)),
+  : window_(to_header(parent, header)),
     forks_(parent.forks_),
     checkpoints_(parent.checkpoints_),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    active_(activation(window_, forks_)),
+    work_required_(work_required(window_, forks_)),
+    median_time_past_(median_time_past(window_))
 {
 }
 
@@ -614,12 +784,12 @@ chain_state::chain_state(const chain_state& parent, const header& header)
 // The allow_collisions hard fork is always activated (not configurable).
 chain_state::chain_state(data&& values, const checkpoints& checkpoints,
     uint32_t forks)
-  : data_(std::move(values)),
+  : window_(to_window(values)),
     forks_(forks | rule_fork::allow_collisions),
     checkpoints_(checkpoints),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    active_(activation(window_, forks_)),
+    work_required_(work_required(window_, forks_)),
+    median_time_past_(median_time_past(window_))
 {
 }
 
@@ -628,7 +798,7 @@ chain_state::chain_state(data&& values, const checkpoints& checkpoints,
 // These are the conditions that would cause exception during execution.
 bool chain_state::is_valid() const
 {
-    return data_.height != 0;
+    return window_.height != 0;
 }
 
 // Properties.
@@ -636,7 +806,7 @@ bool chain_state::is_valid() const
 
 size_t chain_state::height() const
 {
-    return data_.height;
+    return window_.height;
 }
 
 uint32_t chain_state::enabled_forks() const
@@ -674,13 +844,13 @@ bool chain_state::is_enabled(rule_fork fork) const
 
 bool chain_state::is_checkpoint_conflict(const hash_digest& hash) const
 {
-    return !checkpoint::validate(hash, data_.height, checkpoints_);
+    return !checkpoint::validate(hash, window_.height, checkpoints_);
 }
 
 bool chain_state::is_under_checkpoint() const
 {
     // This assumes that the checkpoints are sorted.
-    return checkpoint::covered(data_.height, checkpoints_);
+    return checkpoint::covered(window_.height, checkpoints_);
 }
 
 } // namespace chain
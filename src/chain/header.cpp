@@ -26,10 +26,12 @@
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -190,8 +192,8 @@ header header::factory(reader& source, const hash_digest& hash, bool wire)
 
 bool header::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source, wire);
 }
 
 bool header::from_data(std::istream& stream, bool wire)
@@ -421,7 +423,7 @@ hash_digest header::hash() const
     {
         //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
         mutex_.unlock_upgrade_and_lock();
-        hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data()));
+        hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_fixed_data()));
         mutex_.unlock_and_lock_upgrade();
         //---------------------------------------------------------------------
     }
@@ -433,6 +435,16 @@ hash_digest header::hash() const
     return hash;
 }
 
+// The wire serialization in a fixed size array, without allocation.
+byte_array<80> header::to_fixed_data() const
+{
+    BITCOIN_ASSERT(satoshi_fixed_size() == 80);
+    byte_array<80> data;
+    auto sink = make_unsafe_serializer(data.begin());
+    to_data(sink);
+    return data;
+}
+
 // Validation helpers.
 //-----------------------------------------------------------------------------
 
@@ -21,7 +21,7 @@
 #include <sstream>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
@@ -139,8 +139,8 @@ input input::factory(reader& source, bool wire)
 
 bool input::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source, wire);
 }
 
 bool input::from_data(std::istream& stream, bool wire)
@@ -0,0 +1,563 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/payment_indexer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/input_point.hpp>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/payment_record.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/stealth_record.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/machine/opcode.hpp>
+#include <bitcoin/bitcoin/machine/operation.hpp>
+#include <bitcoin/bitcoin/machine/script_pattern.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+using namespace bc::machine;
+using namespace bc::wallet;
+
+// The minimum number of transactions classified by each thread.
+static constexpr size_t index_grain = 16;
+
+// Slot flags.
+static constexpr uint8_t slot_address = 1;
+static constexpr uint8_t slot_stealth = 2;
+
+static constexpr auto op_dup = static_cast<uint8_t>(opcode::dup);
+static constexpr auto op_hash160 = static_cast<uint8_t>(opcode::hash160);
+static constexpr auto op_equal = static_cast<uint8_t>(opcode::equal);
+static constexpr auto op_equalverify =
+    static_cast<uint8_t>(opcode::equalverify);
+static constexpr auto op_checksig = static_cast<uint8_t>(opcode::checksig);
+static constexpr auto op_return = static_cast<uint8_t>(opcode::return_);
+static constexpr auto op_20 = static_cast<uint8_t>(opcode::push_size_20);
+static constexpr auto op_33 = static_cast<uint8_t>(opcode::push_size_33);
+static constexpr auto op_65 = static_cast<uint8_t>(opcode::push_size_65);
+static constexpr auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
+static constexpr auto op_76 = static_cast<uint8_t>(opcode::push_one_size);
+static constexpr auto op_77 = static_cast<uint8_t>(opcode::push_two_size);
+static constexpr auto op_78 = static_cast<uint8_t>(opcode::push_four_size);
+
+// Byte-level matching.
+//-----------------------------------------------------------------------------
+
+enum class push_result
+{
+    push,
+    not_push,
+    invalid
+};
+
+// Read the operation at position as a push, advancing position past it.
+// Numeric pushes have an empty payload. An invalid push is one that script
+// parsing would not accept as such (truncated or oversized).
+static push_result read_push(const data_chunk& bytes, size_t& position,
+    size_t& payload, size_t& size)
+{
+    const auto end = bytes.size();
+    const auto code = bytes[position++];
+
+    if (!operation::is_push(static_cast<opcode>(code)))
+        return push_result::not_push;
+
+    const auto remaining = end - position;
+
+    if (code <= op_75)
+    {
+        size = code;
+    }
+    else if (code == op_76)
+    {
+        if (remaining < 1)
+            return push_result::invalid;
+
+        size = bytes[position];
+        position += 1;
+    }
+    else if (code == op_77)
+    {
+        if (remaining < 2)
+            return push_result::invalid;
+
+        size = from_little_endian_unsafe<uint16_t>(&bytes[position]);
+        position += 2;
+    }
+    else if (code == op_78)
+    {
+        if (remaining < 4)
+            return push_result::invalid;
+
+        size = from_little_endian_unsafe<uint32_t>(&bytes[position]);
+        position += 4;
+    }
+    else
+    {
+        size = 0;
+    }
+
+    if (size > max_push_data_size || size > end - position)
+        return push_result::invalid;
+
+    payload = position;
+    position += size;
+    return push_result::push;
+}
+
+// [return] [minimal push of 32 to 80 bytes], as is_stealth_script.
+static bool is_stealth(const data_chunk& bytes, size_t& payload)
+{
+    const auto size = bytes.size();
+
+    if (size < 2 || bytes[0] != op_return)
+        return false;
+
+    const auto code = bytes[1];
+
+    if (code >= hash_size && code <= op_75)
+    {
+        payload = 2;
+        return size == payload + code;
+    }
+
+    if (code != op_76 || size < 3 || bytes[2] <= op_75 ||
+        bytes[2] > max_null_data_size)
+        return false;
+
+    payload = 3;
+    return size == payload + bytes[2];
+}
+
+// A matched script has an address hash, or the preimage of that hash when
+// it is a public key or redeem script (hashed by the caller).
+enum class match_result
+{
+    none,
+    hash,
+    preimage
+};
+
+// As ec_public, which parses (compresses) an uncompressed key but takes a
+// compressed key as serialized, so only an uncompressed key is tested.
+static bool is_address_key(data_slice point)
+{
+    if (is_compressed_key(point))
+        return true;
+
+    ec_compressed compressed;
+    return compress(compressed, to_array<ec_uncompressed_size>(point));
+}
+
+static match_result first_hash(short_hash& out_hash,
+    const payment_address::list& addresses)
+{
+    if (addresses.empty() || !addresses.front())
+        return match_result::none;
+
+    out_hash = addresses.front().hash();
+    return match_result::hash;
+}
+
+static match_result match_output(short_hash& out_hash,
+    const uint8_t*& out_preimage, size_t& out_size, const script& script)
+{
+    const auto& bytes = script.bytes();
+    const auto size = bytes.size();
+
+    if (size == 0)
+        return match_result::none;
+
+    const auto code = bytes.front();
+    const auto data = bytes.data();
+
+    // [dup] [hash160] [20] [equalverify] [checksig]
+    if (size == 25 && code == op_dup && bytes[1] == op_hash160 &&
+        bytes[2] == op_20 && bytes[23] == op_equalverify &&
+        bytes[24] == op_checksig)
+    {
+        std::copy_n(data + 3, short_hash_size, out_hash.begin());
+        return match_result::hash;
+    }
+
+    // [hash160] [20] [equal], the only encoding of pay_script_hash.
+    if (code == op_hash160)
+    {
+        if (size != 23 || bytes[1] != op_20 || bytes[22] != op_equal)
+            return match_result::none;
+
+        std::copy_n(data + 2, short_hash_size, out_hash.begin());
+        return match_result::hash;
+    }
+
+    // [33] [checksig] or [65] [checksig]
+    if ((size == 35 && code == op_33) || (size == 67 && code == op_65))
+    {
+        const data_slice point(data + 1, data + size - 1);
+
+        if (bytes.back() == op_checksig && is_public_key(point))
+        {
+            if (!is_address_key(point))
+                return match_result::none;
+
+            out_preimage = point.data();
+            out_size = point.size();
+            return match_result::preimage;
+        }
+    }
+
+    // Other scripts have no address unless a public key push or pay_key_hash
+    // is not minimally encoded (pay_multisig extraction is disabled).
+    if (code != op_dup && code != op_33 && code != op_65 && code != op_76 &&
+        code != op_77 && code != op_78)
+        return match_result::none;
+
+    return first_hash(out_hash, payment_address::extract_output(script));
+}
+
+static match_result match_input(short_hash& out_hash,
+    const uint8_t*& out_preimage, size_t& out_size, const script& script)
+{
+    const auto& bytes = script.bytes();
+    const auto end = bytes.size();
+    size_t pushes = 0;
+    size_t position = 0;
+    size_t payload = 0;
+    size_t size = 0;
+
+    while (position < end)
+    {
+        switch (read_push(bytes, position, payload, size))
+        {
+            case push_result::push:
+                ++pushes;
+                break;
+
+            // Only push-only scripts have an address.
+            case push_result::not_push:
+                return match_result::none;
+
+            case push_result::invalid:
+            default:
+                return first_hash(out_hash,
+                    payment_address::extract_input(script));
+        }
+    }
+
+    if (pushes < 2 || size == 0)
+        return match_result::none;
+
+    const auto last = bytes.data() + payload;
+    out_preimage = last;
+    out_size = size;
+
+    // [signature] [public key]
+    const data_slice point(last, last + size);
+    if (pushes == 2 && is_public_key(point))
+        return is_address_key(point) ? match_result::preimage :
+            match_result::none;
+
+    // [...] [redeem script], where the redeem script is a common output.
+    chain::script redeem;
+    if (!redeem.from_data(data_chunk(last, last + size), false) ||
+        redeem.output_pattern() == script_pattern::non_standard)
+        return match_result::none;
+
+    return match_result::preimage;
+}
+
+bool payment_indexer::extract_output(short_hash& out_hash,
+    const script& script)
+{
+    const uint8_t* preimage;
+    size_t size;
+
+    switch (match_output(out_hash, preimage, size, script))
+    {
+        case match_result::preimage:
+            out_hash = bitcoin_short_hash(data_slice(preimage,
+                preimage + size));
+            return true;
+
+        case match_result::hash:
+            return true;
+
+        case match_result::none:
+        default:
+            return false;
+    }
+}
+
+bool payment_indexer::extract_input(short_hash& out_hash,
+    const script& script)
+{
+    const uint8_t* preimage;
+    size_t size;
+
+    switch (match_input(out_hash, preimage, size, script))
+    {
+        case match_result::preimage:
+            out_hash = bitcoin_short_hash(data_slice(preimage,
+                preimage + size));
+            return true;
+
+        case match_result::hash:
+            return true;
+
+        case match_result::none:
+        default:
+            return false;
+    }
+}
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+payment_indexer::payment_indexer(size_t threads)
+  : threads_(threads), height_(0)
+{
+}
+
+// Indexing.
+//-----------------------------------------------------------------------------
+
+void payment_indexer::index(const block& block, size_t height)
+{
+    const auto& txs = block.transactions();
+    const auto count = txs.size();
+    height_ = height;
+
+    // Each transaction has a slot for each of its inputs, then its outputs.
+    offsets_.resize(count + 1);
+    offsets_.front() = 0;
+
+    for (size_t tx = 0; tx < count; ++tx)
+        offsets_[tx + 1] = offsets_[tx] + txs[tx].inputs().size() +
+            txs[tx].outputs().size();
+
+    const auto slots = offsets_.back();
+    hashes_.resize(count);
+    flags_.resize(slots);
+    keys_.resize(slots);
+    prefixes_.resize(slots);
+    ephemeral_keys_.resize(slots);
+
+    const auto classifier = [&](size_t first, size_t last)
+    {
+        classify(block, first, last);
+    };
+
+    parallel_for(count, index_grain, classifier, threads_);
+    compact(block);
+}
+
+// Each slot is written by exactly one thread. The public keys and redeem
+// scripts of the range are hashed together as a batch.
+void payment_indexer::classify(const block& block, size_t first,
+    size_t last)
+{
+    const auto& txs = block.transactions();
+    std::vector<data_slice> preimages;
+    std::vector<size_t> preimage_slots;
+    const uint8_t* preimage;
+    size_t size;
+
+    const auto set = [&](size_t slot, match_result result)
+    {
+        flags_[slot] = result == match_result::none ? 0 : slot_address;
+
+        if (result == match_result::preimage)
+        {
+            preimages.emplace_back(preimage, preimage + size);
+            preimage_slots.push_back(slot);
+        }
+    };
+
+    for (auto tx = first; tx < last; ++tx)
+    {
+        const auto& transaction = txs[tx];
+        const auto coinbase = transaction.is_coinbase();
+        auto slot = offsets_[tx];
+        hashes_[tx] = transaction.hash();
+
+        for (const auto& input: transaction.inputs())
+        {
+            set(slot, coinbase ? match_result::none :
+                match_input(keys_[slot], preimage, size, input.script()));
+            ++slot;
+        }
+
+        for (const auto& output: transaction.outputs())
+        {
+            const auto& script = output.script();
+            const auto& bytes = script.bytes();
+            size_t payload;
+
+            if (is_stealth(bytes, payload))
+            {
+                const auto hash = bitcoin_hash(bytes);
+                prefixes_[slot] = from_little_endian_unsafe<uint32_t>(
+                    hash.begin());
+                std::copy_n(bytes.begin() + payload, hash_size,
+                    ephemeral_keys_[slot].begin());
+                flags_[slot] = slot_stealth;
+            }
+            else
+            {
+                set(slot, match_output(keys_[slot], preimage, size, script));
+            }
+
+            ++slot;
+        }
+    }
+
+    const auto hashes = bitcoin_short_hashes(preimages);
+
+    for (size_t index = 0; index < hashes.size(); ++index)
+        keys_[preimage_slots[index]] = hashes[index];
+}
+
+void payment_indexer::compact(const block& block)
+{
+    const auto& txs = block.transactions();
+
+    payments_.keys.clear();
+    payments_.transactions.clear();
+    payments_.indexes.clear();
+    payments_.inputs.clear();
+    payments_.data.clear();
+
+    stealth_.prefixes.clear();
+    stealth_.ephemeral_keys.clear();
+    stealth_.keys.clear();
+    stealth_.transactions.clear();
+
+    const auto add_payment = [this](size_t slot, uint32_t tx, uint32_t index,
+        bool input, uint64_t data)
+    {
+        payments_.keys.push_back(keys_[slot]);
+        payments_.transactions.push_back(tx);
+        payments_.indexes.push_back(index);
+        payments_.inputs.push_back(input ? 1 : 0);
+        payments_.data.push_back(data);
+    };
+
+    for (uint32_t tx = 0; tx < txs.size(); ++tx)
+    {
+        const auto& inputs = txs[tx].inputs();
+        const auto& outputs = txs[tx].outputs();
+        const auto base = offsets_[tx];
+        const auto outputs_base = base + inputs.size();
+
+        for (uint32_t index = 0; index < inputs.size(); ++index)
+            if (flags_[base + index] == slot_address)
+                add_payment(base + index, tx, index, true,
+                    inputs[index].previous_output().checksum());
+
+        for (uint32_t index = 0; index < outputs.size(); ++index)
+        {
+            const auto slot = outputs_base + index;
+
+            if (flags_[slot] == slot_address)
+                add_payment(slot, tx, index, false, outputs[index].value());
+
+            // Stealth outputs are paired with the following output.
+            if (flags_[slot] == slot_stealth && index + 1u < outputs.size() &&
+                flags_[slot + 1] == slot_address)
+            {
+                stealth_.prefixes.push_back(prefixes_[slot]);
+                stealth_.ephemeral_keys.push_back(ephemeral_keys_[slot]);
+                stealth_.keys.push_back(keys_[slot + 1]);
+                stealth_.transactions.push_back(tx);
+            }
+        }
+    }
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+size_t payment_indexer::height() const
+{
+    return height_;
+}
+
+const hash_list& payment_indexer::transaction_hashes() const
+{
+    return hashes_;
+}
+
+const payment_indexer::payment_rows& payment_indexer::payments() const
+{
+    return payments_;
+}
+
+const payment_indexer::stealth_rows& payment_indexer::stealth() const
+{
+    return stealth_;
+}
+
+payment_record::list payment_indexer::payment_records() const
+{
+    const auto rows = payments_.keys.size();
+    payment_record::list records;
+    records.reserve(rows);
+
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const auto& hash = hashes_[payments_.transactions[row]];
+        const auto index = payments_.indexes[row];
+        const auto data = payments_.data[row];
+
+        if (payments_.inputs[row] != 0)
+            records.emplace_back(height_, input_point{ hash, index }, data);
+        else
+            records.emplace_back(height_, output_point{ hash, index }, data);
+    }
+
+    return records;
+}
+
+stealth_record::list payment_indexer::stealth_records() const
+{
+    const auto rows = stealth_.keys.size();
+    stealth_record::list records;
+    records.reserve(rows);
+
+    for (size_t row = 0; row < rows; ++row)
+        records.emplace_back(height_, stealth_.prefixes[row],
+            stealth_.ephemeral_keys[row], stealth_.keys[row],
+            hashes_[stealth_.transactions[row]]);
+
+    return records;
+}
+
+} // namespace chain
+} // namespace libbitcoin
@@ -42,6 +42,7 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
@@ -191,8 +192,8 @@ script script::factory(reader& source, bool prefix)
 
 bool script::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    auto source = make_safe_deserializer(encoded.begin(), encoded.end());
+    return from_data(source, prefix);
 }
 
 bool script::from_data(std::istream& stream, bool prefix)
@@ -433,6 +434,11 @@ size_t script::serialized_size(bool prefix) const
     return size;
 }
 
+const data_chunk& script::bytes() const
+{
+    return bytes_;
+}
+
 // protected
 const operation::list& script::operations() const
 {
@@ -448,8 +454,7 @@ const operation::list& script::operations() const
     }
 
     operation op;
-    data_source istream(bytes_);
-    istream_reader source(istream);
+    auto source = make_safe_deserializer(bytes_.begin(), bytes_.end());
     const auto size = bytes_.size();
 
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -27,7 +27,7 @@
 #include <bitcoin/bitcoin/utility/binary.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -49,7 +49,7 @@ stealth_record::stealth_record()
 }
 
 stealth_record::stealth_record(chain::stealth_record&& other)
-  : height_(0), prefix_(0),
+  : height_(other.height_), prefix_(other.prefix_),
     unsigned_ephemeral_(std::move(other.unsigned_ephemeral_)),
     public_key_hash_(std::move(other.public_key_hash_)),
     transaction_hash_(std::move(other.transaction_hash_))
@@ -57,10 +57,10 @@ stealth_record::stealth_record(chain::stealth_record&& other)
 }
 
 stealth_record::stealth_record(const chain::stealth_record& other)
-  : height_(0), prefix_(0),
-    unsigned_ephemeral_(null_hash),
-    public_key_hash_(null_short_hash),
-    transaction_hash_(null_hash)
+  : height_(other.height_), prefix_(other.prefix_),
+    unsigned_ephemeral_(other.unsigned_ephemeral_),
+    public_key_hash_(other.public_key_hash_),
+    transaction_hash_(other.transaction_hash_)
 {
 }
 
@@ -181,8 +181,8 @@ stealth_record stealth_record::factory(reader& source, bool wire)
 
 bool stealth_record::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(source, wire);
 }
 
 bool stealth_record::from_data(std::istream& stream, bool wire)
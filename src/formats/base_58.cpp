@@ -18,18 +18,64 @@
  */
 #include <bitcoin/bitcoin/formats/base_58.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 #include <boost/algorithm/string.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
 
 const std::string base58_chars =
     "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+// The numeric values are accumulated in 32 bit limbs (least significant
+// first) with 64 bit intermediates. An encoding limb holds five base58 digits
+// (58^5 < 2^32) and a decoding limb holds four bytes.
+static constexpr uint32_t base58_limb = 656356768;
+static constexpr size_t digits_per_limb = 5;
+static constexpr size_t bytes_per_limb = sizeof(uint32_t);
+
+// Limbs for payloads of up to 128 bytes, which includes addresses (25 bytes)
+// and extended keys (82 bytes), are not allocated.
+static constexpr size_t stack_limbs = 40;
+
+// The checked sizes of address and extended key payloads, which are encoded
+// with limbs of fixed size.
+static constexpr size_t address_size = 21;
+static constexpr size_t key_size = 78;
+static constexpr size_t checked_address_size = address_size + checksum_size;
+static constexpr size_t checked_key_size = key_size + checksum_size;
+
+// The minimum number of elements of a batch coded by each thread.
+static constexpr size_t batch_grain = 1024;
+
+// Map base58 characters to their values, otherwise to -1.
+static const std::array<int8_t, 256> base58_values = []()
+{
+    std::array<int8_t, 256> values;
+    values.fill(-1);
+
+    for (size_t index = 0; index < base58_chars.size(); ++index)
+        values[static_cast<uint8_t>(base58_chars[index])] =
+            static_cast<int8_t>(index);
+
+    return values;
+}();
+
 bool is_base58(const char ch)
 {
-    // This works because the base58 characters happen to be in sorted order
-    return std::binary_search(base58_chars.begin(), base58_chars.end(), ch);
+    return base58_values[static_cast<uint8_t>(ch)] != -1;
 }
 
 bool is_base58(const std::string& text)
@@ -42,16 +88,6 @@ bool is_base58(const std::string& text)
     return std::all_of(text.begin(), text.end(), test);
 }
 
-template <typename Data>
-auto search_first_nonzero(const Data& data) -> decltype(data.cbegin())
-{
-    auto first_nonzero = data.cbegin();
-    while (first_nonzero != data.end() && *first_nonzero == 0)
-        ++first_nonzero;
-
-    return first_nonzero;
-}
-
 size_t count_leading_zeros(data_slice unencoded)
 {
     // Skip and count leading '1's.
@@ -67,57 +103,170 @@ size_t count_leading_zeros(data_slice unencoded)
     return leading_zeros;
 }
 
-void pack_value(data_chunk& indexes, size_t carry)
+// Apply "limbs = limbs * scale + carry", returning the new limb count.
+template <uint64_t Base>
+size_t multiply_add(uint32_t* limbs, size_t used, uint64_t scale,
+    uint64_t carry)
 {
-    // Apply "b58 = b58 * 256 + ch".
-    for (auto it = indexes.rbegin(); it != indexes.rend(); ++it)
+    for (size_t index = 0; index < used; ++index)
     {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
+        carry += limbs[index] * scale;
+        limbs[index] = static_cast<uint32_t>(carry % Base);
+        carry /= Base;
     }
 
-    BITCOIN_ASSERT(carry == 0);
+    for (; carry != 0; carry /= Base)
+        limbs[used++] = static_cast<uint32_t>(carry % Base);
+
+    return used;
 }
 
-std::string encode_base58(data_slice unencoded)
+// Provide stack limbs for common sizes and allocate otherwise.
+class limb_buffer
 {
-    size_t leading_zeros = count_leading_zeros(unencoded);
+public:
+    limb_buffer(size_t size)
+      : limbs_(size <= stack_limbs ? stack_.data() : nullptr)
+    {
+        if (limbs_ == nullptr)
+        {
+            heap_.resize(size);
+            limbs_ = heap_.data();
+        }
+    }
 
-    // size = log(256) / log(58), rounded up.
-    const size_t number_nonzero = unencoded.size() - leading_zeros;
-    const size_t indexes_size = number_nonzero * 138 / 100 + 1;
+    uint32_t* data()
+    {
+        return limbs_;
+    }
+
+private:
+    std::array<uint32_t, stack_limbs> stack_;
+    std::vector<uint32_t> heap_;
+    uint32_t* limbs_;
+};
+
+// The limbs of an encoding of size bytes, log(256) / log(58) rounded up.
+static constexpr size_t encoded_limbs(size_t size)
+{
+    return (size * 138 / 100 + 1) / digits_per_limb + 1;
+}
+
+// The limbs of a decoding of size digits, log(58) / log(256) rounded up.
+static constexpr size_t decoded_limbs(size_t size)
+{
+    return (size * 733 / 1000 + 1) / bytes_per_limb + 1;
+}
+
+// Accumulate the bytes into the limbs, returning the limb count.
+static size_t to_encoded_limbs(uint32_t* limbs, const uint8_t* data,
+    size_t size)
+{
+    size_t used = 0;
 
-    // Allocate enough space in big-endian base58 representation.
-    data_chunk indexes(indexes_size);
+    // Process the bytes as big endian words, the first of which may be short.
+    auto width = size % bytes_per_limb;
+    width = width == 0 ? bytes_per_limb : width;
 
-    // Process the bytes.
-    for (auto it = unencoded.begin() + leading_zeros;
-        it != unencoded.end(); ++it)
+    for (const auto end = data + size; data != end; width = bytes_per_limb)
     {
-        pack_value(indexes, *it);
+        uint64_t word = 0;
+        for (size_t byte = 0; byte < width; ++byte)
+            word = (word << byte_bits) | *data++;
+
+        used = multiply_add<base58_limb>(limbs, used,
+            uint64_t(1) << (width * byte_bits), word);
     }
 
-    // Skip leading zeroes in base58 result.
-    auto first_nonzero = search_first_nonzero(indexes);
+    return used;
+}
 
-    // Translate the result into a string.
+// Translate the limbs into a string, skipping the leading zero digits of the
+// most significant limb.
+static std::string to_digits(const uint32_t* limbs, size_t used,
+    size_t leading_zeros)
+{
     std::string encoded;
-    const size_t estimated_size = leading_zeros +
-        (indexes.end() - first_nonzero);
-    encoded.reserve(estimated_size);
-    encoded.assign(leading_zeros, '1');
+    encoded.reserve(leading_zeros + used * digits_per_limb);
+    encoded.assign(leading_zeros, base58_chars[0]);
+    char chars[digits_per_limb];
 
-    // Set actual main bytes.
-    for (auto it = first_nonzero; it != indexes.end(); ++it)
+    for (auto limb = used; limb-- > 0;)
     {
-        const size_t index = *it;
-        encoded += base58_chars[index];
+        auto value = limbs[limb];
+        for (auto digit = digits_per_limb; digit-- > 0; value /= 58)
+            chars[digit] = base58_chars[value % 58];
+
+        size_t first = 0;
+        if (limb + 1 == used)
+            while (chars[first] == base58_chars[0])
+                ++first;
+
+        encoded.append(chars + first, chars + digits_per_limb);
     }
 
     return encoded;
 }
 
+template <size_t Size>
+static std::string encode_fixed(const uint8_t* data)
+{
+    std::array<uint32_t, encoded_limbs(Size)> limbs;
+    const auto leading_zeros = count_leading_zeros(
+        data_slice(data, data + Size));
+    const auto used = to_encoded_limbs(limbs.data(), data + leading_zeros,
+        Size - leading_zeros);
+    return to_digits(limbs.data(), used, leading_zeros);
+}
+
+std::string encode_base58(data_slice unencoded)
+{
+    switch (unencoded.size())
+    {
+        case checked_address_size:
+            return encode_fixed<checked_address_size>(unencoded.data());
+        case checked_key_size:
+            return encode_fixed<checked_key_size>(unencoded.data());
+        default:
+            break;
+    }
+
+    const auto leading_zeros = count_leading_zeros(unencoded);
+    const auto size = unencoded.size() - leading_zeros;
+    limb_buffer buffer(encoded_limbs(size));
+    const auto used = to_encoded_limbs(buffer.data(),
+        unencoded.data() + leading_zeros, size);
+    return to_digits(buffer.data(), used, leading_zeros);
+}
+
+// The checksum is appended in place of allocating the checked payload.
+template <size_t Size>
+static std::string encode_checked(data_slice payload)
+{
+    byte_array<Size + checksum_size> checked;
+    const auto checksum = to_little_endian(bitcoin_checksum(payload));
+    std::copy(payload.begin(), payload.end(), checked.begin());
+    std::copy(checksum.begin(), checksum.end(), checked.begin() + Size);
+    return encode_fixed<Size + checksum_size>(checked.data());
+}
+
+std::string encode_base58_check(data_slice payload)
+{
+    switch (payload.size())
+    {
+        case address_size:
+            return encode_checked<address_size>(payload);
+        case key_size:
+            return encode_checked<key_size>(payload);
+        default:
+            break;
+    }
+
+    auto checked = to_chunk(payload);
+    append_checksum(checked);
+    return encode_base58(checked);
+}
+
 size_t count_leading_zeros(const std::string& encoded)
 {
     // Skip and count leading '1's.
@@ -133,63 +282,150 @@ size_t count_leading_zeros(const std::string& encoded)
     return leading_zeros;
 }
 
-void unpack_char(data_chunk& data, size_t carry)
+// Accumulate the digits into the limbs, false if any digit is invalid.
+static bool to_decoded_limbs(uint32_t* limbs, size_t& used, const char* it,
+    const char* end)
+{
+    // Process the characters in groups of five, the last of which may be
+    // short.
+    static constexpr uint64_t limb_base = uint64_t(1) << 32;
+    used = 0;
+
+    while (it != end)
+    {
+        uint64_t scale = 1;
+        uint64_t group = 0;
+
+        for (size_t digit = 0; digit < digits_per_limb && it != end; ++digit)
+        {
+            const auto value = base58_values[static_cast<uint8_t>(*it++)];
+            if (value == -1)
+                return false;
+
+            group = group * 58 + value;
+            scale *= 58;
+        }
+
+        used = multiply_add<limb_base>(limbs, used, scale, group);
+    }
+
+    return true;
+}
+
+// The number of significant bytes of the most significant limb.
+static size_t top_limb_bytes(const uint32_t* limbs, size_t used)
 {
-    for (auto it = data.rbegin(); it != data.rend(); it++)
+    size_t bytes = 0;
+    for (auto value = used == 0 ? 0 : limbs[used - 1]; value != 0;
+        value >>= byte_bits)
+        ++bytes;
+
+    return bytes;
+}
+
+// Copy the limbs as big endian bytes following the leading zero bytes, out
+// must be sized for the decoding.
+static void to_bytes(uint8_t* out, const uint32_t* limbs, size_t used,
+    size_t leading_zeros)
+{
+    out = std::fill_n(out, leading_zeros, 0x00);
+
+    for (auto limb = used; limb-- > 0;)
     {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
+        const auto word = to_big_endian(limbs[limb]);
+        const auto first = limb + 1 == used ?
+            word.end() - top_limb_bytes(limbs, used) : word.begin();
+        out = std::copy(first, word.end(), out);
     }
+}
 
-    BITCOIN_ASSERT(carry == 0);
+// The size of the decoding of used limbs.
+static size_t decoded_size(const uint32_t* limbs, size_t used,
+    size_t leading_zeros)
+{
+    return used == 0 ? leading_zeros : leading_zeros +
+        (used - 1) * bytes_per_limb + top_limb_bytes(limbs, used);
 }
 
 bool decode_base58(data_chunk& out, const std::string& in)
 {
-    // Trim spaces and newlines around the string.
     const auto leading_zeros = count_leading_zeros(in);
+    limb_buffer buffer(decoded_limbs(in.size() - leading_zeros));
+    const auto limbs = buffer.data();
+    size_t used;
 
-    // log(58) / log(256), rounded up.
-    const size_t data_size = in.size() * 733 / 1000 + 1;
+    if (!to_decoded_limbs(limbs, used, in.data() + leading_zeros,
+        in.data() + in.size()))
+        return false;
+
+    data_chunk decoded(decoded_size(limbs, used, leading_zeros));
+    to_bytes(decoded.data(), limbs, used, leading_zeros);
+    out = std::move(decoded);
+    return true;
+}
 
-    // Allocate enough space in big-endian base256 representation.
-    data_chunk data(data_size);
+bool decode_base58_check(data_chunk& out, const std::string& in)
+{
+    data_chunk checked;
+    if (!decode_base58(checked, in) || checked.size() < checksum_size ||
+        !verify_checksum(checked))
+        return false;
+
+    checked.resize(checked.size() - checksum_size);
+    out = std::move(checked);
+    return true;
+}
+
+string_list encode_base58(const data_stack& unencoded)
+{
+    string_list encoded(unencoded.size());
 
-    // Process the characters.
-    for (auto it = in.begin() + leading_zeros; it != in.end(); ++it)
+    const auto encode = [&](size_t first, size_t last)
     {
-        const auto carry = base58_chars.find(*it);
-        if (carry == std::string::npos)
-            return false;
+        for (auto index = first; index < last; ++index)
+            encoded[index] = encode_base58(unencoded[index]);
+    };
 
-        unpack_char(data, carry);
-    }
+    parallel_for(unencoded.size(), batch_grain, encode);
+    return encoded;
+}
 
-    // Skip leading zeroes in data.
-    auto first_nonzero = search_first_nonzero(data);
+bool decode_base58(data_stack& out, const string_list& in)
+{
+    data_stack decoded(in.size());
+    std::vector<uint8_t> results(in.size(), 0);
 
-    // Copy result into output vector.
-    data_chunk decoded;
-    const size_t estimated_size = leading_zeros + (data.end() - first_nonzero);
-    decoded.reserve(estimated_size);
-    decoded.assign(leading_zeros, 0x00);
-    decoded.insert(decoded.end(), first_nonzero, data.cend());
+    const auto decode = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            results[index] = decode_base58(decoded[index], in[index]) ? 1 : 0;
+    };
+
+    parallel_for(in.size(), batch_grain, decode);
 
-    out = decoded;
+    if (std::find(results.begin(), results.end(), 0) != results.end())
+        return false;
+
+    out = std::move(decoded);
     return true;
 }
 
 // For support of template implementation only, do not call directly.
+// Arrays, such as extended keys, are decoded without an intermediate buffer.
 bool decode_base58_private(uint8_t* out, size_t out_size, const char* in)
 {
-    data_chunk buffer;
-    if (!decode_base58(buffer, in) || buffer.size() != out_size)
+    const std::string encoded(in);
+    const auto leading_zeros = count_leading_zeros(encoded);
+    limb_buffer buffer(decoded_limbs(encoded.size() - leading_zeros));
+    const auto limbs = buffer.data();
+    size_t used;
+
+    if (!to_decoded_limbs(limbs, used, encoded.data() + leading_zeros,
+        encoded.data() + encoded.size()) ||
+        decoded_size(limbs, used, leading_zeros) != out_size)
         return false;
 
-    for (size_t i = 0; i < out_size; ++i)
-        out[i] = buffer[i];
-
+    to_bytes(out, limbs, used, leading_zeros);
     return true;
 }
 
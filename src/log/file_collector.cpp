@@ -17,10 +17,20 @@
 
 #include <bitcoin/bitcoin/log/file_collector.hpp>
 
+#include <algorithm>
+#include <stdexcept>
 #include <boost/bind.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/spirit/home/qi/numeric/numeric_utils.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 107000
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
 
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/log/file_char_traits.hpp>
@@ -35,6 +45,19 @@ namespace qi = boost::spirit::qi;
 static boost::arg<1> _1;
 static boost::arg<1> _2;
 
+#ifdef _MSC_VER
+    #define PENDING_EXTENSION L".pending"
+    #define GZIP_EXTENSION L".gz"
+    #define ZSTD_EXTENSION L".zst"
+#else
+    #define PENDING_EXTENSION ".pending"
+    #define GZIP_EXTENSION ".gz"
+    #define ZSTD_EXTENSION ".zst"
+#endif
+
+// Width of the counter used to rename files aside in the write path.
+static const unsigned int pending_width = 5;
+
 //! A possible Boost.Filesystem extension
 //- renames or moves the file to the target storage
 inline void move_file(
@@ -65,6 +88,40 @@ inline void move_file(
 #endif
 }
 
+//! Compresses the file to a new file, zstd is rejected on construction if
+//! it is not available
+static void compress_file(filesystem::path const& from,
+    filesystem::path const& to, file_compression compression)
+{
+    namespace streams = boost::iostreams;
+
+    filesystem::ifstream in(from, std::ios_base::binary);
+    filesystem::ofstream out(to, std::ios_base::binary);
+    if (!in || !out)
+        BOOST_THROW_EXCEPTION(filesystem::filesystem_error(
+            "failed to open file for compression", from, to,
+            boost::system::errc::make_error_code(
+                boost::system::errc::io_error)));
+
+    streams::filtering_ostreambuf stream;
+
+#if BOOST_VERSION >= 107000
+    if (compression == file_compression::zstd)
+        stream.push(streams::zstd_compressor());
+    else
+#endif
+        stream.push(streams::gzip_compressor());
+
+    stream.push(out);
+    streams::copy(in, stream);
+
+    if (!out)
+        BOOST_THROW_EXCEPTION(filesystem::filesystem_error(
+            "failed to write compressed file", from, to,
+            boost::system::errc::make_error_code(
+                boost::system::errc::io_error)));
+}
+
 //! The function parses the format placeholder for file counter
 bool parse_counter_placeholder(path_string_type::const_iterator& it,
     path_string_type::const_iterator end, unsigned int& width)
@@ -262,22 +319,40 @@ file_collector::file_collector(
     filesystem::path const& target_dir,
     size_t max_size,
     size_t min_free_space,
-    size_t max_files)
+    size_t max_files,
+    file_compression compression)
   : repository_(repo), max_size_(max_size), min_free_space_(min_free_space),
     max_files_(max_files), base_path_(filesystem::current_path()),
-    total_size_(0), formatter_(5)
+    total_size_(0), formatter_(5), compression_(compression), pending_(0),
+    sequence_(0), stopped_(false)
 {
+#if BOOST_VERSION < 107000
+    if (compression == file_compression::zstd)
+        BOOST_THROW_EXCEPTION(std::invalid_argument(
+            "zstd archive compression requires boost 1.70 or later"));
+#endif
+
     storage_dir_ = make_absolute(target_dir);
     filesystem::create_directories(storage_dir_);
+    worker_ = boost::thread(&file_collector::archive_files, this);
 }
 
 
 file_collector::~file_collector()
 {
+    {
+        boost::lock_guard<boost::mutex> lock(queue_mutex_);
+        stopped_ = true;
+    }
+
+    // The worker stores any queued files before it exits.
+    queue_condition_.notify_all();
+    worker_.join();
+
     repository_->remove_collector(this);
 }
 
-//! The function stores the specified file in the storage
+//! The function queues the specified file for storage
 void file_collector::store_file(filesystem::path const& src_path)
 {
     // NOTE FOR THE FOLLOWING CODE:
@@ -285,44 +360,165 @@ void file_collector::store_file(filesystem::path const& src_path)
     // at process termination, and the global codecvt facet can already be destroyed at this point.
     // https://svn.boost.org/trac/boost/ticket/8642
 
-    // Let's construct the new file name
-    file_info info;
-    info.timestamp = filesystem::last_write_time(src_path);
-    info.size = filesystem::file_size(src_path);
+    // This is called from the write path of the sink. Rename the file aside
+    // within its own directory, which frees the name for the backend to
+    // reopen, and leave the move, compression and cleanup to the worker.
+    const file_counter_formatter formatter(pending_width);
+    const auto directory = src_path.parent_path();
+    const auto file_name = filename_string(src_path);
 
-#ifdef _MSC_VER
-    path_string_type stem = src_path.stem().wstring();
-    path_string_type extension = src_path.extension().wstring();
-#else
-    path_string_type stem = src_path.stem().string();
-    path_string_type extension = src_path.extension().string();
-#endif
+    pending_file file;
+    file.original = src_path;
 
-//    info.path = storage_dir_ / file_name_path;
+    boost::lock_guard<boost::mutex> lock(queue_mutex_);
 
-    // If the file already exists, try to mangle the file name
-    // to ensure there's no conflict. I'll need to make this customizable some day.
-    unsigned int n = 0;
     do
     {
-        filesystem::path alt_file_name = formatter_(stem, extension, n++);
-        info.path = storage_dir_ / alt_file_name;
+        file.renamed = directory / formatter(file_name, PENDING_EXTENSION,
+            sequence_++);
+    }
+    while (filesystem::exists(file.renamed));
+
+    filesystem::rename(src_path, file.renamed);
+    queue_.push_back(file);
+    ++pending_;
+    queue_condition_.notify_all();
+}
+
+//! Blocks until all queued files have been stored
+void file_collector::flush()
+{
+    boost::unique_lock<boost::mutex> lock(queue_mutex_);
+
+    while (pending_ != 0)
+        queue_condition_.wait(lock);
+}
+
+//! The background thread loop, stores queued files until stopped
+void file_collector::archive_files()
+{
+    while (true)
+    {
+        pending_file file;
+
+        {
+            boost::unique_lock<boost::mutex> lock(queue_mutex_);
+
+            while (queue_.empty() && !stopped_)
+                queue_condition_.wait(lock);
+
+            if (queue_.empty())
+                return;
+
+            file = queue_.front();
+            queue_.pop_front();
+        }
+
+        try
+        {
+            archive_file(file);
+        }
+        catch (std::exception&)
+        {
+            // Can't store the file, it remains renamed aside. Never mind...
+        }
+
+        {
+            boost::lock_guard<boost::mutex> lock(queue_mutex_);
+            --pending_;
+        }
+
+        queue_condition_.notify_all();
     }
-    while (filesystem::exists(info.path) && n < (std::numeric_limits<unsigned int>::max)());
+}
 
+//! Moves or compresses a queued file into the storage directory
+void file_collector::archive_file(pending_file const& file)
+{
+    file_info info;
+    info.timestamp = filesystem::last_write_time(file.renamed);
+    info.path = reserve_path(file.original);
 
     // The directory should have been created in constructor, but just in case it got deleted since then...
     filesystem::create_directories(storage_dir_);
 
+    if (compression_ == file_compression::none)
+    {
+        move_file(file.renamed, info.path);
+    }
+    else
+    {
+        try
+        {
+            compress_file(file.renamed, info.path, compression_);
+        }
+        catch (...)
+        {
+            boost::system::error_code ec;
+            filesystem::remove(info.path, ec);
+            throw;
+        }
+
+        // Preserve the timestamp for chronological ordering upon rescan.
+        filesystem::last_write_time(info.path, info.timestamp);
+        filesystem::remove(file.renamed);
+    }
+
+    info.size = filesystem::file_size(info.path);
+
     BOOST_LOG_EXPR_IF_MT(boost::lock_guard<boost::mutex> lock(mutex_);)
 
+    erase_files(info.size);
+    files_.push_back(info);
+    total_size_ += info.size;
+}
+
+//! Reserves an unused storage name derived from the original file name
+filesystem::path file_collector::reserve_path(
+    filesystem::path const& original)
+{
+#ifdef _MSC_VER
+    path_string_type stem = original.stem().wstring();
+    path_string_type extension = original.extension().wstring();
+#else
+    path_string_type stem = original.stem().string();
+    path_string_type extension = original.extension().string();
+#endif
+
+    if (compression_ == file_compression::gzip)
+        extension += GZIP_EXTENSION;
+    else if (compression_ == file_compression::zstd)
+        extension += ZSTD_EXTENSION;
+
+    BOOST_LOG_EXPR_IF_MT(boost::lock_guard<boost::mutex> lock(mutex_);)
+
+    // Names are tracked as files are stored, scanned and erased, so only the
+    // first name of a stem probes past the previously stored files.
+    auto& counter = counters_[stem + extension];
+
+    filesystem::path path;
+    do
+    {
+        path = storage_dir_ / formatter_(stem, extension, counter++);
+    }
+    while ((names_.find(path.native()) != names_.end() ||
+        filesystem::exists(path)) &&
+        counter < (std::numeric_limits<unsigned int>::max)());
+
+    names_.insert(path.native());
+    return path;
+}
+
+//! Removes the oldest files until the new file fits the restrictions
+void file_collector::erase_files(uintmax_t size)
+{
     // Check if an old file should be erased
     uintmax_t free_space = min_free_space_ ?
         filesystem::space(storage_dir_).available : 0;
 
     file_list::iterator it = files_.begin(), end = files_.end();
     while (it != end &&
-        (total_size_ + info.size > max_size_ || min_free_space_ > free_space || max_files_ <= files_.size()))
+        (total_size_ + size > max_size_ || min_free_space_ > free_space || max_files_ <= files_.size()))
     {
         file_info& old_info = *it;
         if (filesystem::exists(old_info.path) && filesystem::is_regular_file(old_info.path))
@@ -335,6 +531,7 @@ void file_collector::store_file(filesystem::path const& src_path)
                 if (min_free_space_)
                     free_space = filesystem::space(storage_dir_).available;
                 total_size_ -= old_info.size;
+                names_.erase(old_info.path.native());
                 files_.erase(it++);
             }
             catch (boost::system::system_error&)
@@ -347,15 +544,10 @@ void file_collector::store_file(filesystem::path const& src_path)
         {
             // If it's not a file or is absent, just remove it from the list
             total_size_ -= old_info.size;
+            names_.erase(old_info.path.native());
             files_.erase(it++);
         }
     }
-
-    // Move/rename the file to the target storage
-    move_file(src_path, info.path);
-
-    files_.push_back(info);
-    total_size_ += info.size;
 }
 
 
@@ -380,6 +572,10 @@ uintmax_t file_collector::scan_for_files(
             counter = NULL;
         }
 
+        // Files are renamed aside in the directory of the log file.
+        recover_files(pattern.has_parent_path() ?
+            make_absolute(pattern.parent_path()) : base_path_, mask);
+
         if (filesystem::exists(dir) && filesystem::is_directory(dir))
         {
             BOOST_LOG_EXPR_IF_MT(boost::lock_guard<boost::mutex> lock(mutex_);)
@@ -396,17 +592,9 @@ uintmax_t file_collector::scan_for_files(
                 info.path = *it;
                 if (filesystem::is_regular_file(info.path))
                 {
-                    // Check that there are no duplicates in the resulting list
-                    struct local
-                    {
-                        static bool equivalent(filesystem::path const& left, file_info const& right)
-                        {
-                            return filesystem::equivalent(left, right.path);
-                        }
-                    };
-
-                    if (std::find_if(files_.begin(), files_.end(),
-                        boost::bind(&local::equivalent, boost::cref(info.path), _1)) == files_.end())
+                    // Check that there are no duplicates in the resulting
+                    // list, using the tracked names rather than a search.
+                    if (names_.find(info.path.native()) == names_.end())
                     {
                         // Check that the file name matches the pattern
                         unsigned int file_number = 0;
@@ -416,6 +604,7 @@ uintmax_t file_collector::scan_for_files(
                             info.size = filesystem::file_size(info.path);
                             total_size += info.size;
                             info.timestamp = filesystem::last_write_time(info.path);
+                            names_.insert(info.path.native());
                             files.push_back(info);
                             ++file_count;
 
@@ -437,6 +626,63 @@ uintmax_t file_collector::scan_for_files(
 }
 
 
+//! Queues the files left renamed aside by a previous process for storage
+void file_collector::recover_files(filesystem::path const& dir,
+    path_string_type const& mask)
+{
+    static const path_string_type pending(PENDING_EXTENSION);
+
+    if (!filesystem::exists(dir) || !filesystem::is_directory(dir))
+        return;
+
+    boost::lock_guard<boost::mutex> lock(queue_mutex_);
+
+    filesystem::directory_iterator it(dir), end;
+    for (; it != end; ++it)
+    {
+        const filesystem::path path = *it;
+        const auto name = filename_string(path);
+
+        if (!filesystem::is_regular_file(path) || name.size() <=
+            pending.size() || name.compare(name.size() - pending.size(),
+                pending.size(), pending) != 0)
+            continue;
+
+        // The renamed file is the original name, a separator and a counter.
+        auto position = name.size() - pending.size();
+        const auto digits = position;
+        while (position > 0 && file_char_traits::is_digit(name[position - 1]))
+            --position;
+
+        if (position == digits || position < 2 ||
+            name[position - 1] != file_char_traits::minus)
+            continue;
+
+        const auto original = name.substr(0, position - 1);
+        unsigned int file_number = 0;
+        if (!mask.empty() && !match_pattern(original, mask, file_number))
+            continue;
+
+        // Files renamed aside by this process are already queued.
+        const auto queued = std::find_if(queue_.begin(), queue_.end(),
+            [&path](pending_file const& file)
+            {
+                return file.renamed == path;
+            });
+
+        if (queued != queue_.end())
+            continue;
+
+        pending_file file;
+        file.original = dir / original;
+        file.renamed = path;
+        queue_.push_back(file);
+        ++pending_;
+    }
+
+    queue_condition_.notify_all();
+}
+
 //! The function updates storage restrictions
 void file_collector::update(
     size_t max_size, size_t min_free_space, size_t max_files)
@@ -30,6 +30,7 @@
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/log/attributes.hpp>
 #include <bitcoin/bitcoin/log/file_collector_repository.hpp>
+#include <bitcoin/bitcoin/log/ring_buffer_queue.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 #include <bitcoin/bitcoin/unicode/ofstream.hpp>
 
@@ -56,8 +57,14 @@ using namespace boost::posix_time;
     << CHANNEL_FORMATTER << " " \
     << MESSAGE_FORMATTER
 
+// Records queued by each asynchronous sink before overflow.
+static BC_CONSTEXPR size_t queue_capacity = 8192;
+typedef ring_buffer_queue<queue_capacity> record_queue;
+
 typedef synchronous_sink<text_file_backend> text_file_sink;
 typedef synchronous_sink<text_ostream_backend> text_stream_sink;
+typedef asynchronous_sink<text_file_backend, record_queue> async_file_sink;
+typedef asynchronous_sink<text_ostream_backend, record_queue> async_stream_sink;
 
 static const auto base_filter =
     has_attr(attributes::channel) &&
@@ -101,14 +108,16 @@ static boost::shared_ptr<collector> file_collector(
             rotation.maximum_archive_size,
         rotation.minimum_free_space,
         rotation.maximum_archive_files == 0 ? max_size_t :
-            rotation.maximum_archive_files);
+            rotation.maximum_archive_files,
+        rotation.archive_compression);
 }
 
-static boost::shared_ptr<text_file_sink> add_text_file_sink(
+template <typename Sink=text_file_sink>
+static boost::shared_ptr<Sink> add_text_file_sink(
     const rotable_file& rotation)
 {
     // Construct a log sink.
-    const auto sink = boost::make_shared<text_file_sink>();
+    const auto sink = boost::make_shared<Sink>();
     const auto backend = sink->locked_backend();
 
     // Add a file stream for the sink to write to.
@@ -135,12 +144,12 @@ static boost::shared_ptr<text_file_sink> add_text_file_sink(
     return sink;
 }
 
-template<typename Stream>
-static boost::shared_ptr<text_stream_sink> add_text_stream_sink(
+template<typename Stream, typename Sink=text_stream_sink>
+static boost::shared_ptr<Sink> add_text_stream_sink(
     boost::shared_ptr<Stream>& stream)
 {
     // Construct a log sink.
-    const auto sink = boost::make_shared<text_stream_sink>();
+    const auto sink = boost::make_shared<Sink>();
     const auto backend = sink->locked_backend();
 
     // Add a stream for the sink to write to.
@@ -183,5 +192,46 @@ void initialize(const rotable_file& debug_file, const rotable_file& error_file,
     add_text_stream_sink(error_stream)->set_filter(error_filter);
 }
 
+// Asynchronous sinks.
+//-----------------------------------------------------------------------------
+
+template <typename Sink>
+static void set_async(const boost::shared_ptr<Sink>& sink,
+    overflow_policy policy, const filter& filter)
+{
+    sink->set_overflow_policy(policy);
+    sink->set_filter(filter);
+}
+
+template<typename Stream>
+static boost::shared_ptr<async_stream_sink> add_async_stream_sink(
+    boost::shared_ptr<Stream>& stream)
+{
+    return add_text_stream_sink<Stream, async_stream_sink>(stream);
+}
+
+void initialize(log::file& debug_file, log::file& error_file,
+    log::stream& output_stream, log::stream& error_stream, bool verbose,
+    overflow_policy policy)
+{
+    set_async(add_async_stream_sink(debug_file), policy,
+        verbose ? filter(base_filter) : filter(lean_filter));
+    set_async(add_async_stream_sink(error_file), policy, error_filter);
+    set_async(add_async_stream_sink(output_stream), policy, info_filter);
+    set_async(add_async_stream_sink(error_stream), policy, error_filter);
+}
+
+void initialize(const rotable_file& debug_file, const rotable_file& error_file,
+    log::stream& output_stream, log::stream& error_stream, bool verbose,
+    overflow_policy policy)
+{
+    set_async(add_text_file_sink<async_file_sink>(debug_file), policy,
+        verbose ? filter(base_filter) : filter(lean_filter));
+    set_async(add_text_file_sink<async_file_sink>(error_file), policy,
+        error_filter);
+    set_async(add_async_stream_sink(output_stream), policy, info_filter);
+    set_async(add_async_stream_sink(error_stream), policy, error_filter);
+}
+
 } // namespace log
 } // namespace libbitcoin
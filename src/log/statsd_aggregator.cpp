@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/log/statsd_aggregator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/log/attributes.hpp>
+#include <boost/log/common.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/log/features/counter.hpp>
+#include <bitcoin/bitcoin/log/features/gauge.hpp>
+#include <bitcoin/bitcoin/log/features/metric.hpp>
+#include <bitcoin/bitcoin/log/features/rate.hpp>
+#include <bitcoin/bitcoin/log/features/timer.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+using namespace std::placeholders;
+using namespace boost::asio;
+using namespace boost::log;
+
+const size_t statsd_aggregator::default_mtu = 1432;
+const asio::duration statsd_aggregator::default_interval = asio::seconds(10);
+
+// Percentiles reported for each timer, in addition to count/lower/upper/mean.
+static const std::vector<size_t> percentiles{ 50, 90, 95, 99 };
+
+statsd_aggregator::statsd_aggregator(threadpool& pool, socket_ptr socket,
+    endpoint_ptr endpoint, const asio::duration& interval, size_t mtu)
+  : pool_(pool),
+    socket_(socket),
+    endpoint_(endpoint),
+    interval_(interval),
+    mtu_(std::max(mtu, size_t(1))),
+    stopped_(true),
+    sequence_(0)
+{
+}
+
+// Sends do not refer to the instance, so it can be flushed here.
+statsd_aggregator::~statsd_aggregator()
+{
+    stop();
+}
+
+void statsd_aggregator::start()
+{
+    if (!stopped_.exchange(false))
+        return;
+
+    timer_ = std::make_shared<deadline>(pool_, interval_);
+    schedule();
+}
+
+void statsd_aggregator::stop()
+{
+    if (stopped_.exchange(true))
+        return;
+
+    timer_->stop();
+    flush();
+}
+
+void statsd_aggregator::handle_timer(const code& ec)
+{
+    if (stopped_ || ec)
+        return;
+
+    flush();
+    schedule();
+}
+
+// The timer holds a weak reference, so a started instance is released when
+// its last owner releases it.
+void statsd_aggregator::schedule()
+{
+    const boost::weak_ptr<statsd_aggregator> weak = shared_from_this();
+
+    timer_->start([weak](const code& ec)
+    {
+        const auto self = weak.lock();
+
+        if (self)
+            self->handle_timer(ec);
+    });
+}
+
+// Emission.
+//-----------------------------------------------------------------------------
+
+// The thread's buffer is created once and registered for flushing. Its lock is
+// only contended while the buffer is being swapped out by a flush.
+statsd_aggregator::buffer& statsd_aggregator::local()
+{
+    auto holder = local_.get();
+
+    if (holder == nullptr)
+    {
+        holder = new buffer_ptr(std::make_shared<buffer>());
+        local_.reset(holder);
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        unique_lock lock(buffers_mutex_);
+
+        buffers_.push_back(*holder);
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    return **holder;
+}
+
+void statsd_aggregator::counter(const std::string& name, int64_t value,
+    float rate)
+{
+    const auto scale = (rate > 0.0f && rate < 1.0f) ? 1.0 / rate : 1.0;
+    auto& buffer = local();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(buffer.mutex);
+
+    buffer.counters[name] += static_cast<double>(value) * scale;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void statsd_aggregator::gauge(const std::string& name, uint64_t value)
+{
+    const auto sequence = ++sequence_;
+    auto& buffer = local();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(buffer.mutex);
+
+    buffer.gauges[name] = { value, sequence };
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void statsd_aggregator::timer(const std::string& name,
+    const asio::milliseconds& value)
+{
+    const auto sample = static_cast<uint64_t>(std::max(value.count(),
+        asio::milliseconds::rep(0)));
+    auto& buffer = local();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(buffer.mutex);
+
+    buffer.timers[name].push_back(sample);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Formatting is deferred to flush, the caller only extracts attribute values.
+void statsd_aggregator::consume(const record_view& record)
+{
+    const auto metric = record[attributes::metric];
+    if (!metric)
+        return;
+
+    const auto rate = record[attributes::rate];
+    const auto counter_value = record[attributes::counter];
+    const auto gauge_value = record[attributes::gauge];
+    const auto timer_value = record[attributes::timer];
+
+    if (counter_value)
+        counter(metric.get(), counter_value.get(), rate ? rate.get() : 1.0f);
+
+    if (gauge_value)
+        gauge(metric.get(), gauge_value.get());
+
+    if (timer_value)
+        timer(metric.get(), timer_value.get());
+}
+
+// Flush.
+//-----------------------------------------------------------------------------
+
+void statsd_aggregator::flush()
+{
+    std::vector<buffer_ptr> buffers;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(flush_mutex_);
+
+    buffers_mutex_.lock_shared();
+    buffers = buffers_;
+    buffers_mutex_.unlock_shared();
+
+    buffer merged;
+
+    for (const auto& thread: buffers)
+    {
+        buffer swapped;
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        thread->mutex.lock();
+        swapped.counters.swap(thread->counters);
+        swapped.gauges.swap(thread->gauges);
+        swapped.timers.swap(thread->timers);
+        thread->mutex.unlock();
+        ///////////////////////////////////////////////////////////////////////
+
+        for (const auto& counter: swapped.counters)
+            merged.counters[counter.first] += counter.second;
+
+        for (const auto& gauge: swapped.gauges)
+        {
+            auto& value = merged.gauges[gauge.first];
+            if (gauge.second.sequence >= value.sequence)
+                value = gauge.second;
+        }
+
+        for (auto& timer: swapped.timers)
+        {
+            auto& samples = merged.timers[timer.first];
+            samples.insert(samples.end(), timer.second.begin(),
+                timer.second.end());
+        }
+    }
+
+    // Release the buffers of terminated threads once drained.
+    buffers.clear();
+    buffers_mutex_.lock();
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+        [](const buffer_ptr& buffer) { return buffer.use_count() == 1; }),
+        buffers_.end());
+    buffers_mutex_.unlock();
+
+    lines out;
+
+    for (const auto& counter: merged.counters)
+        out.push_back(counter.first + ":" + std::to_string(
+            static_cast<int64_t>(std::llround(counter.second))) + "|c");
+
+    for (const auto& gauge: merged.gauges)
+        out.push_back(gauge.first + ":" +
+            std::to_string(gauge.second.value) + "|g");
+
+    for (auto& timer: merged.timers)
+        summarize(timer.first, timer.second, out);
+
+    send(out);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Percentiles use the nearest-rank method over the sorted samples.
+void statsd_aggregator::summarize(const std::string& name,
+    std::vector<uint64_t>& samples, lines& out) const
+{
+    if (samples.empty())
+        return;
+
+    std::sort(samples.begin(), samples.end());
+    const auto count = samples.size();
+    uint64_t sum = 0;
+
+    for (const auto sample: samples)
+        sum += sample;
+
+    const auto gauge = [&out, &name](const std::string& suffix,
+        uint64_t value)
+    {
+        out.push_back(name + "." + suffix + ":" + std::to_string(value) +
+            "|g");
+    };
+
+    out.push_back(name + ".count:" + std::to_string(count) + "|c");
+    gauge("lower", samples.front());
+    gauge("upper", samples.back());
+    gauge("mean", sum / count);
+
+    for (const auto percentile: percentiles)
+    {
+        const auto rank = (percentile * count + 99) / 100;
+        gauge("p" + std::to_string(percentile),
+            samples[std::max(rank, size_t(1)) - 1]);
+    }
+}
+
+// Lines are packed into newline-delimited packets of no more than mtu bytes.
+// A line that alone exceeds the mtu is sent in its own packet.
+void statsd_aggregator::send(const lines& out)
+{
+    if (!socket_ || !endpoint_ || out.empty())
+        return;
+
+    auto payload = boost::make_shared<std::string>();
+
+    for (const auto& line: out)
+    {
+        const auto delimiter = payload->empty() ? 0u : 1u;
+
+        if (!payload->empty() &&
+            payload->size() + delimiter + line.size() > mtu_)
+        {
+            send(payload);
+            payload = boost::make_shared<std::string>();
+        }
+
+        if (!payload->empty())
+            payload->push_back('\n');
+
+        payload->append(line);
+    }
+
+    send(payload);
+}
+
+// The handler holds the socket and message in scope until the send is
+// completed, it does not refer to this instance.
+void statsd_aggregator::send(message_ptr payload)
+{
+    const auto socket = socket_;
+
+    socket_->async_send_to(boost::asio::buffer(*payload), *endpoint_,
+        [socket, payload](const boost_code&, size_t)
+        {
+        });
+}
+
+} // namespace log
+} // namespace libbitcoin
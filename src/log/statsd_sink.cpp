@@ -35,6 +35,7 @@
 #include <bitcoin/bitcoin/log/features/timer.hpp>
 #include <bitcoin/bitcoin/log/file_collector_repository.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
+#include <bitcoin/bitcoin/log/statsd_aggregator.hpp>
 #include <bitcoin/bitcoin/log/udp_client_sink.hpp>
 #include <bitcoin/bitcoin/unicode/ofstream.hpp>
 #include <bitcoin/bitcoin/utility/asio.hpp>
@@ -52,6 +53,7 @@ using namespace boost::log::sinks::file;
 
 typedef synchronous_sink<text_file_backend> text_file_sink;
 typedef synchronous_sink<udp_client_sink> text_udp_sink;
+typedef unlocked_sink<statsd_aggregator> aggregate_udp_sink;
 
 static const auto statsd_filter = has_attr(attributes::metric) &&
     (has_attr(attributes::counter) || has_attr(attributes::gauge) ||
@@ -85,7 +87,8 @@ static boost::shared_ptr<collector> file_collector(
             rotation.maximum_archive_size,
         rotation.minimum_free_space,
         rotation.maximum_archive_files == 0 ? max_size_t :
-            rotation.maximum_archive_files);
+            rotation.maximum_archive_files,
+        rotation.archive_compression);
 }
 
 static boost::shared_ptr<text_file_sink> add_text_file_sink(
@@ -148,5 +151,36 @@ void initialize_statsd(threadpool& pool, const authority& server)
         add_udp_sink(pool, server)->set_filter(statsd_filter);
 }
 
+static boost::shared_ptr<aggregate_udp_sink> add_aggregate_sink(
+    statsd_aggregator::ptr backend)
+{
+    // Construct a log sink, the backend is safe for concurrent feeding.
+    const auto sink = boost::make_shared<aggregate_udp_sink>(backend);
+
+    // Register the sink with the logging core.
+    core::get()->add_sink(sink);
+    return sink;
+}
+
+statsd_aggregator::ptr initialize_statsd(threadpool& pool,
+    const authority& server, const asio::duration& interval, size_t mtu)
+{
+    if (!server)
+        return{};
+
+    auto socket = boost::make_shared<udp::socket>(pool.service());
+    socket->open(udp::v6());
+
+    auto endpoint = boost::make_shared<udp::endpoint>(server.asio_ip(),
+        server.port());
+
+    const auto backend = boost::make_shared<statsd_aggregator>(pool, socket,
+        endpoint, interval, mtu);
+
+    add_aggregate_sink(backend)->set_filter(statsd_filter);
+    backend->start();
+    return backend;
+}
+
 } // namespace log
 } // namespace libbitcoin
@@ -36,6 +36,12 @@ uint32_t bitcoin_checksum(data_slice data)
     return from_little_endian_unsafe<uint32_t>(hash.begin());
 }
 
+uint32_t bitcoin_checksum(const std::vector<data_slice>& slices)
+{
+    const auto hash = bitcoin_hash(slices);
+    return from_little_endian_unsafe<uint32_t>(hash.begin());
+}
+
 bool verify_checksum(data_slice data)
 {
     if (data.size() < checksum_size)
@@ -19,13 +19,16 @@
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
+#include <vector>
 #include <secp256k1.h>
 #include <secp256k1_recovery.h>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include "../math/external/lax_der_parsing.h"
 #include "secp256k1_initializer.hpp"
 
@@ -90,6 +93,35 @@ bool secret_to_public(const secp256k1_context* context, byte_array<Size>& out,
         serialize(context, out, pubkey);
 }
 
+// The signing context is shared (read only) by all threads.
+template <size_t Size>
+bool secret_to_public(const secp256k1_context* context,
+    std::vector<byte_array<Size>>& out, const secret_list& secrets,
+    size_t threads)
+{
+    // The minimum number of keys generated by each thread.
+    static constexpr size_t grain = 64;
+
+    std::atomic<bool> valid(true);
+    std::vector<byte_array<Size>> points(secrets.size());
+
+    const auto generate = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+        {
+            if (!secret_to_public(context, points[index], secrets[index]))
+            {
+                points[index].fill(0);
+                valid = false;
+            }
+        }
+    };
+
+    parallel_for(secrets.size(), grain, generate, threads);
+    out = std::move(points);
+    return valid;
+}
+
 template <size_t Size>
 bool recover_public(const secp256k1_context* context, byte_array<Size>& out,
     const recoverable_signature& recoverable, const hash_digest& hash)
@@ -189,6 +221,20 @@ bool secret_to_public(ec_uncompressed& out, const ec_secret& secret)
     return secret_to_public(context, out, secret);
 }
 
+bool secret_to_public(point_list& out, const secret_list& secrets,
+    size_t threads)
+{
+    const auto context = signing.context();
+    return secret_to_public(context, out, secrets, threads);
+}
+
+bool secret_to_public(uncompressed_list& out, const secret_list& secrets,
+    size_t threads)
+{
+    const auto context = signing.context();
+    return secret_to_public(context, out, secrets, threads);
+}
+
 // Verify keys
 // ----------------------------------------------------------------------------
 
@@ -35,12 +35,12 @@
 #include <bitcoin/bitcoin/compat.h>
 #include "pbkdf2_sha256.h"
 
-static void blkcpy(uint8_t*, uint8_t*, size_t);
-static void blkxor(uint8_t*, uint8_t*, size_t);
-static void salsa20_8(uint8_t[64]);
-static void blockmix_salsa8(uint8_t*, uint8_t*, size_t);
-static uint64_t integerify(uint8_t*, size_t);
-static void smix(uint8_t* , size_t, uint64_t, uint8_t*, uint8_t*);
+static void blkcpy(uint32_t*, const uint32_t*, size_t);
+static void blkxor(uint32_t*, const uint32_t*, size_t);
+static void salsa20_8(uint32_t[16]);
+static void blockmix_salsa8(const uint32_t*, uint32_t*, uint32_t*, size_t);
+static uint64_t integerify(const uint32_t*, size_t);
+static void smix(uint8_t*, size_t, uint64_t, uint32_t*, uint32_t*);
 
 static BC_C_INLINE uint32_t le32dec(const void* pp)
 {
@@ -58,30 +58,21 @@ static BC_C_INLINE void le32enc(void* pp, uint32_t x)
     p[3] = (x >> 24) & 0xff;
 }
 
-static BC_C_INLINE uint64_t le64dec(const void* pp)
-{
-    const uint8_t* p = (uint8_t const* )pp;
-
-    return ((uint64_t)(p[0]) + ((uint64_t)(p[1]) << 8) +
-            ((uint64_t)(p[2]) << 16) + ((uint64_t)(p[3]) << 24) +
-            ((uint64_t)(p[4]) << 32) + ((uint64_t)(p[5]) << 40) +
-            ((uint64_t)(p[6]) << 48) + ((uint64_t)(p[7]) << 56));
-}
-
+/* The mixing functions operate on native 32 bit words, which allows the */
+/* compiler to vectorize the copies, xors and additions. Byte order is */
+/* only converted on entry to and exit from smix. */
 
-static void blkcpy(uint8_t* dest, uint8_t* src, size_t len)
+static void blkcpy(uint32_t* dest, const uint32_t* src, size_t len)
 {
-    size_t i;
-
-    for (i = 0; i < len; i++)
-        dest[i] = src[i];
+    memcpy(dest, src, len);
 }
 
-static void blkxor(uint8_t* dest, uint8_t* src, size_t len)
+static void blkxor(uint32_t* dest, const uint32_t* src, size_t len)
 {
     size_t i;
+    const size_t words = len / sizeof(uint32_t);
 
-    for (i = 0; i < len; i++)
+    for (i = 0; i < words; i++)
         dest[i] ^= src[i];
 }
 
@@ -89,19 +80,13 @@ static void blkxor(uint8_t* dest, uint8_t* src, size_t len)
  * salsa20_8(B):
  * Apply the salsa20/8 core to the provided block.
  */
-static void salsa20_8(uint8_t B[64])
+static void salsa20_8(uint32_t B[16])
 {
-    uint32_t B32[16];
     uint32_t x[16];
     size_t i;
 
-    /* Convert little-endian values in. */
-    for (i = 0; i < 16; i++)
-        B32[i] = le32dec(&B[i * 4]);
-
-    /* Compute x = doubleround^4(B32). */
-    for (i = 0; i < 16; i++)
-        x[i] = B32[i];
+    /* Compute x = doubleround^4(B). */
+    blkcpy(x, B, 64);
     for (i = 0; i < 8; i += 2) {
 #define R(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
         /* Operate on columns. */
@@ -132,170 +117,217 @@ static void salsa20_8(uint8_t B[64])
 #undef R
     }
 
-    /* Compute B32 = B32 + x. */
-    for (i = 0; i < 16; i++)
-        B32[i] += x[i];
-
-    /* Convert little-endian values out. */
+    /* Compute B = B + x. */
     for (i = 0; i < 16; i++)
-        le32enc(&B[4 * i], B32[i]);
+        B[i] += x[i];
 }
 
 /**
- * blockmix_salsa8(B, Y, r):
- * Compute B = BlockMix_{salsa20/8, r}(B).  The input B must be 128r bytes in
- * length; the temporary space Y must also be the same size.
+ * blockmix_salsa8(Bin, Bout, X, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin).  The input Bin must be 128r
+ * bytes in length; the output Bout must also be the same size.  The
+ * temporary space X must be 64 bytes.
  */
-static void blockmix_salsa8(uint8_t* B, uint8_t* Y, size_t r)
+static void blockmix_salsa8(const uint32_t* Bin, uint32_t* Bout, uint32_t* X,
+    size_t r)
 {
-    uint8_t X[64];
     size_t i;
 
     /* 1: X <-- B_{2r - 1} */
-    blkcpy(X, &B[(2 * r - 1) * 64], 64);
+    blkcpy(X, &Bin[(2 * r - 1) * 16], 64);
 
     /* 2: for i = 0 to 2r - 1 do */
-    for (i = 0; i < 2 * r; i++) {
+    for (i = 0; i < 2 * r; i += 2) {
         /* 3: X <-- H(X \xor B_i) */
-        blkxor(X, &B[i * 64], 64);
+        blkxor(X, &Bin[i * 16], 64);
         salsa20_8(X);
 
         /* 4: Y_i <-- X */
-        blkcpy(&Y[i * 64], X, 64);
-    }
+        /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+        blkcpy(&Bout[i * 8], X, 64);
+
+        /* 3: X <-- H(X \xor B_i) */
+        blkxor(X, &Bin[i * 16 + 16], 64);
+        salsa20_8(X);
 
-    /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
-    for (i = 0; i < r; i++)
-        blkcpy(&B[i * 64], &Y[(i * 2) * 64], 64);
-    for (i = 0; i < r; i++)
-        blkcpy(&B[(i + r) * 64], &Y[(i * 2 + 1) * 64], 64);
+        /* 4: Y_i <-- X */
+        /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+        blkcpy(&Bout[i * 8 + r * 16], X, 64);
+    }
 }
 
 /**
  * integerify(B, r):
  * Return the result of parsing B_{2r-1} as a little-endian integer.
  */
-static uint64_t integerify(uint8_t* B, size_t r)
+static uint64_t integerify(const uint32_t* B, size_t r)
 {
-    uint8_t* X = &B[(2 * r - 1) * 64];
+    const uint32_t* X = &B[(2 * r - 1) * 16];
 
-    return (le64dec(X));
+    return (((uint64_t)(X[1]) << 32) + X[0]);
 }
 
 /**
  * smix(B, r, N, V, XY):
  * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length; the
  * temporary storage V must be 128rN bytes in length; the temporary storage
- * XY must be 256r bytes in length.  The value N must be a power of 2.
+ * XY must be 256r + 64 bytes in length.  The value N must be a power of 2
+ * greater than 1.
  */
 static void smix(uint8_t* B, size_t r,
-    uint64_t N, uint8_t* V, uint8_t* XY)
+    uint64_t N, uint32_t* V, uint32_t* XY)
 {
-    uint8_t* X = XY;
-    uint8_t* Y = &XY[128 * r];
+    uint32_t* X = XY;
+    uint32_t* Y = &XY[32 * r];
+    uint32_t* Z = &XY[64 * r];
     uint64_t i;
     uint64_t j;
+    size_t k;
 
     /* 1: X <-- B */
-    blkcpy(X, B, 128 * r);
+    for (k = 0; k < 32 * r; k++)
+        X[k] = le32dec(&B[4 * k]);
 
     /* 2: for i = 0 to N - 1 do */
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += 2) {
         /* 3: V_i <-- X */
-        blkcpy(&V[i * (128 * r)], X, 128 * r);
+        blkcpy(&V[i * (32 * r)], X, 128 * r);
 
         /* 4: X <-- H(X) */
-        blockmix_salsa8(X, Y, r);
+        blockmix_salsa8(X, Y, Z, r);
+
+        /* 3: V_i <-- X */
+        blkcpy(&V[(i + 1) * (32 * r)], Y, 128 * r);
+
+        /* 4: X <-- H(X) */
+        blockmix_salsa8(Y, X, Z, r);
     }
 
     /* 6: for i = 0 to N - 1 do */
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += 2) {
         /* 7: j <-- Integerify(X) mod N */
         j = integerify(X, r) & (N - 1);
 
         /* 8: X <-- H(X \xor V_j) */
-        blkxor(X, &V[j * (128 * r)], 128 * r);
-        blockmix_salsa8(X, Y, r);
+        blkxor(X, &V[j * (32 * r)], 128 * r);
+        blockmix_salsa8(X, Y, Z, r);
+
+        /* 7: j <-- Integerify(X) mod N */
+        j = integerify(Y, r) & (N - 1);
+
+        /* 8: X <-- H(X \xor V_j) */
+        blkxor(Y, &V[j * (32 * r)], 128 * r);
+        blockmix_salsa8(Y, X, Z, r);
     }
 
     /* 10: B' <-- X */
-    blkcpy(B, X, 128 * r);
+    for (k = 0; k < 32 * r; k++)
+        le32enc(&B[4 * k], X[k]);
 }
 
-/**
- * crypto_scrypt(passwd, passwdlen, salt, saltlen, N, r, p, buf, buflen):
- * Compute scrypt(passwd[0 .. passwdlen - 1], salt[0 .. saltlen - 1], N, r,
- * p, buflen) and write the result into buf.  The parameters r, p, and buflen
- * must satisfy r * p < 2^30 and buflen <= (2^32 - 1) * 32.  The parameter N
- * must be a power of 2.
- *
- * Return 0 on success; or -1 on error.
- */
-int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
-    const uint8_t* salt, size_t salt_length, uint64_t N,
-    uint32_t r, uint32_t p, uint8_t* buf, size_t buf_length)
+int crypto_scrypt_check(uint64_t N, uint32_t r, uint32_t p,
+    size_t buf_length)
 {
-    uint8_t* B;
-    uint8_t* V;
-    uint8_t* XY;
-    uint32_t i;
-
     /* Sanity-check parameters. */
 #if SIZE_MAX > UINT32_MAX
     if (buf_length > (((uint64_t)(1) << 32) - 1) * 32) {
         errno = EFBIG;
-        goto err0;
+        return (-1);
     }
 #endif
     if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
         errno = EFBIG;
-        goto err0;
+        return (-1);
     }
-    if (((N & (N - 1)) != 0) || (N == 0)) {
+    if (((N & (N - 1)) != 0) || (N < 2)) {
         errno = EINVAL;
-        goto err0;
+        return (-1);
+    }
+    if ((r == 0) || (p == 0)) {
+        errno = EINVAL;
+        return (-1);
     }
     if ((r > SIZE_MAX / 128 / p) ||
 #if SIZE_MAX / 256 <= UINT32_MAX
-        (r > SIZE_MAX / 256) ||
+        (r > (SIZE_MAX - 64) / 256) ||
 #endif
         (N > SIZE_MAX / 128 / r)) {
         errno = ENOMEM;
-        goto err0;
+        return (-1);
     }
 
+    return (0);
+}
+
+int crypto_scrypt_smix(uint8_t* B, uint32_t r, uint64_t N, uint32_t first,
+    uint32_t last)
+{
+    uint32_t* V;
+    uint32_t* XY;
+    uint32_t i;
+
+    /* Allocate memory. */
+    if ((XY = malloc(256 * r + 64)) == NULL)
+        return (-1);
+    if ((V = malloc(128 * r * (size_t)N)) == NULL) {
+        free(XY);
+        return (-1);
+    }
+
+    /* 2: for i = 0 to p - 1 do */
+    for (i = first; i < last; i++) {
+        /* 3: B_i <-- MF(B_i, N) */
+        smix(&B[i * 128 * r], r, N, V, XY);
+    }
+
+    /* Free memory. */
+    free(V);
+    free(XY);
+    return (0);
+}
+
+/**
+ * crypto_scrypt(passwd, passwdlen, salt, saltlen, N, r, p, buf, buflen):
+ * Compute scrypt(passwd[0 .. passwdlen - 1], salt[0 .. saltlen - 1], N, r,
+ * p, buflen) and write the result into buf.  The parameters r, p, and buflen
+ * must satisfy r * p < 2^30 and buflen <= (2^32 - 1) * 32.  The parameter N
+ * must be a power of 2.
+ *
+ * Return 0 on success; or -1 on error.
+ */
+int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
+    const uint8_t* salt, size_t salt_length, uint64_t N,
+    uint32_t r, uint32_t p, uint8_t* buf, size_t buf_length)
+{
+    uint8_t* B;
+
+    /* Sanity-check parameters. */
+    if (crypto_scrypt_check(N, r, p, buf_length) != 0)
+        goto err0;
+
     /* Allocate memory. */
     if ((B = malloc(128 * r * p)) == NULL)
         goto err0;
-    if ((XY = malloc(256 * r)) == NULL)
-        goto err1;
-    if ((V = malloc(128 * r * (size_t)N)) == NULL)
-        goto err2;
 
     /* 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen) */
     pbkdf2_sha256(passphrase, passphrase_length,
         salt, salt_length, 1, B, p * 128 * r);
 
     /* 2: for i = 0 to p - 1 do */
-    for (i = 0; i < p; i++) {
-        /* 3: B_i <-- MF(B_i, N) */
-        smix(&B[i * 128 * r], r, N, V, XY);
-    }
+    /* 3: B_i <-- MF(B_i, N) */
+    if (crypto_scrypt_smix(B, r, N, 0, p) != 0)
+        goto err1;
 
     /* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
     pbkdf2_sha256(passphrase, passphrase_length,
         B, p * 128 * r, 1, buf, buf_length);
 
     /* Free memory. */
-    free(V);
-    free(XY);
     free(B);
 
     /* Success! */
     return (0);
 
-  err2:
-    free(XY);
   err1:
     free(B);
   err0:
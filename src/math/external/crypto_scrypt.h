@@ -50,6 +50,27 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint64_t N, uint32_t r,
     uint32_t p, uint8_t* buf, size_t buf_length);
 
+/**
+ * crypto_scrypt_check(N, r, p, buflen):
+ * Verify the parameters of crypto_scrypt, setting errno if invalid.
+ *
+ * Return 0 on success; or -1 on error.
+ */
+int crypto_scrypt_check(uint64_t N, uint32_t r, uint32_t p,
+    size_t buf_length);
+
+/**
+ * crypto_scrypt_smix(B, r, N, first, last):
+ * Compute B_i = MF(B_i, N) for first <= i < last, where B is the p * 128r
+ * byte output of the initial PBKDF2 of scrypt.  The lanes are independent,
+ * so disjoint ranges may be computed concurrently.  Each call allocates
+ * 128rN + 256r + 64 bytes of temporary storage.
+ *
+ * Return 0 on success; or -1 on error.
+ */
+int crypto_scrypt_smix(uint8_t* B, uint32_t r, uint64_t N, uint32_t first,
+    uint32_t last);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,366 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "hash160x4.h"
+
+#include <string.h>
+#include "sha256.h"
+#include "zeroize.h"
+
+#define LANES HASH160X4_LANES
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/* Message layout of a lane, with the padded tail held in its own buffer. */
+typedef struct LANE
+{
+    const uint8_t* input;
+    size_t full;
+    size_t blocks;
+    uint8_t tail[2 * SHA256_BLOCK_LENGTH];
+} LANE;
+
+static const uint32_t K256[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t SHA256_INITIAL[SHA256_STATE_LENGTH] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t RMD160_INITIAL[RMD160_STATE_LENGTH] =
+{
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+/* Message word selection and rotation of the left and right lines. */
+static const uint8_t RL[80] =
+{
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+     7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+     3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+     1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+     4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13
+};
+
+static const uint8_t RR[80] =
+{
+     5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+     6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+    15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+     8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+    12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11
+};
+
+static const uint8_t SL[80] =
+{
+    11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+     7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+    11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+    11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+     9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6
+};
+
+static const uint8_t SR[80] =
+{
+     8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+     9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+     9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+    15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+     8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11
+};
+
+static const uint32_t KL[5] =
+{
+    0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e
+};
+
+static const uint32_t KR[5] =
+{
+    0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000
+};
+
+#define RMD_F(x, y, z) ((x) ^ (y) ^ (z))
+#define RMD_G(x, y, z) (((x) & (y)) | (~(x) & (z)))
+#define RMD_H(x, y, z) (((x) | ~(y)) ^ (z))
+#define RMD_I(x, y, z) (((x) & (z)) | ((y) & ~(z)))
+#define RMD_J(x, y, z) ((x) ^ ((y) | ~(z)))
+
+/* Sixteen steps of the left (FL) and right (FR) lines, for every lane. */
+#define RMD_GROUP(group, FL, FR) \
+    for (i = 16 * (group); i < 16 * ((group) + 1); i++) \
+    { \
+        for (lane = 0; lane < LANES; lane++) \
+        { \
+            t = ROTL(al[lane] + FL(bl[lane], cl[lane], dl[lane]) + \
+                X[RL[i]][lane] + KL[group], SL[i]) + el[lane]; \
+            al[lane] = el[lane]; \
+            el[lane] = dl[lane]; \
+            dl[lane] = ROTL(cl[lane], 10); \
+            cl[lane] = bl[lane]; \
+            bl[lane] = t; \
+            t = ROTL(ar[lane] + FR(br[lane], cr[lane], dr[lane]) + \
+                X[RR[i]][lane] + KR[group], SR[i]) + er[lane]; \
+            ar[lane] = er[lane]; \
+            er[lane] = dr[lane]; \
+            dr[lane] = ROTL(cr[lane], 10); \
+            cr[lane] = br[lane]; \
+            br[lane] = t; \
+        } \
+    }
+
+static uint32_t load_be(const uint8_t* bytes)
+{
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+        ((uint32_t)bytes[2] << 8) | ((uint32_t)bytes[3]);
+}
+
+static void store_le(uint8_t* bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)(value);
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t byte_swap(uint32_t value)
+{
+    return (value >> 24) | ((value >> 8) & 0x0000ff00) |
+        ((value << 8) & 0x00ff0000) | (value << 24);
+}
+
+static void lane_init(LANE* lane, const uint8_t* input, size_t length)
+{
+    const size_t remainder = length % SHA256_BLOCK_LENGTH;
+    const size_t tail_blocks = (remainder + 9 <= SHA256_BLOCK_LENGTH) ? 1 : 2;
+    const size_t tail_length = tail_blocks * SHA256_BLOCK_LENGTH;
+    const uint64_t bits = (uint64_t)length << 3;
+    size_t byte;
+
+    lane->input = input;
+    lane->full = length / SHA256_BLOCK_LENGTH;
+    lane->blocks = lane->full + tail_blocks;
+
+    memset(lane->tail, 0, sizeof lane->tail);
+
+    if (remainder != 0)
+        memcpy(lane->tail, input + length - remainder, remainder);
+
+    lane->tail[remainder] = 0x80;
+
+    for (byte = 0; byte < 8; byte++)
+        lane->tail[tail_length - 1 - byte] = (uint8_t)(bits >> (8 * byte));
+}
+
+static const uint8_t* lane_block(const LANE* lane, size_t block)
+{
+    if (block < lane->full)
+        return lane->input + block * SHA256_BLOCK_LENGTH;
+
+    /* A lane past its last block repeats it, the result is not used. */
+    if (block >= lane->blocks)
+        block = lane->blocks - 1;
+
+    return lane->tail + (block - lane->full) * SHA256_BLOCK_LENGTH;
+}
+
+static void sha256_transform4(uint32_t state[SHA256_STATE_LENGTH][LANES],
+    const uint8_t* block[LANES])
+{
+    size_t i, lane;
+    uint32_t W[64][LANES];
+    uint32_t a[LANES], b[LANES], c[LANES], d[LANES];
+    uint32_t e[LANES], f[LANES], g[LANES], h[LANES];
+    uint32_t s0, s1, t1, t2;
+
+    for (i = 0; i < 16; i++)
+        for (lane = 0; lane < LANES; lane++)
+            W[i][lane] = load_be(block[lane] + 4 * i);
+
+    for (i = 16; i < 64; i++)
+    {
+        for (lane = 0; lane < LANES; lane++)
+        {
+            s0 = ROTR(W[i - 15][lane], 7) ^ ROTR(W[i - 15][lane], 18) ^
+                (W[i - 15][lane] >> 3);
+            s1 = ROTR(W[i - 2][lane], 17) ^ ROTR(W[i - 2][lane], 19) ^
+                (W[i - 2][lane] >> 10);
+            W[i][lane] = W[i - 16][lane] + s0 + W[i - 7][lane] + s1;
+        }
+    }
+
+    for (lane = 0; lane < LANES; lane++)
+    {
+        a[lane] = state[0][lane];
+        b[lane] = state[1][lane];
+        c[lane] = state[2][lane];
+        d[lane] = state[3][lane];
+        e[lane] = state[4][lane];
+        f[lane] = state[5][lane];
+        g[lane] = state[6][lane];
+        h[lane] = state[7][lane];
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        for (lane = 0; lane < LANES; lane++)
+        {
+            t1 = h[lane] + (ROTR(e[lane], 6) ^ ROTR(e[lane], 11) ^
+                ROTR(e[lane], 25)) + ((e[lane] & f[lane]) ^
+                (~e[lane] & g[lane])) + K256[i] + W[i][lane];
+            t2 = (ROTR(a[lane], 2) ^ ROTR(a[lane], 13) ^
+                ROTR(a[lane], 22)) + ((a[lane] & b[lane]) ^
+                (a[lane] & c[lane]) ^ (b[lane] & c[lane]));
+            h[lane] = g[lane];
+            g[lane] = f[lane];
+            f[lane] = e[lane];
+            e[lane] = d[lane] + t1;
+            d[lane] = c[lane];
+            c[lane] = b[lane];
+            b[lane] = a[lane];
+            a[lane] = t1 + t2;
+        }
+    }
+
+    for (lane = 0; lane < LANES; lane++)
+    {
+        state[0][lane] += a[lane];
+        state[1][lane] += b[lane];
+        state[2][lane] += c[lane];
+        state[3][lane] += d[lane];
+        state[4][lane] += e[lane];
+        state[5][lane] += f[lane];
+        state[6][lane] += g[lane];
+        state[7][lane] += h[lane];
+    }
+
+    zeroize((void*)W, sizeof W);
+}
+
+static void ripemd160_transform4(uint32_t state[RMD160_STATE_LENGTH][LANES],
+    const uint32_t X[RMD160_CHUNK_LENGTH][LANES])
+{
+    size_t i, lane;
+    uint32_t al[LANES], bl[LANES], cl[LANES], dl[LANES], el[LANES];
+    uint32_t ar[LANES], br[LANES], cr[LANES], dr[LANES], er[LANES];
+    uint32_t t;
+
+    for (lane = 0; lane < LANES; lane++)
+    {
+        al[lane] = ar[lane] = state[0][lane];
+        bl[lane] = br[lane] = state[1][lane];
+        cl[lane] = cr[lane] = state[2][lane];
+        dl[lane] = dr[lane] = state[3][lane];
+        el[lane] = er[lane] = state[4][lane];
+    }
+
+    RMD_GROUP(0, RMD_F, RMD_J)
+    RMD_GROUP(1, RMD_G, RMD_I)
+    RMD_GROUP(2, RMD_H, RMD_H)
+    RMD_GROUP(3, RMD_I, RMD_G)
+    RMD_GROUP(4, RMD_J, RMD_F)
+
+    for (lane = 0; lane < LANES; lane++)
+    {
+        t = state[1][lane] + cl[lane] + dr[lane];
+        state[1][lane] = state[2][lane] + dl[lane] + er[lane];
+        state[2][lane] = state[3][lane] + el[lane] + ar[lane];
+        state[3][lane] = state[4][lane] + al[lane] + br[lane];
+        state[4][lane] = state[0][lane] + bl[lane] + cr[lane];
+        state[0][lane] = t;
+    }
+}
+
+void HASH160x4(const uint8_t* input[HASH160X4_LANES],
+    const size_t length[HASH160X4_LANES],
+    uint8_t digest[HASH160X4_LANES][RMD160_DIGEST_LENGTH])
+{
+    size_t i, lane, block, blocks = 0;
+    LANE lanes[LANES];
+    const uint8_t* current[LANES];
+    uint32_t state[SHA256_STATE_LENGTH][LANES];
+    uint32_t hash[SHA256_STATE_LENGTH][LANES];
+    uint32_t X[RMD160_CHUNK_LENGTH][LANES];
+    uint32_t rmd[RMD160_STATE_LENGTH][LANES];
+
+    for (lane = 0; lane < LANES; lane++)
+    {
+        lane_init(&lanes[lane], input[lane], length[lane]);
+
+        if (lanes[lane].blocks > blocks)
+            blocks = lanes[lane].blocks;
+
+        for (i = 0; i < SHA256_STATE_LENGTH; i++)
+            state[i][lane] = SHA256_INITIAL[i];
+    }
+
+    for (block = 0; block < blocks; block++)
+    {
+        for (lane = 0; lane < LANES; lane++)
+            current[lane] = lane_block(&lanes[lane], block);
+
+        sha256_transform4(state, current);
+
+        /* Capture the digest of each lane when its last block is done. */
+        for (lane = 0; lane < LANES; lane++)
+            if (block + 1 == lanes[lane].blocks)
+                for (i = 0; i < SHA256_STATE_LENGTH; i++)
+                    hash[i][lane] = state[i][lane];
+    }
+
+    /* The SHA256 digest is a single padded RIPEMD160 block (256 bits). */
+    for (lane = 0; lane < LANES; lane++)
+    {
+        for (i = 0; i < SHA256_STATE_LENGTH; i++)
+            X[i][lane] = byte_swap(hash[i][lane]);
+
+        for (i = SHA256_STATE_LENGTH; i < RMD160_CHUNK_LENGTH; i++)
+            X[i][lane] = 0;
+
+        X[8][lane] = 0x00000080;
+        X[14][lane] = 256;
+
+        for (i = 0; i < RMD160_STATE_LENGTH; i++)
+            rmd[i][lane] = RMD160_INITIAL[i];
+    }
+
+    ripemd160_transform4(rmd, (const uint32_t(*)[LANES])X);
+
+    for (lane = 0; lane < LANES; lane++)
+        for (i = 0; i < RMD160_STATE_LENGTH; i++)
+            store_le(digest[lane] + 4 * i, rmd[i][lane]);
+}
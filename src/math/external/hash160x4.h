@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_HASH160X4_H
+#define LIBBITCOIN_HASH160X4_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ripemd160.h"
+
+#define HASH160X4_LANES 4U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Compute RIPEMD160(SHA256(input)) of four independent inputs at once.
+ * Each round is applied to all lanes in turn, with the lane state held in
+ * adjacent words, so that the compiler can vectorize the lanes (SSE2 or
+ * NEON). Inputs may differ in length, but lanes that finish early are
+ * carried (unused) until the longest input is hashed.
+ */
+void HASH160x4(const uint8_t* input[HASH160X4_LANES],
+    const size_t length[HASH160X4_LANES],
+    uint8_t digest[HASH160X4_LANES][RMD160_DIGEST_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
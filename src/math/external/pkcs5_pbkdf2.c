@@ -33,6 +33,7 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
     uint8_t digest1[HMACSHA512_DIGEST_LENGTH];
     uint8_t digest2[HMACSHA512_DIGEST_LENGTH];
+    HMACSHA512CTX keyed, context;
 
     /* An iteration count of 0 is equivalent to a count of 1. */
     /* A key_length of 0 is a no-op. */
@@ -45,6 +46,9 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     if (asalt == NULL)
         return -1;
 
+    /* The keyed (padded) state is the same for every hmac, so compute once. */
+    HMACSHA512Init(&keyed, passphrase, passphrase_length);
+
     memcpy(asalt, salt, salt_length);
     for (count = 1; key_length > 0; count++)
     {
@@ -52,13 +56,16 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
         asalt[salt_length + 1] = (count >> 16) & 0xff;
         asalt[salt_length + 2] = (count >> 8) & 0xff;
         asalt[salt_length + 3] = (count >> 0) & 0xff;
-        HMACSHA512(asalt, asalt_size, passphrase, passphrase_length, digest1);
+        context = keyed;
+        HMACSHA512Update(&context, asalt, asalt_size);
+        HMACSHA512Final(&context, digest1);
         memcpy(buffer, digest1, sizeof(buffer));
 
         for (iteration = 1; iteration < iterations; iteration++)
         {
-            HMACSHA512(digest1, sizeof(digest1), passphrase, passphrase_length,
-                digest2);
+            context = keyed;
+            HMACSHA512Update(&context, digest1, sizeof(digest1));
+            HMACSHA512Final(&context, digest2);
             memcpy(digest1, digest2, sizeof(digest1));
             for (index = 0; index < sizeof(buffer); index++)
                 buffer[index] ^= digest1[index];
@@ -73,6 +80,8 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     zeroize(digest1, sizeof(digest1));
     zeroize(digest2, sizeof(digest2));
     zeroize(buffer, sizeof(buffer));
+    zeroize(&keyed, sizeof(keyed));
+    zeroize(&context, sizeof(context));
     zeroize(asalt, asalt_size);
     free(asalt);
 
@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/golomb_coded_set.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+static const uint8_t max_bits = 32;
+static const size_t byte_size = 8;
+static const size_t buffer_size = 64;
+
+// Bit streams (most significant bit first).
+//-----------------------------------------------------------------------------
+
+class bit_writer
+{
+public:
+    bit_writer(data_chunk& sink)
+      : sink_(sink), offset_(0)
+    {
+    }
+
+    // Write the low bits of the value (up to 64), high bit first.
+    void write(uint64_t value, size_t bits)
+    {
+        while (bits != 0)
+        {
+            if (offset_ == 0)
+                sink_.push_back(0x00);
+
+            const auto take = std::min(bits, byte_size - offset_);
+            const auto mask = (1u << take) - 1;
+            const auto part = static_cast<uint8_t>(
+                (value >> (bits - take)) & mask);
+
+            sink_.back() |= part << (byte_size - offset_ - take);
+            offset_ = (offset_ + take) % byte_size;
+            bits -= take;
+        }
+    }
+
+    // Write the value in unary, as that many one bits and a zero bit.
+    void write_unary(uint64_t value)
+    {
+        for (; value >= byte_size; value -= byte_size)
+            write(0xff, byte_size);
+
+        write(((uint64_t(1) << value) - 1) << 1, value + 1);
+    }
+
+private:
+    data_chunk& sink_;
+    size_t offset_;
+};
+
+class bit_reader
+{
+public:
+    bit_reader(data_slice source)
+      : it_(source.begin()), end_(source.end()), buffer_(0), available_(0)
+    {
+    }
+
+    // Read bits (up to 32), high bit first, false if exhausted.
+    bool read(uint64_t& out, size_t bits)
+    {
+        if (available_ < bits)
+        {
+            fill();
+
+            if (available_ < bits)
+                return false;
+        }
+
+        out = bits == 0 ? 0 : buffer_ >> (buffer_size - bits);
+        consume(bits);
+        return true;
+    }
+
+    // Read a unary value (one bits terminated by a zero bit).
+    bool read_unary(uint64_t& out)
+    {
+        out = 0;
+
+        while (true)
+        {
+            if (available_ == 0)
+            {
+                fill();
+
+                if (available_ == 0)
+                    return false;
+            }
+
+            // Bits beyond those available are zero, so ones stops short.
+            const auto ones = leading_ones(buffer_);
+
+            if (ones < available_)
+            {
+                out += ones;
+                consume(ones + 1);
+                return true;
+            }
+
+            out += available_;
+            consume(available_);
+        }
+    }
+
+private:
+    static size_t leading_ones(uint64_t value)
+    {
+#if defined(__GNUC__)
+        return ~value == 0 ? buffer_size : __builtin_clzll(~value);
+#else
+        size_t ones = 0;
+        for (; ones < buffer_size && (value & (uint64_t(1) << 63)) != 0;
+            value <<= 1)
+            ++ones;
+
+        return ones;
+#endif
+    }
+
+    // Append whole bytes to the buffer, below the available bits.
+    void fill()
+    {
+        for (; available_ <= buffer_size - byte_size && it_ != end_; ++it_)
+        {
+            buffer_ |= uint64_t(*it_) << (buffer_size - byte_size - available_);
+            available_ += byte_size;
+        }
+    }
+
+    void consume(size_t bits)
+    {
+        buffer_ = bits == buffer_size ? 0 : buffer_ << bits;
+        available_ -= bits;
+    }
+
+    const uint8_t* it_;
+    const uint8_t* end_;
+    uint64_t buffer_;
+    size_t available_;
+};
+
+// Hashing to range.
+//-----------------------------------------------------------------------------
+
+// The high 64 bits of the 128 bit product.
+static inline uint64_t multiply_high(uint64_t left, uint64_t right)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(left) * right) >> 64);
+#else
+    const uint64_t left_low = left & 0xffffffff;
+    const uint64_t left_high = left >> 32;
+    const uint64_t right_low = right & 0xffffffff;
+    const uint64_t right_high = right >> 32;
+    const auto low = left_low * right_low;
+    const auto middle_1 = left_high * right_low + (low >> 32);
+    const auto middle_2 = left_low * right_high + (middle_1 & 0xffffffff);
+    return left_high * right_high + (middle_1 >> 32) + (middle_2 >> 32);
+#endif
+}
+
+// Hash each item uniformly to [0, range) and sort the values.
+static std::vector<uint64_t> hash_to_range(const data_stack& items,
+    uint64_t range, const siphash_key& key)
+{
+    std::vector<uint64_t> values;
+    values.reserve(items.size());
+
+    for (const auto& item: items)
+        values.push_back(multiply_high(siphash(key, item), range));
+
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// Golomb-coded sets.
+//-----------------------------------------------------------------------------
+
+data_chunk golomb_construct(const data_stack& items, uint8_t bits,
+    uint64_t rate, const siphash_key& key)
+{
+    data_chunk set;
+
+    if (bits == 0 || bits > max_bits || items.empty())
+        return set;
+
+    const auto values = hash_to_range(items, items.size() * rate, key);
+
+    // Each value takes about bits + 2 bits (the expected quotient is one).
+    set.reserve((values.size() * (bits + 2) + byte_size - 1) / byte_size);
+    bit_writer sink(set);
+    uint64_t previous = 0;
+
+    for (const auto value: values)
+    {
+        const auto delta = value - previous;
+        sink.write_unary(delta >> bits);
+        sink.write(delta, bits);
+        previous = value;
+    }
+
+    return set;
+}
+
+bool golomb_match(data_slice set, uint64_t count, data_slice target,
+    uint8_t bits, uint64_t rate, const siphash_key& key)
+{
+    return golomb_match(set, count, data_stack{ to_chunk(target) }, bits,
+        rate, key);
+}
+
+bool golomb_match(data_slice set, uint64_t count, const data_stack& targets,
+    uint8_t bits, uint64_t rate, const siphash_key& key)
+{
+    if (bits == 0 || bits > max_bits || count == 0 || targets.empty())
+        return false;
+
+    const auto values = hash_to_range(targets, count * rate, key);
+    auto target = values.begin();
+    bit_reader source(set);
+    uint64_t value = 0;
+
+    // Merge the sorted targets with the sorted set as it is decoded.
+    for (uint64_t index = 0; index < count; ++index)
+    {
+        uint64_t quotient;
+        uint64_t remainder;
+
+        if (!source.read_unary(quotient) || !source.read(remainder, bits))
+            return false;
+
+        value += (quotient << bits) + remainder;
+
+        for (; *target < value; ++target)
+            if (std::next(target) == values.end())
+                return false;
+
+        if (*target == value)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace libbitcoin
@@ -19,14 +19,20 @@
 #include <bitcoin/bitcoin/math/hash.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <errno.h>
 #include <new>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include "../math/external/crypto_scrypt.h"
+#include "../math/external/hash160x4.h"
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
+#include "../math/external/pbkdf2_sha256.h"
 #include "../math/external/pkcs5_pbkdf2.h"
 #include "../math/external/ripemd160.h"
 #include "../math/external/sha1.h"
@@ -40,11 +46,127 @@ hash_digest bitcoin_hash(data_slice data)
     return sha256_hash(sha256_hash(data));
 }
 
+hash_digest bitcoin_hash(const std::vector<data_slice>& slices)
+{
+    hash_digest hash;
+    SHA256CTX context;
+    SHA256Init(&context);
+
+    for (const auto& slice: slices)
+        SHA256Update(&context, slice.data(), slice.size());
+
+    SHA256Final(&context, hash.data());
+    return sha256_hash(hash);
+}
+
+// The sha256 padding of 80 and 32 byte messages (0x80, zeros, bit length).
+static const byte_array<SHA256_BLOCK_LENGTH - 16> pad80
+{
+    {
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x80
+    }
+};
+
+static const byte_array<SHA256_BLOCK_LENGTH - hash_size> pad32
+{
+    {
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00
+    }
+};
+
+// Write the sha256 state (big endian words) to the buffer.
+static void encode_state(const uint32_t* state, uint8_t* buffer)
+{
+    for (size_t word = 0; word < SHA256_STATE_LENGTH; ++word)
+    {
+        buffer[4 * word + 0] = static_cast<uint8_t>(state[word] >> 24);
+        buffer[4 * word + 1] = static_cast<uint8_t>(state[word] >> 16);
+        buffer[4 * word + 2] = static_cast<uint8_t>(state[word] >> 8);
+        buffer[4 * word + 3] = static_cast<uint8_t>(state[word]);
+    }
+}
+
+hash_digest bitcoin_hash(const byte_array<80>& message)
+{
+    const auto tail = message.size() - SHA256_BLOCK_LENGTH;
+    byte_array<SHA256_BLOCK_LENGTH> block;
+    SHA256CTX context;
+
+    // First round, the 80 byte message in two blocks.
+    SHA256Init(&context);
+    SHA256Transform(context.state, message.data());
+    std::copy_n(message.begin() + SHA256_BLOCK_LENGTH, tail, block.begin());
+    std::copy(pad80.begin(), pad80.end(), block.begin() + tail);
+    SHA256Transform(context.state, block.data());
+
+    // Second round, the 32 byte digest in one block.
+    encode_state(context.state, block.data());
+    std::copy(pad32.begin(), pad32.end(), block.begin() + hash_size);
+    SHA256Init(&context);
+    SHA256Transform(context.state, block.data());
+
+    hash_digest hash;
+    encode_state(context.state, hash.data());
+    return hash;
+}
+
 short_hash bitcoin_short_hash(data_slice data)
 {
     return ripemd160_hash(sha256_hash(data));
 }
 
+short_hash_list bitcoin_short_hashes(const std::vector<data_slice>& data)
+{
+    const auto count = data.size();
+    short_hash_list out(count);
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), size_t(0));
+
+    // Lanes run to the longest input of their group, so group by length.
+    const auto shorter = [&](size_t left, size_t right)
+    {
+        return data[left].size() < data[right].size();
+    };
+
+    std::stable_sort(order.begin(), order.end(), shorter);
+
+    const uint8_t* input[HASH160X4_LANES];
+    size_t length[HASH160X4_LANES];
+    uint8_t digest[HASH160X4_LANES][RMD160_DIGEST_LENGTH];
+    size_t position = 0;
+
+    while (count - position > 1)
+    {
+        const auto group = std::min<size_t>(HASH160X4_LANES,
+            count - position);
+
+        // Unused lanes repeat the last input of the group.
+        for (size_t lane = 0; lane < HASH160X4_LANES; ++lane)
+        {
+            const auto& slice = data[order[position +
+                std::min<size_t>(lane, group - 1)]];
+            input[lane] = slice.data();
+            length[lane] = slice.size();
+        }
+
+        HASH160x4(input, length, digest);
+
+        for (size_t lane = 0; lane < group; ++lane)
+            std::copy_n(digest[lane], short_hash_size,
+                out[order[position + lane]].begin());
+
+        position += group;
+    }
+
+    if (position < count)
+        out[order[position]] = bitcoin_short_hash(data[order[position]]);
+
+    return out;
+}
+
 short_hash ripemd160_hash(data_slice data)
 {
     short_hash hash;
@@ -119,6 +241,24 @@ long_hash hmac_sha512_hash(data_slice data, data_slice key)
     return hash;
 }
 
+long_hash_list hmac_sha512_hash(const data_stack& data, data_slice key)
+{
+    HMACSHA512CTX keyed;
+    HMACSHA512Init(&keyed, key.data(), key.size());
+    long_hash_list hashes(data.size());
+
+    // Each hash resumes from a copy of the keyed state.
+    for (size_t index = 0; index < data.size(); ++index)
+    {
+        auto context = keyed;
+        const auto& chunk = data[index];
+        HMACSHA512Update(&context, chunk.data(), chunk.size());
+        HMACSHA512Final(&context, hashes[index].data());
+    }
+
+    return hashes;
+}
+
 long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations)
 {
@@ -150,13 +290,34 @@ static void handle_script_result(int result)
     }
 }
 
+// The p lanes of scrypt are independent, so they may be mixed concurrently.
+// This is the crypto_scrypt algorithm, with each thread allocating its own
+// 128 * r * N bytes of temporary storage.
 data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
-    uint32_t r, size_t length)
+    uint32_t r, size_t length, size_t threads)
 {
+    handle_script_result(crypto_scrypt_check(N, r, p, length));
+
+    data_chunk blocks(static_cast<size_t>(128) * r * p);
+    pbkdf2_sha256(data.data(), data.size(), salt.data(), salt.size(), 1,
+        blocks.data(), blocks.size());
+
+    std::atomic<bool> failed(false);
+    const auto mix = [&](size_t first, size_t last)
+    {
+        if (crypto_scrypt_smix(blocks.data(), r, N,
+            static_cast<uint32_t>(first), static_cast<uint32_t>(last)) != 0)
+            failed = true;
+    };
+
+    parallel_for(p, 1, mix, threads);
+
+    if (failed)
+        throw std::bad_alloc();
+
     data_chunk output(length);
-    const auto result = crypto_scrypt(data.data(), data.size(), salt.data(),
-        salt.size(), N, r, p, output.data(), output.size());
-    handle_script_result(result);
+    pbkdf2_sha256(data.data(), data.size(), blocks.data(), blocks.size(), 1,
+        output.data(), output.size());
     return output;
 }
 
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+static const uint32_t c1 = 0xcc9e2d51;
+static const uint32_t c2 = 0x1b873593;
+static const uint32_t m = 5;
+static const uint32_t n = 0xe6546b64;
+static const size_t block_size = sizeof(uint32_t);
+
+// The number of seeds processed in parallel by the multiple seed hash.
+static const size_t interleave = 8;
+
+static inline uint32_t rotate_left(uint32_t value, size_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+static inline uint32_t scramble(uint32_t block)
+{
+    return rotate_left(block * c1, 15) * c2;
+}
+
+static inline uint32_t mix(uint32_t hash, uint32_t block)
+{
+    return rotate_left(hash ^ scramble(block), 13) * m + n;
+}
+
+static inline uint32_t finalize(uint32_t hash, size_t size)
+{
+    hash ^= static_cast<uint32_t>(size);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// The tail holds the remaining (less than four) bytes, little endian.
+static inline uint32_t to_tail(data_slice data)
+{
+    const auto whole = data.size() - (data.size() % block_size);
+    uint32_t tail = 0;
+
+    for (auto byte = data.size(); byte > whole; --byte)
+        tail = (tail << 8) | data.data()[byte - 1];
+
+    return tail;
+}
+
+uint32_t murmur3(data_slice data, uint32_t seed)
+{
+    const auto size = data.size();
+    const auto blocks = size / block_size;
+    auto hash = seed;
+
+    for (size_t block = 0; block < blocks; ++block)
+        hash = mix(hash, from_little_endian_unsafe<uint32_t>(
+            data.begin() + block * block_size));
+
+    if (size % block_size != 0)
+        hash ^= scramble(to_tail(data));
+
+    return finalize(hash, size);
+}
+
+void murmur3(data_slice data, const uint32_t* seeds, uint32_t* hashes,
+    size_t count)
+{
+    const auto size = data.size();
+    const auto blocks = size / block_size;
+    const auto partial = (size % block_size != 0);
+    const auto tail = partial ? scramble(to_tail(data)) : 0;
+
+    // Independent lanes expose instruction level parallelism (and vectorize).
+    size_t seed = 0;
+    uint32_t lanes[interleave];
+
+    for (; seed + interleave <= count; seed += interleave)
+    {
+        for (size_t lane = 0; lane < interleave; ++lane)
+            lanes[lane] = seeds[seed + lane];
+
+        for (size_t block = 0; block < blocks; ++block)
+        {
+            const auto value = from_little_endian_unsafe<uint32_t>(
+                data.begin() + block * block_size);
+
+            for (size_t lane = 0; lane < interleave; ++lane)
+                lanes[lane] = mix(lanes[lane], value);
+        }
+
+        for (size_t lane = 0; lane < interleave; ++lane)
+            hashes[seed + lane] = finalize(lanes[lane] ^ tail, size);
+    }
+
+    for (; seed < count; ++seed)
+        hashes[seed] = murmur3(data, seeds[seed]);
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/siphash.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+// SipHash-2-4 (Aumasson and Bernstein), two compression and four finalization
+// rounds over 64 bit little endian message words.
+
+static const uint64_t initial_0 = 0x736f6d6570736575;
+static const uint64_t initial_1 = 0x646f72616e646f6d;
+static const uint64_t initial_2 = 0x6c7967656e657261;
+static const uint64_t initial_3 = 0x7465646279746573;
+static const uint64_t finalization = 0xff;
+static const size_t word_size = sizeof(uint64_t);
+static const size_t hash_words = hash_size / word_size;
+
+// The number of keys processed in parallel by the multiple key hash.
+static const size_t interleave = 4;
+
+struct sip_state
+{
+    uint64_t v0;
+    uint64_t v1;
+    uint64_t v2;
+    uint64_t v3;
+};
+
+static inline uint64_t rotate_left(uint64_t value, size_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline sip_state initialize(const siphash_key& key)
+{
+    return
+    {
+        key.first ^ initial_0,
+        key.second ^ initial_1,
+        key.first ^ initial_2,
+        key.second ^ initial_3
+    };
+}
+
+static inline void sip_round(sip_state& state)
+{
+    state.v0 += state.v1;
+    state.v1 = rotate_left(state.v1, 13);
+    state.v1 ^= state.v0;
+    state.v0 = rotate_left(state.v0, 32);
+    state.v2 += state.v3;
+    state.v3 = rotate_left(state.v3, 16);
+    state.v3 ^= state.v2;
+    state.v0 += state.v3;
+    state.v3 = rotate_left(state.v3, 21);
+    state.v3 ^= state.v0;
+    state.v2 += state.v1;
+    state.v1 = rotate_left(state.v1, 17);
+    state.v1 ^= state.v2;
+    state.v2 = rotate_left(state.v2, 32);
+}
+
+static inline void compress(sip_state& state, uint64_t word)
+{
+    state.v3 ^= word;
+    sip_round(state);
+    sip_round(state);
+    state.v0 ^= word;
+}
+
+static inline uint64_t finalize(sip_state& state)
+{
+    state.v2 ^= finalization;
+    sip_round(state);
+    sip_round(state);
+    sip_round(state);
+    sip_round(state);
+    return state.v0 ^ state.v1 ^ state.v2 ^ state.v3;
+}
+
+// The final word of a 32 byte message is its length in the high byte.
+static const uint64_t hash_final_word =
+    static_cast<uint64_t>(hash_size) << 56;
+
+static inline uint64_t hash_words_siphash(sip_state state,
+    const uint64_t (&words)[hash_words])
+{
+    for (size_t word = 0; word < hash_words; ++word)
+        compress(state, words[word]);
+
+    compress(state, hash_final_word);
+    return finalize(state);
+}
+
+static inline void to_words(uint64_t (&words)[hash_words],
+    const hash_digest& hash)
+{
+    for (size_t word = 0; word < hash_words; ++word)
+        words[word] = from_little_endian_unsafe<uint64_t>(
+            hash.begin() + word * word_size);
+}
+
+siphash_key to_siphash_key(const half_hash& value)
+{
+    const auto k0 = from_little_endian_unsafe<uint64_t>(value.begin());
+    const auto k1 = from_little_endian_unsafe<uint64_t>(value.begin() +
+        word_size);
+    return { k0, k1 };
+}
+
+uint64_t siphash(const siphash_key& key, data_slice message)
+{
+    auto state = initialize(key);
+    const auto size = message.size();
+    const auto whole = size - (size % word_size);
+    auto it = message.begin();
+
+    for (; it != message.begin() + whole; it += word_size)
+        compress(state, from_little_endian_unsafe<uint64_t>(it));
+
+    // The final word holds the remaining bytes and the low byte of the size.
+    auto last = static_cast<uint64_t>(size & 0xff) << 56;
+
+    for (size_t byte = 0; it != message.end(); ++it, ++byte)
+        last |= static_cast<uint64_t>(*it) << (8 * byte);
+
+    compress(state, last);
+    return finalize(state);
+}
+
+uint64_t siphash(const siphash_key& key, const hash_digest& hash)
+{
+    uint64_t words[hash_words];
+    to_words(words, hash);
+    return hash_words_siphash(initialize(key), words);
+}
+
+std::vector<uint64_t> siphash(const siphash_key& key, const hash_list& hashes)
+{
+    std::vector<uint64_t> out;
+    out.reserve(hashes.size());
+    const auto state = initialize(key);
+    uint64_t words[hash_words];
+
+    for (const auto& hash: hashes)
+    {
+        to_words(words, hash);
+        out.push_back(hash_words_siphash(state, words));
+    }
+
+    return out;
+}
+
+std::vector<uint64_t> siphash(const siphash_key_list& keys,
+    const hash_digest& hash)
+{
+    std::vector<uint64_t> out(keys.size());
+    uint64_t words[hash_words];
+    to_words(words, hash);
+
+    // Independent states expose instruction level parallelism.
+    size_t key = 0;
+    sip_state states[interleave];
+
+    for (; key + interleave <= keys.size(); key += interleave)
+    {
+        for (size_t lane = 0; lane < interleave; ++lane)
+            states[lane] = initialize(keys[key + lane]);
+
+        for (size_t word = 0; word < hash_words; ++word)
+            for (size_t lane = 0; lane < interleave; ++lane)
+                compress(states[lane], words[word]);
+
+        for (size_t lane = 0; lane < interleave; ++lane)
+        {
+            compress(states[lane], hash_final_word);
+            out[key + lane] = finalize(states[lane]);
+        }
+    }
+
+    for (; key < keys.size(); ++key)
+        out[key] = hash_words_siphash(initialize(keys[key]), words);
+
+    return out;
+}
+
+} // namespace libbitcoin
@@ -22,11 +22,14 @@
 #include <cstddef>
 #include <istream>
 #include <utility>
+#include <bitcoin/bitcoin/message/encoding.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -94,16 +97,19 @@ block::block(const chain::header& header,
 
 bool block::from_data(uint32_t, const data_chunk& data)
 {
+    set_encoding(nullptr);
     return chain::block::from_data(data);
 }
 
 bool block::from_data(uint32_t, std::istream& stream)
 {
+    set_encoding(nullptr);
     return chain::block::from_data(stream);
 }
 
 bool block::from_data(uint32_t, reader& source)
 {
+    set_encoding(nullptr);
     return chain::block::from_data(source);
 }
 
@@ -127,8 +133,41 @@ size_t block::serialized_size(uint32_t) const
     return chain::block::serialized_size();
 }
 
+encoding::const_ptr block::encode(uint32_t version, uint32_t magic) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    encoding_mutex_.lock_upgrade();
+
+    if (!encoding_ || encoding_->magic() != magic)
+    {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        encoding_mutex_.unlock_upgrade_and_lock();
+        encoding_ = message::encode(version, *this, magic);
+        encoding_mutex_.unlock_and_lock_upgrade();
+        //---------------------------------------------------------------------
+    }
+
+    const auto value = encoding_;
+    encoding_mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return value;
+}
+
+void block::set_encoding(encoding::const_ptr value)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(encoding_mutex_);
+
+    encoding_ = value;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 block& block::operator=(chain::block&& other)
 {
+    set_encoding(nullptr);
     reset();
     chain::block::operator=(std::move(other));
     return *this;
@@ -136,6 +175,7 @@ block& block::operator=(chain::block&& other)
 
 block& block::operator=(block&& other)
 {
+    set_encoding(nullptr);
     chain::block::operator=(std::move(other));
     return *this;
 }
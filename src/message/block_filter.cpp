@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/block_filter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/machine/opcode.hpp>
+#include <bitcoin/bitcoin/math/golomb_coded_set.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::machine;
+
+const uint8_t block_filter::basic_bits = 19;
+const uint64_t block_filter::basic_rate = 784931;
+
+hash_digest block_filter::to_header(const hash_digest& filter_hash,
+    const hash_digest& previous_header)
+{
+    return bitcoin_hash(build_chunk({ filter_hash, previous_header }));
+}
+
+hash_list block_filter::to_headers(const hash_list& filter_hashes,
+    const hash_digest& previous_header)
+{
+    hash_list headers;
+    headers.reserve(filter_hashes.size());
+    auto previous = previous_header;
+
+    for (const auto& filter_hash: filter_hashes)
+    {
+        previous = to_header(filter_hash, previous);
+        headers.push_back(previous);
+    }
+
+    return headers;
+}
+
+block_filter::block_filter()
+  : block_hash_(null_hash), data_(), size_(0), offset_(0), valid_(false)
+{
+}
+
+block_filter::block_filter(const hash_digest& block_hash,
+    const data_chunk& data)
+  : block_hash_(block_hash), data_(data), size_(0), offset_(0), valid_(false)
+{
+    parse();
+}
+
+block_filter::block_filter(const hash_digest& block_hash, data_chunk&& data)
+  : block_hash_(block_hash), data_(std::move(data)), size_(0), offset_(0),
+    valid_(false)
+{
+    parse();
+}
+
+block_filter::block_filter(const chain::block& block)
+  : block_hash_(block.hash()), data_(), size_(0), offset_(0), valid_(false)
+{
+    data_stack elements;
+    const auto& txs = block.transactions();
+
+    for (const auto& tx: txs)
+    {
+        for (const auto& output: tx.outputs())
+        {
+            auto script = output.script().to_data(false);
+
+            if (!script.empty() &&
+                script.front() != static_cast<uint8_t>(opcode::return_))
+                elements.push_back(std::move(script));
+        }
+
+        if (tx.is_coinbase())
+            continue;
+
+        for (const auto& input: tx.inputs())
+        {
+            const auto& prevout = input.previous_output().validation.cache;
+
+            if (!prevout.is_valid())
+                return;
+
+            auto script = prevout.script().to_data(false);
+
+            if (!script.empty())
+                elements.push_back(std::move(script));
+        }
+    }
+
+    // The filter is of the set of distinct elements.
+    std::sort(elements.begin(), elements.end());
+    elements.erase(std::unique(elements.begin(), elements.end()),
+        elements.end());
+
+    size_ = elements.size();
+    offset_ = variable_uint_size(size_);
+    const auto set = golomb_construct(elements, basic_bits, basic_rate,
+        key());
+
+    data_.resize(offset_ + set.size());
+    auto sink = make_unsafe_serializer(data_.begin());
+    sink.write_variable_little_endian(size_);
+    sink.write_bytes(set);
+    valid_ = true;
+}
+
+void block_filter::parse()
+{
+    auto source = make_safe_deserializer(data_.begin(), data_.end());
+    size_ = source.read_variable_little_endian();
+    valid_ = source;
+    offset_ = valid_ ? variable_uint_size(size_) : 0;
+
+    if (!valid_)
+        size_ = 0;
+}
+
+// The siphash key is the first 16 bytes of the block hash.
+siphash_key block_filter::key() const
+{
+    half_hash key;
+    std::copy_n(block_hash_.begin(), key.size(), key.begin());
+    return to_siphash_key(key);
+}
+
+bool block_filter::is_valid() const
+{
+    return valid_;
+}
+
+const hash_digest& block_filter::block_hash() const
+{
+    return block_hash_;
+}
+
+const data_chunk& block_filter::data() const
+{
+    return data_;
+}
+
+uint64_t block_filter::size() const
+{
+    return size_;
+}
+
+hash_digest block_filter::hash() const
+{
+    return bitcoin_hash(data_);
+}
+
+hash_digest block_filter::header(const hash_digest& previous_header) const
+{
+    return to_header(hash(), previous_header);
+}
+
+bool block_filter::match(data_slice element) const
+{
+    const data_slice set(data_.data() + offset_, data_.data() + data_.size());
+    return valid_ && golomb_match(set, size_, element, basic_bits,
+        basic_rate, key());
+}
+
+bool block_filter::match(const data_stack& elements) const
+{
+    const data_slice set(data_.data() + offset_, data_.data() + data_.size());
+    return valid_ && golomb_match(set, size_, elements, basic_bits,
+        basic_rate, key());
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/block_reconstructor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+block_reconstructor::block_reconstructor(const compact_block& block)
+  : header_(block.header()),
+    key_(block.short_id_key()),
+    missing_(0),
+    valid_(initialize(block))
+{
+}
+
+// Short ids are 48 bit little endian integers, the low bytes of a siphash.
+uint64_t block_reconstructor::to_key(const compact_block::short_id& id)
+{
+    uint64_t value = 0;
+
+    for (size_t byte = 0; byte < id.size(); ++byte)
+        value |= static_cast<uint64_t>(id[byte]) << (8 * byte);
+
+    return value;
+}
+
+bool block_reconstructor::initialize(const compact_block& block)
+{
+    const auto& short_ids = block.short_ids();
+    const auto& prefilled = block.transactions();
+    const auto count = short_ids.size() + prefilled.size();
+
+    // Guard against potential for arbitary memory allocation.
+    if (count == 0 || count > max_block_size)
+        return false;
+
+    transactions_.resize(count);
+    ambiguous_.resize(count, false);
+    slots_.reserve(short_ids.size());
+
+    // Prefilled indexes are differentially encoded and must be in range.
+    uint64_t index = 0;
+    auto first = true;
+
+    for (const auto& element: prefilled)
+    {
+        const auto offset = element.index();
+
+        if (offset >= count || (!first && index + offset + 1 >= count))
+            return false;
+
+        index = first ? offset : index + offset + 1;
+        first = false;
+        transactions_[index] = std::make_shared<const transaction>(
+            element.transaction());
+    }
+
+    // Short ids occupy the remaining slots in order and must be unique.
+    size_t slot = 0;
+
+    for (const auto& id: short_ids)
+    {
+        while (transactions_[slot])
+            ++slot;
+
+        if (!slots_.emplace(to_key(id), slot++).second)
+            return false;
+    }
+
+    missing_ = short_ids.size();
+    return true;
+}
+
+bool block_reconstructor::is_valid() const
+{
+    return valid_;
+}
+
+bool block_reconstructor::is_complete() const
+{
+    return valid_ && missing_ == 0;
+}
+
+size_t block_reconstructor::missing_count() const
+{
+    return missing_;
+}
+
+size_t block_reconstructor::fill(
+    const transaction::const_ptr_list& candidates)
+{
+    if (!valid_ || missing_ == 0)
+        return 0;
+
+    hash_list hashes;
+    hashes.reserve(candidates.size());
+
+    for (const auto& candidate: candidates)
+        hashes.push_back(candidate->hash());
+
+    static const uint64_t mask = 0x0000ffffffffffff;
+    const auto ids = siphash(key_, hashes);
+
+    // Slots filled by this call, as missing_ may also count slots emptied.
+    std::vector<size_t> filled;
+
+    for (size_t index = 0; index < ids.size(); ++index)
+    {
+        const auto it = slots_.find(ids[index] & mask);
+
+        if (it == slots_.end() || ambiguous_[it->second])
+            continue;
+
+        auto& slot = transactions_[it->second];
+
+        if (!slot)
+        {
+            slot = candidates[index];
+            filled.push_back(it->second);
+            --missing_;
+        }
+        else if (slot->hash() != hashes[index])
+        {
+            // Distinct candidates share the short id, so request the slot.
+            // The slot may have been filled by this or by a prior call.
+            const auto fill = std::find(filled.begin(), filled.end(),
+                it->second);
+
+            if (fill != filled.end())
+                filled.erase(fill);
+
+            slot.reset();
+            ambiguous_[it->second] = true;
+            ++missing_;
+        }
+    }
+
+    return filled.size();
+}
+
+get_block_transactions block_reconstructor::missing() const
+{
+    std::vector<uint64_t> indexes;
+
+    if (!valid_)
+        return{ header_.hash(), std::move(indexes) };
+
+    indexes.reserve(missing_);
+    size_t next = 0;
+
+    for (size_t index = 0; index < transactions_.size(); ++index)
+    {
+        if (!transactions_[index])
+        {
+            indexes.push_back(index - next);
+            next = index + 1;
+        }
+    }
+
+    return{ header_.hash(), std::move(indexes) };
+}
+
+bool block_reconstructor::fill(const block_transactions& response)
+{
+    const auto& transactions = response.transactions();
+
+    if (!valid_ || response.block_hash() != header_.hash() ||
+        transactions.size() != missing_)
+        return false;
+
+    auto it = transactions.begin();
+
+    for (auto& slot: transactions_)
+        if (!slot)
+            slot = std::make_shared<const transaction>(*it++);
+
+    missing_ = 0;
+    return true;
+}
+
+bool block_reconstructor::to_block(chain::block& out) const
+{
+    if (!is_complete())
+        return false;
+
+    chain::transaction::list transactions;
+    transactions.reserve(transactions_.size());
+
+    for (const auto& transaction: transactions_)
+        transactions.push_back(*transaction);
+
+    chain::block block(header_, std::move(transactions));
+
+    if (block.generate_merkle_root() != header_.merkle())
+        return false;
+
+    out = std::move(block);
+    return true;
+}
+
+} // namespace message
+} // namespace libbitcoin
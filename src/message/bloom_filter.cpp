@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/machine/script_pattern.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+#include <bitcoin/bitcoin/message/filter_add.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+using namespace bc::machine;
+
+// The hash function seed multiplier (BIP37).
+static const uint32_t seed_factor = 0xfba4c795;
+static const double ln2 = 0.6931471805599453094172321214581765680755;
+static const double ln2_squared = ln2 * ln2;
+static const size_t point_size = hash_size + sizeof(uint32_t);
+
+static std::vector<uint32_t> to_seeds(size_t hash_functions, uint32_t tweak)
+{
+    std::vector<uint32_t> seeds(hash_functions);
+
+    for (size_t index = 0; index < hash_functions; ++index)
+        seeds[index] = static_cast<uint32_t>(index) * seed_factor + tweak;
+
+    return seeds;
+}
+
+static byte_array<point_size> to_bytes(const point& outpoint)
+{
+    byte_array<point_size> out;
+    const auto& hash = outpoint.hash();
+    const auto index = to_little_endian(outpoint.index());
+    std::copy(hash.begin(), hash.end(), out.begin());
+    std::copy(index.begin(), index.end(), out.begin() + hash_size);
+    return out;
+}
+
+bloom_filter::bloom_filter()
+  : tweak_(0), flags_(update::none)
+{
+}
+
+// A function count beyond the protocol limit is not allocated, but leaves
+// the filter invalid, as the count is set by the peer.
+bloom_filter::bloom_filter(const filter_load& message)
+  : filter_(message.filter()),
+    seeds_(to_seeds(std::min(size_t(message.hash_functions()),
+        max_filter_functions + 1), message.tweak())),
+    tweak_(message.tweak()),
+    flags_(message.flags())
+{
+}
+
+// The filter size and function count are those of the reference client.
+bloom_filter::bloom_filter(size_t elements, double false_positive_rate,
+    uint32_t tweak, uint8_t flags)
+  : tweak_(tweak), flags_(flags)
+{
+    elements = std::max(elements, size_t(1));
+    const auto bits = static_cast<size_t>(-1.0 / ln2_squared * elements *
+        std::log(false_positive_rate));
+    filter_.resize(std::max(std::min(bits, max_filter_load * 8) / 8,
+        size_t(1)), 0);
+
+    const auto functions = static_cast<size_t>(filter_.size() * 8 / elements *
+        ln2);
+    seeds_ = to_seeds(std::max(std::min(functions, max_filter_functions),
+        size_t(1)), tweak_);
+}
+
+bool bloom_filter::is_valid() const
+{
+    return filter_.size() <= max_filter_load &&
+        seeds_.size() <= max_filter_functions;
+}
+
+const data_chunk& bloom_filter::data() const
+{
+    return filter_;
+}
+
+size_t bloom_filter::hash_functions() const
+{
+    return seeds_.size();
+}
+
+uint32_t bloom_filter::tweak() const
+{
+    return tweak_;
+}
+
+uint8_t bloom_filter::flags() const
+{
+    return flags_;
+}
+
+filter_load bloom_filter::to_filter_load() const
+{
+    return{ filter_, static_cast<uint32_t>(seeds_.size()), tweak_, flags_ };
+}
+
+bool bloom_filter::add(const filter_add& message)
+{
+    if (message.data().size() > max_filter_add)
+        return false;
+
+    insert(message.data());
+    return true;
+}
+
+// Obtain the bit index of each hash function for the element.
+void bloom_filter::hash(data_slice element, uint32_t* indexes) const
+{
+    const auto bits = filter_.size() * 8;
+    murmur3(element, seeds_.data(), indexes, seeds_.size());
+
+    for (size_t index = 0; index < seeds_.size(); ++index)
+        indexes[index] = static_cast<uint32_t>(indexes[index] % bits);
+}
+
+void bloom_filter::insert(data_slice element)
+{
+    if (filter_.empty() || !is_valid())
+        return;
+
+    uint32_t indexes[max_filter_functions];
+    hash(element, indexes);
+
+    for (size_t index = 0; index < seeds_.size(); ++index)
+        filter_[indexes[index] >> 3] |= (1 << (indexes[index] & 7));
+}
+
+void bloom_filter::insert(const point& point)
+{
+    insert(to_bytes(point));
+}
+
+bool bloom_filter::contains(data_slice element) const
+{
+    if (filter_.empty() || !is_valid())
+        return false;
+
+    uint32_t indexes[max_filter_functions];
+    hash(element, indexes);
+
+    for (size_t index = 0; index < seeds_.size(); ++index)
+        if ((filter_[indexes[index] >> 3] & (1 << (indexes[index] & 7))) == 0)
+            return false;
+
+    return true;
+}
+
+bool bloom_filter::contains(const point& point) const
+{
+    return contains(to_bytes(point));
+}
+
+bool bloom_filter::match(const transaction& tx)
+{
+    if (filter_.empty())
+        return false;
+
+    const auto tx_hash = tx.hash();
+    auto matched = contains(tx_hash);
+    const auto update = flags_ & update::mask;
+    const auto& outputs = tx.outputs();
+
+    // Outputs are matched (and updated) before inputs, in order to match
+    // spends of matching outputs within the same block.
+    for (uint32_t index = 0; index < outputs.size(); ++index)
+    {
+        const auto& script = outputs[index].script();
+
+        for (const auto& op: script.operations())
+        {
+            const auto& data = op.data();
+
+            if (data.empty() || !contains(data))
+                continue;
+
+            matched = true;
+
+            if (update == update::all)
+            {
+                insert(point{ tx_hash, index });
+            }
+            else if (update == update::p2pubkey_only)
+            {
+                const auto pattern = script.pattern();
+
+                if (pattern == script_pattern::pay_public_key ||
+                    pattern == script_pattern::pay_multisig)
+                    insert(point{ tx_hash, index });
+            }
+
+            break;
+        }
+    }
+
+    if (matched)
+        return true;
+
+    for (const auto& input: tx.inputs())
+    {
+        if (contains(input.previous_output()))
+            return true;
+
+        for (const auto& op: input.script().operations())
+        {
+            const auto& data = op.data();
+
+            if (!data.empty() && contains(data))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<bool> bloom_filter::match(const block& block)
+{
+    const auto& transactions = block.transactions();
+    std::vector<bool> matches;
+    matches.reserve(transactions.size());
+
+    for (const auto& tx: transactions)
+        matches.push_back(match(tx));
+
+    return matches;
+}
+
+} // namespace message
+} // namespace libbitcoin
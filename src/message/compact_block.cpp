@@ -18,12 +18,20 @@
  */
 #include <bitcoin/bitcoin/message/compact_block.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -94,6 +102,25 @@ compact_block::compact_block(compact_block&& other)
 {
 }
 
+compact_block::compact_block(const chain::block& block, uint64_t nonce)
+  : header_(block.header()),
+    nonce_(nonce)
+{
+    const auto& transactions = block.transactions();
+
+    if (transactions.empty())
+        return;
+
+    // The coinbase is prefilled at (differential) index zero.
+    transactions_.emplace_back(0, transactions.front());
+    short_ids_.reserve(transactions.size() - 1);
+    const auto key = short_id_key();
+
+    for (auto tx = std::next(transactions.begin()); tx != transactions.end();
+        ++tx)
+        short_ids_.push_back(to_short_id(key, tx->hash()));
+}
+
 bool compact_block::is_valid() const
 {
     return header_.is_valid() && !short_ids_.empty() && !transactions_.empty();
@@ -109,10 +136,35 @@ void compact_block::reset()
     transactions_.shrink_to_fit();
 }
 
+siphash_key compact_block::short_id_key() const
+{
+    // The key is the first 16 bytes of the single sha256 of header and nonce.
+    const auto digest = sha256_hash(build_chunk(
+    {
+        header_.to_data(),
+        to_little_endian(nonce_)
+    }));
+
+    half_hash key;
+    std::copy_n(digest.begin(), key.size(), key.begin());
+    return to_siphash_key(key);
+}
+
+compact_block::short_id compact_block::to_short_id(const siphash_key& key,
+    const hash_digest& hash)
+{
+    // The short id is the low six bytes of the siphash, little endian.
+    const auto value = to_little_endian(siphash(key, hash));
+
+    short_id out;
+    std::copy_n(value.begin(), out.size(), out.begin());
+    return out;
+}
+
 bool compact_block::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool compact_block::from_data(uint32_t version, std::istream& stream)
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/encoding.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+encoding::encoding(uint32_t version, uint32_t magic, data_chunk&& data)
+  : version_(version), magic_(magic), data_(std::move(data))
+{
+    BITCOIN_ASSERT(data_.size() >= heading::satoshi_fixed_size());
+}
+
+encoding::encoding(uint32_t version, const heading& head, data_slice payload)
+  : version_(version), magic_(head.magic()),
+    data_(build_chunk({ head.to_data(), payload }))
+{
+    BITCOIN_ASSERT(payload.size() == head.payload_size());
+}
+
+uint32_t encoding::version() const
+{
+    return version_;
+}
+
+uint32_t encoding::magic() const
+{
+    return magic_;
+}
+
+const data_chunk& encoding::data() const
+{
+    return data_;
+}
+
+data_slice encoding::payload() const
+{
+    const auto begin = data_.data() + heading::satoshi_fixed_size();
+    return data_slice(begin, data_.data() + data_.size());
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -20,7 +20,7 @@
 
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -89,8 +89,8 @@ fee_filter::fee_filter(fee_filter&& other)
 
 bool fee_filter::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool fee_filter::from_data(uint32_t version, std::istream& stream)
@@ -19,19 +19,29 @@
 #include <bitcoin/bitcoin/message/headers.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
+#include <memory>
 #include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/chain_state.hpp>
+#include <bitcoin/bitcoin/chain/compact.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -108,8 +118,8 @@ void headers::reset()
 
 bool headers::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool headers::from_data(uint32_t version, std::istream& stream)
@@ -188,6 +198,115 @@ bool headers::is_sequential() const
     return true;
 }
 
+// Validation.
+//-----------------------------------------------------------------------------
+
+// The minimum number of headers checked by each thread. Threads are created
+// for each check, so smaller messages are checked on the calling thread.
+static const size_t check_grain = 512;
+
+// Expand the bits to a little endian target, false if invalid or too easy.
+static bool to_target(uint32_t bits, hash_digest& out)
+{
+    static const uint256_t pow_limit(chain::compact{ proof_of_work_limit });
+    const auto compact = chain::compact(bits);
+
+    if (compact.is_overflowed())
+        return false;
+
+    uint256_t target(compact);
+
+    if (target < 1 || target > pow_limit)
+        return false;
+
+    for (auto& byte: out)
+    {
+        byte = static_cast<uint8_t>(target & 0xff);
+        target >>= byte_bits;
+    }
+
+    return true;
+}
+
+// Compare little endian values, most significant byte first.
+static bool is_within(const hash_digest& hash, const hash_digest& target)
+{
+    return !std::lexicographical_compare(target.rbegin(), target.rend(),
+        hash.rbegin(), hash.rend());
+}
+
+code headers::check() const
+{
+    using namespace std::chrono;
+    const auto count = elements_.size();
+    const auto now = system_clock::to_time_t(system_clock::now());
+    const auto future = static_cast<uint64_t>(now) + timestamp_future_seconds;
+    hash_list hashes(count);
+    std::vector<code> results(count, error::success);
+
+    // Each header of a range usually has the same bits, so the target is
+    // expanded only when the bits change.
+    const auto check_range = [&](size_t first, size_t last)
+    {
+        auto bits = elements_[first].bits();
+        hash_digest target;
+        auto valid = to_target(bits, target);
+
+        for (auto index = first; index < last; ++index)
+        {
+            const auto& header = elements_[index];
+            hashes[index] = header.hash();
+
+            if (header.bits() != bits)
+            {
+                bits = header.bits();
+                valid = to_target(bits, target);
+            }
+
+            if (!valid || !is_within(hashes[index], target))
+                results[index] = error::invalid_proof_of_work;
+            else if (header.timestamp() > future)
+                results[index] = error::futuristic_timestamp;
+        }
+    };
+
+    parallel_for(count, check_grain, check_range);
+
+    // Context free failures take precedence over linkage failures.
+    for (const auto& result: results)
+        if (result)
+            return result;
+
+    for (size_t index = 1; index < count; ++index)
+        if (elements_[index].previous_block_hash() != hashes[index - 1])
+            return error::invalid_previous_block;
+
+    return error::success;
+}
+
+code headers::accept(chain::chain_state::ptr parent) const
+{
+    if (!parent)
+        return error::operation_failed;
+
+    // Each state is promoted from the state of its parent.
+    for (const auto& header: elements_)
+    {
+        const auto state = std::make_shared<chain::chain_state>(*parent,
+            header);
+        const auto ec = header.accept(*state);
+
+        if (ec)
+            return ec;
+
+        header.validation.state = state;
+        header.validation.height = state->height();
+        parent = state;
+    }
+
+    return error::success;
+}
+
 void headers::to_hashes(hash_list& out) const
 {
     const auto map = [](const header& header)
@@ -18,14 +18,19 @@
  */
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -89,6 +94,129 @@ merkle_block::merkle_block(const chain::block& block)
 {
 }
 
+// Partial merkle tree (BIP37).
+//-----------------------------------------------------------------------------
+
+// The smallest possible serialized transaction, which bounds the leaf count.
+static constexpr size_t min_transaction_size = 60;
+
+// The number of nodes at the height (leaves at zero) of a tree of count leaves.
+static size_t tree_width(size_t count, size_t height)
+{
+    return (count + (size_t(1) << height) - 1) >> height;
+}
+
+static size_t tree_height(size_t count)
+{
+    size_t height = 0;
+    while (tree_width(count, height) > 1)
+        ++height;
+
+    return height;
+}
+
+// Hash a pair of nodes without allocation.
+static hash_digest hash_pair(const hash_digest& left, const hash_digest& right)
+{
+    byte_array<2 * hash_size> pair;
+    std::copy(left.begin(), left.end(), pair.begin());
+    std::copy(right.begin(), right.end(), pair.begin() + hash_size);
+    return bitcoin_hash(pair);
+}
+
+// Hash the level above, pairing the last node of an odd width level with
+// itself. Each level is hashed as a batch into a preallocated level.
+static void hash_level(const hash_list& level, hash_list& above)
+{
+    const auto width = (level.size() + 1) / 2;
+    above.resize(width);
+
+    for (size_t position = 0; position < width; ++position)
+    {
+        const auto& left = level[position * 2];
+        const auto right = position * 2 + 1;
+        above[position] = hash_pair(left, right < level.size() ?
+            level[right] : left);
+    }
+}
+
+// Mark each node of the level above that is the parent of a matched node.
+static void match_level(const std::vector<bool>& level,
+    std::vector<bool>& above)
+{
+    const auto width = (level.size() + 1) / 2;
+    above.assign(width, false);
+
+    for (size_t position = 0; position < level.size(); ++position)
+        if (level[position])
+            above[position / 2] = true;
+}
+
+merkle_block::merkle_block(const chain::block& block,
+    const std::vector<bool>& matches)
+  : header_(block.header()),
+    total_transactions_(block.transactions().size())
+{
+    const auto count = total_transactions_;
+
+    if (count == 0 || matches.size() != count)
+    {
+        reset();
+        return;
+    }
+
+    // Compute all node hashes and match flags bottom up, level by level.
+    const auto height = tree_height(count);
+    std::vector<hash_list> hashes(height + 1);
+    std::vector<std::vector<bool>> parents(height + 1);
+    hashes[0] = block.to_hashes();
+    parents[0] = matches;
+
+    for (size_t level = 0; level < height; ++level)
+    {
+        hash_level(hashes[level], hashes[level + 1]);
+        match_level(parents[level], parents[level + 1]);
+    }
+
+    // Traverse depth first (left to right), without recursion. A node that
+    // is not the parent of a match (or is a leaf) contributes its hash, and
+    // every visited node contributes its match flag.
+    std::vector<bool> bits;
+    std::vector<std::pair<size_t, size_t>> nodes{ { height, 0 } };
+    nodes.reserve(height + 2);
+
+    while (!nodes.empty())
+    {
+        const auto level = nodes.back().first;
+        const auto position = nodes.back().second;
+        nodes.pop_back();
+
+        const auto parent = parents[level][position];
+        bits.push_back(parent);
+
+        if (level == 0 || !parent)
+        {
+            hashes_.push_back(hashes[level][position]);
+            continue;
+        }
+
+        // Push the right child first so that the left is visited first.
+        const auto left = position * 2;
+
+        if (left + 1 < hashes[level - 1].size())
+            nodes.emplace_back(level - 1, left + 1);
+
+        nodes.emplace_back(level - 1, left);
+    }
+
+    // Flag bits are packed little endian within each byte.
+    flags_.resize((bits.size() + 7) / 8, 0);
+
+    for (size_t bit = 0; bit < bits.size(); ++bit)
+        if (bits[bit])
+            flags_[bit / 8] |= (1 << (bit % 8));
+}
+
 merkle_block::merkle_block(const merkle_block& other)
   : merkle_block(other.header_, other.total_transactions_, other.hashes_,
       other.flags_)
@@ -101,6 +229,123 @@ merkle_block::merkle_block(merkle_block&& other)
 {
 }
 
+// Extract the matched hashes from the partial merkle tree and verify that it
+// commits to the merkle root of the header. This is a single depth first pass
+// with an explicit stack (bounded by the tree height) instead of recursion.
+bool merkle_block::extract(hash_list& matches,
+    std::vector<size_t>& positions) const
+{
+    matches.clear();
+    positions.clear();
+
+    const auto fail = [&]()
+    {
+        matches.clear();
+        positions.clear();
+        return false;
+    };
+
+    const auto count = total_transactions_;
+    const auto bit_count = flags_.size() * 8;
+
+    // Guard against a tree larger than a block could hold, and against more
+    // hashes than leaves or flag bits.
+    if (count == 0 || count > max_block_size / min_transaction_size ||
+        hashes_.size() > count || hashes_.size() > bit_count)
+        return fail();
+
+    struct frame
+    {
+        size_t height;
+        size_t position;
+        bool right;
+        hash_digest left;
+    };
+
+    std::vector<frame> frames;
+    frames.reserve(tree_height(count) + 1);
+
+    size_t bit = 0;
+    size_t next = 0;
+    auto height = tree_height(count);
+    size_t position = 0;
+    auto enter = true;
+    hash_digest value;
+
+    while (true)
+    {
+        if (enter)
+        {
+            if (bit >= bit_count)
+                return fail();
+
+            const auto parent = ((flags_[bit / 8] >> (bit % 8)) & 1) != 0;
+            ++bit;
+
+            if (height != 0 && parent)
+            {
+                frames.push_back({ height, position, false, null_hash });
+                --height;
+                position *= 2;
+                continue;
+            }
+
+            if (next >= hashes_.size())
+                return fail();
+
+            value = hashes_[next++];
+
+            if (parent)
+            {
+                matches.push_back(value);
+                positions.push_back(position);
+            }
+
+            enter = false;
+        }
+
+        // Return the completed node hash (value) to its parent.
+        if (frames.empty())
+            break;
+
+        auto& node = frames.back();
+
+        if (!node.right)
+        {
+            node.left = value;
+            const auto right = node.position * 2 + 1;
+
+            if (right < tree_width(count, node.height - 1))
+            {
+                node.right = true;
+                height = node.height - 1;
+                position = right;
+                enter = true;
+                continue;
+            }
+
+            value = hash_pair(node.left, node.left);
+        }
+        else
+        {
+            // Identical siblings would allow a malleated tree (CVE-2012-2459).
+            if (value == node.left)
+                return fail();
+
+            value = hash_pair(node.left, value);
+        }
+
+        frames.pop_back();
+    }
+
+    // All hashes and all flag bytes (excluding padding) must be consumed.
+    if (next != hashes_.size() || (bit + 7) / 8 != flags_.size() ||
+        value != header_.merkle())
+        return fail();
+
+    return true;
+}
+
 bool merkle_block::is_valid() const
 {
     return !hashes_.empty() || !flags_.empty() || header_.is_valid();
@@ -118,8 +363,8 @@ void merkle_block::reset()
 
 bool merkle_block::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool merkle_block::from_data(uint32_t version, std::istream& stream)
@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/parser.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/block.hpp>
+#include <bitcoin/bitcoin/message/encoding.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/message/transaction.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+namespace message {
+
+static const auto empty_checksum = bitcoin_checksum(data_chunk{});
+
+// The first sha256 round of the payload checksum, updated as bytes arrive.
+struct parser::checksum_context
+{
+    SHA256CTX context;
+};
+
+// The heading payload size is not trusted, so the buffer grows as the payload
+// arrives beyond this initial reservation.
+static constexpr size_t maximum_reserve = 1024 * 1024;
+
+parser::parser(uint32_t magic, uint32_t version)
+  : magic_(magic),
+    version_(version),
+    retain_encoding_(false),
+    error_(error::success),
+    heading_filled_(0),
+    loader_(nullptr),
+    payload_remaining_(0),
+    checksum_(new checksum_context)
+{
+    BITCOIN_ASSERT(heading_buffer_.size() == heading::satoshi_fixed_size());
+}
+
+parser::~parser()
+{
+}
+
+uint32_t parser::version() const
+{
+    return version_;
+}
+
+void parser::set_version(uint32_t version)
+{
+    version_ = version;
+}
+
+size_t parser::buffered() const
+{
+    return payload_.size();
+}
+
+void parser::set_retain_encoding(bool value)
+{
+    retain_encoding_ = value;
+}
+
+void parser::subscribe(const std::string& command, loader&& load)
+{
+    loaders_[command] = std::move(load);
+}
+
+void parser::reset()
+{
+    error_ = error::success;
+    heading_filled_ = 0;
+    heading_.reset();
+    loader_ = nullptr;
+    payload_remaining_ = 0;
+
+    // Retain the capacity for reuse by subsequent messages.
+    payload_.clear();
+}
+
+code parser::parse(data_slice data)
+{
+    auto position = data.data();
+    auto remaining = data.size();
+
+    while (!error_ && remaining != 0)
+    {
+        const auto used = heading_filled_ < heading_buffer_.size() ?
+            parse_heading(position, remaining) :
+            parse_payload(position, remaining);
+
+        position += used;
+        remaining -= used;
+    }
+
+    return error_;
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+size_t parser::parse_heading(const uint8_t* begin, size_t size)
+{
+    const auto needed = heading_buffer_.size() - heading_filled_;
+    const auto used = std::min(needed, size);
+    std::copy_n(begin, used, heading_buffer_.begin() + heading_filled_);
+    heading_filled_ += used;
+
+    if (heading_filled_ == heading_buffer_.size())
+        error_ = start_payload();
+
+    return used;
+}
+
+code parser::start_payload()
+{
+    auto source = make_safe_deserializer(heading_buffer_.begin(),
+        heading_buffer_.end());
+
+    if (!heading_.from_data(source) || heading_.magic() != magic_ ||
+        heading_.payload_size() > heading::maximum_payload_size(version_))
+        return error::bad_stream;
+
+    const auto it = loaders_.find(heading_.command());
+    loader_ = it == loaders_.end() ? nullptr : &it->second;
+    payload_remaining_ = heading_.payload_size();
+
+    // Only subscribed payloads are buffered and checksummed.
+    if (loader_ != nullptr)
+    {
+        SHA256Init(&checksum_->context);
+        payload_.reserve(std::min(payload_remaining_, maximum_reserve));
+    }
+
+    // An empty payload is complete upon its heading.
+    if (payload_remaining_ == 0)
+        return complete_payload(nullptr, 0, empty_checksum);
+
+    return error::success;
+}
+
+size_t parser::parse_payload(const uint8_t* begin, size_t size)
+{
+    const auto used = std::min(payload_remaining_, size);
+    payload_remaining_ -= used;
+
+    if (loader_ == nullptr)
+    {
+        // Skip the payload of an unsubscribed command.
+        if (payload_remaining_ == 0)
+            error_ = complete_payload(nullptr, 0, 0);
+
+        return used;
+    }
+
+    // The entire payload is present, deserialize it in place (no copy).
+    if (payload_.empty() && payload_remaining_ == 0)
+    {
+        const data_slice payload(begin, begin + used);
+        error_ = complete_payload(begin, used, bitcoin_checksum(payload));
+        return used;
+    }
+
+    SHA256Update(&checksum_->context, begin, used);
+    payload_.insert(payload_.end(), begin, begin + used);
+
+    if (payload_remaining_ == 0)
+    {
+        // Complete the double sha256 of the accumulated payload.
+        hash_digest hash;
+        SHA256Final(&checksum_->context, hash.data());
+        const auto check = from_little_endian_unsafe<uint32_t>(
+            sha256_hash(hash).begin());
+
+        error_ = complete_payload(payload_.data(), payload_.size(), check);
+    }
+
+    return used;
+}
+
+code parser::complete_payload(const uint8_t* begin, size_t size,
+    uint32_t checksum)
+{
+    const auto load = loader_;
+    const auto valid = load == nullptr || checksum == heading_.checksum();
+
+    // Ready for the next heading before notifying the handler.
+    heading_filled_ = 0;
+    loader_ = nullptr;
+
+    if (!valid)
+        return error::bad_stream;
+
+    code result(error::success);
+
+    if (load != nullptr)
+    {
+        const data_slice payload(begin, begin + size);
+
+        if (!(*load)(version_, heading_, payload, retain_encoding_))
+            result = error::bad_stream;
+    }
+
+    // Retain the capacity for reuse by subsequent messages.
+    payload_.clear();
+    return result;
+}
+
+// The payload is copied, as the parser buffer is reused.
+void parser::retain(block& message, uint32_t version, const heading& head,
+    data_slice payload)
+{
+    message.set_encoding(std::make_shared<const encoding>(version, head,
+        payload));
+}
+
+void parser::retain(transaction& message, uint32_t version,
+    const heading& head, data_slice payload)
+{
+    message.set_encoding(std::make_shared<const encoding>(version, head,
+        payload));
+}
+
+} // namespace message
+} // namespace libbitcoin
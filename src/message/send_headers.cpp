@@ -20,7 +20,7 @@
 
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -96,8 +96,8 @@ void send_headers::reset()
 
 bool send_headers::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool send_headers::from_data(uint32_t version, std::istream& stream)
@@ -141,6 +141,10 @@ void send_headers::to_data(uint32_t version, std::ostream& stream) const
 {
 }
 
+void send_headers::to_data(uint32_t version, writer& sink) const
+{
+}
+
 size_t send_headers::serialized_size(uint32_t version) const
 {
     return send_headers::satoshi_fixed_size(version);
@@ -22,9 +22,12 @@
 #include <utility>
 #include <bitcoin/bitcoin/chain/input.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
+#include <bitcoin/bitcoin/message/encoding.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -97,16 +100,19 @@ transaction::transaction(uint32_t version, uint32_t locktime,
 
 bool transaction::from_data(uint32_t, const data_chunk& data)
 {
+    set_encoding(nullptr);
     return chain::transaction::from_data(data, true);
 }
 
 bool transaction::from_data(uint32_t, std::istream& stream)
 {
+    set_encoding(nullptr);
     return chain::transaction::from_data(stream, true);
 }
 
 bool transaction::from_data(uint32_t, reader& source)
 {
+    set_encoding(nullptr);
     return chain::transaction::from_data(source, true);
 }
 
@@ -130,8 +136,41 @@ size_t transaction::serialized_size(uint32_t) const
     return chain::transaction::serialized_size(true);
 }
 
+encoding::const_ptr transaction::encode(uint32_t version, uint32_t magic) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    encoding_mutex_.lock_upgrade();
+
+    if (!encoding_ || encoding_->magic() != magic)
+    {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        encoding_mutex_.unlock_upgrade_and_lock();
+        encoding_ = message::encode(version, *this, magic);
+        encoding_mutex_.unlock_and_lock_upgrade();
+        //---------------------------------------------------------------------
+    }
+
+    const auto value = encoding_;
+    encoding_mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return value;
+}
+
+void transaction::set_encoding(encoding::const_ptr value)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(encoding_mutex_);
+
+    encoding_ = value;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 transaction& transaction::operator=(chain::transaction&& other)
 {
+    set_encoding(nullptr);
     reset();
     chain::transaction::operator=(std::move(other));
     return *this;
@@ -139,6 +178,7 @@ transaction& transaction::operator=(chain::transaction&& other)
 
 transaction& transaction::operator=(transaction&& other)
 {
+    set_encoding(nullptr);
     chain::transaction::operator=(std::move(other));
     return *this;
 }
@@ -21,7 +21,7 @@
 #include <algorithm>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -132,8 +132,8 @@ void version::reset()
 
 bool version::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return from_data(version, source);
 }
 
 bool version::from_data(uint32_t version, std::istream& stream)
@@ -224,7 +224,7 @@ size_t version::serialized_size(uint32_t version) const
         message::variable_uint_size(user_agent_.size()) + user_agent_.size() +
         sizeof(start_height_);
 
-    if (value_ >= level::bip37)
+    if (std::min(version, value_) >= level::bip37)
         size += sizeof(uint8_t);
 
     return size;
@@ -236,10 +236,25 @@ bool binary::is_prefix_of(const binary& field) const
     return is_prefix_of(field.blocks());
 }
 
+// Compare whole blocks and then the masked final block, without copying. The
+// field is zero padded to the size of this prefix.
 bool binary::is_prefix_of(data_slice field) const
 {
-    const binary truncated_prefix(size(), field);
-    return *this == truncated_prefix;
+    const auto whole = size() / bits_per_block;
+    const auto block = [&field](size_type index)
+    {
+        return index < field.size() ? field.data()[index] : uint8_t(0);
+    };
+
+    for (size_type index = 0; index < whole; ++index)
+        if (blocks_[index] != block(index))
+            return false;
+
+    if (final_block_excess_ == 0)
+        return true;
+
+    const uint8_t mask = 0xff << final_block_excess_;
+    return (blocks_[whole] & mask) == (block(whole) & mask);
 }
 
 bool binary::operator<(const binary& other) const
@@ -252,13 +267,7 @@ bool binary::operator==(const binary& other) const
     if (size() != other.size())
         return false;
 
-    const auto self = *this;
-
-    for (binary::size_type i = 0; i < size(); ++i)
-        if (self[i] != other[i])
-            return false;
-
-    return true;
+    return other.is_prefix_of(blocks_);
 }
 
 bool binary::operator!=(const binary& other) const
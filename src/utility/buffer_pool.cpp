@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+// A typical block transaction fits in one buffer.
+const size_t buffer_pool::default_buffer_size = 4096;
+
+// Sufficient to hold a maximal block in buffers of the default size.
+const size_t buffer_pool::default_capacity = 1024;
+
+buffer_pool::buffer_pool(size_t buffer_size, size_t capacity)
+  : buffer_size_(buffer_size),
+    capacity_(capacity)
+{
+}
+
+size_t buffer_pool::buffer_size() const
+{
+    return buffer_size_;
+}
+
+size_t buffer_pool::available() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    return buffers_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+data_chunk buffer_pool::acquire()
+{
+    data_chunk buffer;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock();
+
+    const auto reuse = !buffers_.empty();
+
+    if (reuse)
+    {
+        buffer = std::move(buffers_.back());
+        buffers_.pop_back();
+    }
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (!reuse)
+        buffer.resize(buffer_size_);
+
+    return buffer;
+}
+
+void buffer_pool::release(data_chunk&& buffer)
+{
+    // Buffers of another size (or moved from) are not retained.
+    if (buffer.size() != buffer_size_)
+        return;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    if (buffers_.size() < capacity_)
+        buffers_.push_back(std::move(buffer));
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,342 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/buffer_writer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+buffer_writer::buffer_writer(buffer_pool& pool)
+  : pool_(pool),
+    position_(0),
+    size_(0),
+    valid_(true)
+{
+    BITCOIN_ASSERT(pool.buffer_size() > 0);
+}
+
+buffer_writer::~buffer_writer()
+{
+    clear();
+}
+
+// Buffers.
+//-----------------------------------------------------------------------------
+
+size_t buffer_writer::size() const
+{
+    return size_;
+}
+
+asio::const_buffers buffer_writer::buffers() const
+{
+    asio::const_buffers out;
+    out.reserve(buffers_.size());
+
+    for (size_t index = 0; index < buffers_.size(); ++index)
+    {
+        const auto last = (index + 1 == buffers_.size());
+        const auto& buffer = buffers_[index];
+        out.emplace_back(buffer.data(), last ? position_ : buffer.size());
+    }
+
+    return out;
+}
+
+std::vector<data_slice> buffer_writer::slices(size_t offset) const
+{
+    std::vector<data_slice> out;
+
+    if (offset >= size_)
+        return out;
+
+    const auto buffer_size = pool_.buffer_size();
+    out.reserve(buffers_.size() - offset / buffer_size);
+
+    for (auto index = offset / buffer_size; index < buffers_.size(); ++index)
+    {
+        const auto last = (index + 1 == buffers_.size());
+        const auto begin = buffers_[index].data();
+        const auto start = (index == offset / buffer_size) ?
+            offset % buffer_size : 0;
+        out.emplace_back(begin + start, begin + (last ? position_ :
+            buffer_size));
+    }
+
+    return out;
+}
+
+data_chunk buffer_writer::to_data() const
+{
+    data_chunk out;
+    out.reserve(size_);
+
+    for (const auto& slice: slices())
+        out.insert(out.end(), slice.begin(), slice.end());
+
+    return out;
+}
+
+void buffer_writer::write_at(size_t offset, data_slice data)
+{
+    if (offset > size_ || data.size() > size_ - offset)
+    {
+        valid_ = false;
+        return;
+    }
+
+    const auto buffer_size = pool_.buffer_size();
+    auto index = offset / buffer_size;
+    auto position = offset % buffer_size;
+    auto from = data.begin();
+
+    while (from != data.end())
+    {
+        auto& buffer = buffers_[index++];
+        const auto count = std::min(buffer_size - position,
+            static_cast<size_t>(std::distance(from, data.end())));
+        std::copy_n(from, count, buffer.begin() + position);
+        from += count;
+        position = 0;
+    }
+}
+
+void buffer_writer::clear()
+{
+    for (auto& buffer: buffers_)
+        pool_.release(std::move(buffer));
+
+    buffers_.clear();
+    position_ = 0;
+    size_ = 0;
+    valid_ = true;
+}
+
+// Obtain the next writable span of at most size bytes, reducing size to the
+// span length, and advance the writer over the span.
+uint8_t* buffer_writer::next(size_t& size)
+{
+    if (buffers_.empty() || position_ == buffers_.back().size())
+    {
+        buffers_.push_back(pool_.acquire());
+        position_ = 0;
+    }
+
+    auto& buffer = buffers_.back();
+    size = std::min(size, buffer.size() - position_);
+    const auto span = buffer.data() + position_;
+    position_ += size;
+    size_ += size;
+    return span;
+}
+
+// Context.
+//-----------------------------------------------------------------------------
+
+buffer_writer::operator bool() const
+{
+    return valid_;
+}
+
+bool buffer_writer::operator!() const
+{
+    return !valid_;
+}
+
+// Hashes.
+//-----------------------------------------------------------------------------
+
+void buffer_writer::write_hash(const hash_digest& value)
+{
+    write_forward<hash_size>(value);
+}
+
+void buffer_writer::write_short_hash(const short_hash& value)
+{
+    write_forward<short_hash_size>(value);
+}
+
+void buffer_writer::write_mini_hash(const mini_hash& value)
+{
+    write_forward<mini_hash_size>(value);
+}
+
+// Big Endian Integers.
+//-----------------------------------------------------------------------------
+
+void buffer_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    write_big_endian<uint16_t>(value);
+}
+
+void buffer_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    write_big_endian<uint32_t>(value);
+}
+
+void buffer_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    write_big_endian<uint64_t>(value);
+}
+
+void buffer_writer::write_variable_big_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_big_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_big_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+void buffer_writer::write_size_big_endian(size_t value)
+{
+    write_variable_big_endian(value);
+}
+
+// Little Endian Integers.
+//-----------------------------------------------------------------------------
+
+void buffer_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    write_little_endian<uint16_t>(value);
+}
+
+void buffer_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    write_little_endian<uint32_t>(value);
+}
+
+void buffer_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    write_little_endian<uint64_t>(value);
+}
+
+void buffer_writer::write_variable_little_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_little_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_little_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void buffer_writer::write_size_little_endian(size_t value)
+{
+    write_variable_little_endian(value);
+}
+
+// Bytes.
+//-----------------------------------------------------------------------------
+
+void buffer_writer::write_byte(uint8_t value)
+{
+    // Avoid the span computation in the common case.
+    if (!buffers_.empty() && position_ < buffers_.back().size())
+    {
+        buffers_.back()[position_++] = value;
+        ++size_;
+        return;
+    }
+
+    write_bytes(&value, 1);
+}
+
+void buffer_writer::write_bytes(const data_chunk& data)
+{
+    write_bytes(data.data(), data.size());
+}
+
+void buffer_writer::write_bytes(const uint8_t* data, size_t size)
+{
+    while (size > 0)
+    {
+        auto count = size;
+        const auto span = next(count);
+        std::copy_n(data, count, span);
+        data += count;
+        size -= count;
+    }
+}
+
+void buffer_writer::write_string(const std::string& value, size_t size)
+{
+    const auto length = std::min(size, value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), length);
+    skip(floor_subtract(size, length));
+}
+
+void buffer_writer::write_string(const std::string& value)
+{
+    write_variable_little_endian(value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+// Pooled buffers are reused, so skipped bytes are cleared.
+void buffer_writer::skip(size_t size)
+{
+    while (size > 0)
+    {
+        auto count = size;
+        const auto span = next(count);
+        std::fill_n(span, count, string_terminator);
+        size -= count;
+    }
+}
+
+} // namespace libbitcoin
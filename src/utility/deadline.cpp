@@ -23,6 +23,7 @@
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/utility/timing_wheel.hpp>
 
 namespace libbitcoin {
 
@@ -32,15 +33,15 @@ using std::placeholders::_1;
 // Deadline is guaranteed to call handler exactly once unless canceled/reset.
 
 deadline::deadline(threadpool& pool)
-  : duration_(asio::seconds(0)),
-    timer_(pool.service())
+  : wheel_(pool.timers()),
+    duration_(asio::seconds(0))
     /*, CONSTRUCT_TRACK(deadline)*/
 {
 }
 
 deadline::deadline(threadpool& pool, const asio::duration duration)
-  : duration_(duration),
-    timer_(pool.service())
+  : wheel_(pool.timers()),
+    duration_(duration)
     /*, CONSTRUCT_TRACK(deadline)*/
 {
 }
@@ -56,44 +57,48 @@ void deadline::start(handler handle, const asio::duration duration)
         std::bind(&deadline::handle_timer,
             shared_from_this(), _1, handle);
 
+    timing_wheel::entry_ptr previous;
+
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(mutex_);
+    mutex_.lock();
 
-    // Handling socket error codes creates exception safety.
-    boost_code ignore;
-    timer_.cancel(ignore);
-    timer_.expires_from_now(duration);
+    // The wheel will not invoke the handler within this function.
+    previous.swap(timer_);
+    timer_ = wheel_.start(timer_handler, duration);
 
-    // async_wait will not invoke the handler within this function.
-    timer_.async_wait(timer_handler);
+    mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
+
+    // The previous handler is released outside of the critical section, as
+    // it may hold the last reference to this instance.
+    wheel_.stop(previous);
 }
 
-// Cancellation calls handle_timer with asio::error::operation_aborted.
-// We do not handle the cancelation result code, which will return success
-// in the case of a race in which the timer is already canceled.
+// Cancellation removes the timer from the wheel without invoking the handler.
+// We do not report the cancelation result, which will be false in the case
+// of a race in which the timer has already expired.
 void deadline::stop()
 {
+    timing_wheel::entry_ptr previous;
+
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(mutex_);
+    mutex_.lock();
 
-    // Handling socket error codes creates exception safety.
-    boost_code ignore;
-    timer_.cancel(ignore);
+    previous.swap(timer_);
+
+    mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
+
+    wheel_.stop(previous);
 }
 
 // If the timer expires the callback is fired with a success code.
-// If the timer fails the callback is fired with the normalized error code.
 // If the timer is canceled no call is made.
-void deadline::handle_timer(const boost_code& ec, handler handle) const
+void deadline::handle_timer(const code& ec, handler handle) const
 {
-    if (!ec)
-        handle(error::success);
-    else if (ec != asio::error::operation_aborted)
-        handle(error::boost_to_error_code(ec));
+    handle(ec);
 }
 
 } // namespace libbitcoin
@@ -21,14 +21,20 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _MSC_VER
     #include <windows.h>
 #else
     #include <unistd.h>
     #include <pthread.h>
+    #ifdef __linux__
+        #include <sched.h>
+    #endif
     #include <sys/resource.h>
     #include <sys/types.h>
     #ifndef PRIO_MAX
@@ -74,6 +80,34 @@ void set_priority(thread_priority priority)
 #endif
 }
 
+// Pin the calling thread to the set of cores, false if not supported.
+bool set_affinity(const std::vector<size_t>& cores)
+{
+    if (cores.empty())
+        return false;
+
+#if defined(_MSC_VER)
+    DWORD_PTR mask = 0;
+    for (const auto core: cores)
+        if (core < sizeof(DWORD_PTR) * 8)
+            mask |= (DWORD_PTR(1) << core);
+
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto core: cores)
+        if (core < CPU_SETSIZE)
+            CPU_SET(core, &set);
+
+    return CPU_COUNT(&set) != 0 &&
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    // Thread affinity is advisory at best on other platforms.
+    return false;
+#endif
+}
+
 thread_priority priority(bool priority)
 {
     return priority ? thread_priority::high : thread_priority::normal;
@@ -85,6 +119,157 @@ inline size_t cores()
     return std::max(std::thread::hardware_concurrency(), 1u);
 }
 
+typedef std::vector<std::vector<size_t>> topology;
+
+#if defined(__linux__)
+
+// Parse a sysfs cpu list such as "0-3,8-11".
+static std::vector<size_t> parse_cores(const std::string& list)
+{
+    std::vector<size_t> cores;
+    size_t position = 0;
+
+    while (position < list.size())
+    {
+        auto end = list.find(',', position);
+        if (end == std::string::npos)
+            end = list.size();
+
+        const auto range = list.substr(position, end - position);
+        const auto dash = range.find('-');
+
+        try
+        {
+            const auto first = std::stoul(range.substr(0, dash));
+            const auto last = dash == std::string::npos ? first :
+                std::stoul(range.substr(dash + 1));
+
+            for (auto core = first; core <= last; ++core)
+                cores.push_back(core);
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        position = end + 1;
+    }
+
+    return cores;
+}
+
+static topology read_topology()
+{
+    topology nodes;
+
+    for (size_t node = 0;; ++node)
+    {
+        std::ifstream file("/sys/devices/system/node/node" +
+            std::to_string(node) + "/cpulist");
+
+        std::string list;
+        if (!file || !std::getline(file, list))
+            break;
+
+        nodes.push_back(parse_cores(list));
+    }
+
+    return nodes;
+}
+
+#elif defined(_MSC_VER)
+
+static topology read_topology()
+{
+    topology nodes;
+    ULONG highest = 0;
+
+    if (GetNumaHighestNodeNumber(&highest) == FALSE)
+        return nodes;
+
+    for (ULONG node = 0; node <= highest; ++node)
+    {
+        ULONGLONG mask = 0;
+        std::vector<size_t> cores;
+
+        if (GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) != FALSE)
+            for (size_t core = 0; core < sizeof(mask) * 8; ++core)
+                if ((mask & (ULONGLONG(1) << core)) != 0)
+                    cores.push_back(core);
+
+        nodes.push_back(cores);
+    }
+
+    return nodes;
+}
+
+#else
+
+static topology read_topology()
+{
+    return{};
+}
+
+#endif
+
+// The topology is read once, an unknown topology is treated as one node.
+static const topology& nodes()
+{
+    static const auto nodes = []()
+    {
+        auto nodes = read_topology();
+
+        if (nodes.empty())
+        {
+            std::vector<size_t> all(cores());
+            for (size_t core = 0; core < all.size(); ++core)
+                all[core] = core;
+
+            nodes.push_back(all);
+        }
+
+        return nodes;
+    }();
+
+    return nodes;
+}
+
+// The number of numa nodes, at least one.
+size_t numa_nodes()
+{
+    return nodes().size();
+}
+
+// The cores of the numa node, empty if the node does not exist.
+std::vector<size_t> node_cores(size_t node)
+{
+    return node < nodes().size() ? nodes()[node] : std::vector<size_t>{};
+}
+
+// The numa node of the core currently executing the calling thread.
+size_t current_node()
+{
+#if defined(__linux__)
+    const auto result = sched_getcpu();
+    if (result < 0)
+        return any_node;
+
+    const auto core = static_cast<size_t>(result);
+#elif defined(_MSC_VER)
+    const auto core = static_cast<size_t>(GetCurrentProcessorNumber());
+#else
+    return numa_nodes() == 1 ? 0 : any_node;
+#endif
+
+#if defined(__linux__) || defined(_MSC_VER)
+    for (size_t node = 0; node < nodes().size(); ++node)
+        for (const auto candidate: nodes()[node])
+            if (candidate == core)
+                return node;
+
+    return any_node;
+#endif
+}
+
 // This is used to default the number of threads to the number of cores and to
 // ensure that no less than one thread is configured.
 size_t thread_default(size_t configured)
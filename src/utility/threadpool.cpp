@@ -18,15 +18,21 @@
  */
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
+#include <future>
+#include <memory>
 #include <thread>
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/timing_wheel.hpp>
 
 namespace libbitcoin {
 
-threadpool::threadpool(size_t number_threads, thread_priority priority)
-  : size_(0)
+threadpool::threadpool(size_t number_threads, thread_priority priority,
+    const asio::duration& resolution)
+  : timers_(service_, resolution),
+    size_(0),
+    node_(any_node)
 {
     spawn(number_threads, priority);
 }
@@ -57,9 +63,47 @@ void threadpool::spawn(size_t number_threads, thread_priority priority)
 
     for (size_t i = 0; i < number_threads; ++i)
         spawn_once(priority);
+
+    if (number_threads != 0)
+        node_.store(any_node);
+}
+
+// This is not thread safe.
+bool threadpool::spawn_on_node(size_t number_threads, size_t node,
+    bool pin_cores, thread_priority priority)
+{
+    const auto cores = node_cores(node);
+
+    // An unknown node is not an error, the threads are simply not bound.
+    if (cores.empty())
+    {
+        spawn(number_threads, priority);
+        return false;
+    }
+
+    // The pool is bound to the node only if all of its threads are.
+    const auto first = size();
+    auto bound = first == 0 || node_.load() == node;
+
+    // This allows the pool to be restarted.
+    service_.reset();
+
+    for (size_t i = 0; i < number_threads; ++i)
+    {
+        const auto thread_cores = pin_cores ?
+            std::vector<size_t>{ cores[(first + i) % cores.size()] } : cores;
+
+        if (!spawn_once(priority, thread_cores))
+            bound = false;
+    }
+
+    node_.store(bound ? node : any_node);
+    return bound;
 }
 
-void threadpool::spawn_once(thread_priority priority)
+// Returns false if the thread could not be bound to the cores (if any).
+bool threadpool::spawn_once(thread_priority priority,
+    const std::vector<size_t>& cores)
 {
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
@@ -79,18 +123,27 @@ void threadpool::spawn_once(thread_priority priority)
     work_mutex_.unlock_upgrade();
     ///////////////////////////////////////////////////////////////////////////
 
+    // The thread reports its binding before it runs the service.
+    const auto bound = std::make_shared<std::promise<bool>>();
+    auto result = bound->get_future();
+
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
-    unique_lock lock(threads_mutex_);
+    threads_mutex_.lock();
 
-    threads_.push_back(asio::thread([this, priority]()
+    threads_.push_back(asio::thread([this, priority, cores, bound]()
     {
         set_priority(priority);
+        bound->set_value(cores.empty() || set_affinity(cores));
         service_.run();
     }));
 
     ++size_;
+
+    threads_mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
+
+    return result.get();
 }
 
 void threadpool::abort()
@@ -125,9 +178,15 @@ void threadpool::join()
 
     threads_.clear();
     size_.store(0);
+    node_.store(any_node);
     ///////////////////////////////////////////////////////////////////////////
 }
 
+size_t threadpool::node() const
+{
+    return node_.load();
+}
+
 asio::service& threadpool::service()
 {
     return service_;
@@ -138,4 +197,9 @@ const asio::service& threadpool::service() const
     return service_;
 }
 
+timing_wheel& threadpool::timers()
+{
+    return timers_;
+}
+
 } // namespace libbitcoin
@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/timing_wheel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+
+// Slot lists are intrusive so that linking and unlinking are O(1) without
+// allocation. While linked an entry owns itself, so the wheel keeps pending
+// timers alive even when the caller has released its reference.
+struct timing_wheel::entry
+{
+    timing_wheel::handler handle;
+    uint64_t rounds;
+    size_t slot;
+    entry* previous;
+    entry* next;
+    entry_ptr self;
+};
+
+const asio::duration timing_wheel::default_resolution =
+    asio::milliseconds(10);
+
+const size_t timing_wheel::default_slots = 512;
+
+timing_wheel::timing_wheel(asio::service& service,
+    const asio::duration& resolution, size_t slots)
+  : service_(service),
+    resolution_(std::max(resolution, asio::duration(1))),
+    epoch_(asio::steady_clock::now()),
+    timer_(service),
+    slots_(std::max(slots, size_t(1)), nullptr),
+    tick_(0),
+    pending_(0),
+    ticking_(false)
+{
+}
+
+timing_wheel::~timing_wheel()
+{
+    entries abandoned;
+
+    // Break the self references of unexpired entries so that they are freed.
+    for (auto head: slots_)
+        for (auto timer = head; timer != nullptr; timer = timer->next)
+            abandoned.push_back(std::move(timer->self));
+}
+
+asio::duration timing_wheel::resolution() const
+{
+    return resolution_;
+}
+
+size_t timing_wheel::size() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return pending_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+timing_wheel::entry_ptr timing_wheel::start(handler handle,
+    const asio::duration& duration)
+{
+    const auto timer = std::make_shared<entry>();
+    timer->handle = std::move(handle);
+    timer->previous = nullptr;
+    timer->next = nullptr;
+
+    // Round up and add one tick, since the current tick is partially elapsed.
+    const auto period = resolution_.count();
+    const auto count = std::max(duration.count(), asio::duration::rep(0));
+    const auto ticks = static_cast<uint64_t>((count + period - 1) / period) + 1;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    const auto now = elapsed(asio::steady_clock::now());
+
+    // An empty wheel has no history, so skip the idle ticks.
+    if (pending_ == 0)
+        tick_ = std::max(tick_, now);
+
+    link(timer, now + ticks);
+    arm();
+    return timer;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool timing_wheel::stop(const entry_ptr& timer)
+{
+    if (!timer)
+        return false;
+
+    entry_ptr self;
+    handler handle;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock();
+
+    if (!timer->self)
+    {
+        mutex_.unlock();
+        //---------------------------------------------------------------------
+        return false;
+    }
+
+    unlink(*timer);
+    handle = std::move(timer->handle);
+    self = std::move(timer->self);
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // The handler and its captures are released outside of the critical
+    // section, as releasing a capture may reenter the wheel.
+    return true;
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+uint64_t timing_wheel::elapsed(const asio::time_point& now) const
+{
+    return static_cast<uint64_t>((now - epoch_) / resolution_);
+}
+
+// Must be called under exclusive lock.
+// The slot is first visited at a tick in (tick_, tick_ + slots], each
+// subsequent visit is a full rotation later, so rounds counts rotations.
+void timing_wheel::link(entry_ptr timer, uint64_t expiry)
+{
+    BITCOIN_ASSERT(expiry > tick_);
+    const auto slots = slots_.size();
+    timer->slot = static_cast<size_t>(expiry % slots);
+    timer->rounds = (expiry - tick_ - 1) / slots;
+
+    auto& head = slots_[timer->slot];
+    timer->previous = nullptr;
+    timer->next = head;
+
+    if (head != nullptr)
+        head->previous = timer.get();
+
+    head = timer.get();
+    timer->self = std::move(timer);
+    ++pending_;
+}
+
+// Must be called under exclusive lock.
+void timing_wheel::unlink(entry& timer)
+{
+    if (timer.previous != nullptr)
+        timer.previous->next = timer.next;
+    else
+        slots_[timer.slot] = timer.next;
+
+    if (timer.next != nullptr)
+        timer.next->previous = timer.previous;
+
+    timer.previous = nullptr;
+    timer.next = nullptr;
+    --pending_;
+}
+
+// Must be called under exclusive lock.
+void timing_wheel::advance(uint64_t target, entries& expired)
+{
+    const auto slots = slots_.size();
+
+    while (tick_ < target && pending_ != 0)
+    {
+        ++tick_;
+        auto timer = slots_[static_cast<size_t>(tick_ % slots)];
+
+        while (timer != nullptr)
+        {
+            const auto next = timer->next;
+
+            if (timer->rounds == 0)
+            {
+                unlink(*timer);
+                expired.push_back(std::move(timer->self));
+            }
+            else
+            {
+                --timer->rounds;
+            }
+
+            timer = next;
+        }
+    }
+
+    // Nothing remains to be visited in the skipped ticks.
+    tick_ = std::max(tick_, target);
+}
+
+// Must be called under exclusive lock.
+// A single asio wait is outstanding while any timer is pending. When the
+// wheel empties the wait lapses, allowing the service to run out of work.
+void timing_wheel::arm()
+{
+    if (ticking_ || pending_ == 0)
+        return;
+
+    ticking_ = true;
+    const auto tick = static_cast<asio::duration::rep>(tick_ + 1);
+    timer_.expires_at(epoch_ + resolution_ * tick);
+    timer_.async_wait(std::bind(&timing_wheel::handle_tick, this, _1));
+}
+
+void timing_wheel::handle_tick(const boost_code& ec)
+{
+    entries expired;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock();
+
+    ticking_ = false;
+
+    if (ec != asio::error::operation_aborted)
+    {
+        advance(elapsed(asio::steady_clock::now()), expired);
+        arm();
+    }
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Handlers are posted so that a slow handler cannot delay the wheel.
+    for (const auto& timer: expired)
+        service_.post(std::bind(std::move(timer->handle), error::success));
+}
+
+} // namespace libbitcoin
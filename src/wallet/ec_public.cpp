@@ -82,6 +82,22 @@ bool ec_public::is_point(data_slice decoded)
 // Factories.
 // ----------------------------------------------------------------------------
 
+ec_public::list ec_public::from_secrets(const secret_list& secrets,
+    bool compress)
+{
+    point_list points;
+    secret_to_public(points, secrets);
+
+    list out;
+    out.reserve(points.size());
+
+    for (const auto& point: points)
+        out.push_back(point == null_compressed_point ? ec_public() :
+            ec_public(point, compress));
+
+    return out;
+}
+
 ec_public ec_public::from_private(const ec_private& secret)
 {
     if (!secret)
@@ -21,7 +21,9 @@
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
@@ -32,6 +34,8 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include "parse_encrypted_keys/parse_encrypted_key.hpp"
@@ -124,10 +128,13 @@ static one_byte point_sign(const one_byte& single, const hash_digest& hash)
 // scrypt_
 // ----------------------------------------------------------------------------
 
-static hash_digest scrypt_token(data_slice data, data_slice salt)
+// The scrypt lanes of a key are mixed on the calling thread unless threads is
+// set, as each thread allocates 16MB for the BIP38 parameters.
+static hash_digest scrypt_token(data_slice data, data_slice salt,
+    size_t threads=1)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u);
+    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u, threads);
 }
 
 static long_hash scrypt_pair(data_slice data, data_slice salt)
@@ -136,10 +143,19 @@ static long_hash scrypt_pair(data_slice data, data_slice salt)
     return scrypt<long_hash_size>(data, salt, 1024u, 1u, 1u);
 }
 
-static long_hash scrypt_private(data_slice data, data_slice salt)
+static long_hash scrypt_private(data_slice data, data_slice salt,
+    size_t threads=1)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u);
+    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u, threads);
+}
+
+// Batch operations parallelize over keys, and mix the scrypt lanes of each
+// key on the threads that remain when there are fewer keys than threads.
+static size_t lane_threads(size_t keys)
+{
+    return std::max(thread_default(0) / std::max(keys, size_t(1)),
+        size_t(1));
 }
 
 // set_flags
@@ -276,6 +292,36 @@ bool create_key_pair(encrypted_private& out_private, ec_compressed& out_point,
         version, compressed);
 }
 
+bool create_key_pairs(encrypted_private_list& out_privates,
+    point_list& out_points, const encrypted_token& token,
+    const ek_seed_list& seeds, uint8_t version, bool compressed)
+{
+    const parse_encrypted_token parse(token);
+    if (!parse.valid())
+        return false;
+
+    std::atomic<bool> failed(false);
+    encrypted_private_list privates(seeds.size());
+    point_list points(seeds.size());
+
+    const auto create = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last && !failed; ++index)
+            if (!create_key_pair(privates[index], points[index], token,
+                seeds[index], version, compressed))
+                failed = true;
+    };
+
+    parallel_for(seeds.size(), 1, create);
+
+    if (failed)
+        return false;
+
+    out_privates = std::move(privates);
+    out_points = std::move(points);
+    return true;
+}
+
 #ifdef WITH_ICU
 
 // create_token
@@ -342,14 +388,15 @@ bool create_token(encrypted_token& out_token, const std::string& passphrase,
 // encrypt
 // ----------------------------------------------------------------------------
 
-bool encrypt(encrypted_private& out_private, const ec_secret& secret,
-    const std::string& passphrase, uint8_t version, bool compressed)
+static bool encrypt_secret(encrypted_private& out_private,
+    const ec_secret& secret, const data_chunk& passphrase, uint8_t version,
+    bool compressed, size_t threads)
 {
     ek_salt salt;
     if (!address_salt(salt, secret, version, compressed))
         return false;
 
-    const auto derived = split(scrypt_private(normal(passphrase), salt));
+    const auto derived = split(scrypt_private(passphrase, salt, threads));
     const auto prefix = parse_encrypted_private::prefix_factory(version,
         false);
 
@@ -369,13 +416,46 @@ bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     });
 }
 
+bool encrypt(encrypted_private& out_private, const ec_secret& secret,
+    const std::string& passphrase, uint8_t version, bool compressed)
+{
+    return encrypt_secret(out_private, secret, normal(passphrase), version,
+        compressed, 1);
+}
+
+bool encrypt(encrypted_private_list& out_privates, const secret_list& secrets,
+    const std::string& passphrase, uint8_t version, bool compressed)
+{
+    std::atomic<bool> failed(false);
+    const auto normalized = normal(passphrase);
+    const auto threads = lane_threads(secrets.size());
+    encrypted_private_list privates(secrets.size());
+
+    const auto encrypt_range = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last && !failed; ++index)
+            if (!encrypt_secret(privates[index], secrets[index], normalized,
+                version, compressed, threads))
+                failed = true;
+    };
+
+    parallel_for(secrets.size(), 1, encrypt_range);
+
+    if (failed)
+        return false;
+
+    out_privates = std::move(privates);
+    return true;
+}
+
 // decrypt private_key
 // ----------------------------------------------------------------------------
 
+// The pass factor is the scrypt of the passphrase with the owner salt.
 static bool decrypt_multiplied(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, const hash_digest& pass_factor)
 {
-    auto secret = scrypt_token(normal(passphrase), parse.owner_salt());
+    auto secret = pass_factor;
 
     if (parse.lot_sequence())
         secret = bitcoin_hash(splice(secret, parse.entropy()));
@@ -411,12 +491,13 @@ static bool decrypt_multiplied(ec_secret& out_secret,
 }
 
 static bool decrypt_secret(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, const data_chunk& passphrase,
+    size_t threads)
 {
     auto encrypt1 = splice(parse.entropy(), parse.data1());
     auto encrypt2 = parse.data2();
-    const auto derived = split(scrypt_private(normal(passphrase),
-        parse.salt()));
+    const auto derived = split(scrypt_private(passphrase, parse.salt(),
+        threads));
 
     aes256_decrypt(derived.right, encrypt1);
     aes256_decrypt(derived.right, encrypt2);
@@ -440,9 +521,11 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     if (!parse.valid())
         return false;
 
+    const auto normalized = normal(passphrase);
     const auto success = parse.multiplied() ?
-        decrypt_multiplied(out_secret, parse, passphrase) :
-        decrypt_secret(out_secret, parse, passphrase);
+        decrypt_multiplied(out_secret, parse,
+            scrypt_token(normalized, parse.owner_salt())) :
+        decrypt_secret(out_secret, parse, normalized, 1);
 
     if (success)
     {
@@ -453,6 +536,77 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     return success;
 }
 
+bool decrypt(secret_list& out_secrets, const encrypted_private_list& keys,
+    const std::string& passphrase)
+{
+    // Keys created from one intermediate passphrase share the owner salt,
+    // so the pass factor scrypt is computed once for each distinct salt.
+    data_stack salts;
+    for (const auto& key: keys)
+    {
+        const parse_encrypted_private parse(key);
+        if (!parse.valid())
+            return false;
+
+        if (parse.multiplied())
+            salts.push_back(parse.owner_salt());
+    }
+
+    std::sort(salts.begin(), salts.end());
+    salts.erase(std::unique(salts.begin(), salts.end()), salts.end());
+
+    std::atomic<bool> failed(false);
+    const auto normalized = normal(passphrase);
+    const auto factor_threads = lane_threads(salts.size());
+    hash_list pass_factors(salts.size());
+
+    const auto factor_range = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            pass_factors[index] = scrypt_token(normalized, salts[index],
+                factor_threads);
+    };
+
+    parallel_for(salts.size(), 1, factor_range);
+
+    const auto threads = lane_threads(keys.size());
+    secret_list secrets(keys.size());
+
+    const auto decrypt_range = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last && !failed; ++index)
+        {
+            const parse_encrypted_private parse(keys[index]);
+            auto& secret = secrets[index];
+            bool success;
+
+            if (parse.multiplied())
+            {
+                const auto salt = std::lower_bound(salts.begin(),
+                    salts.end(), parse.owner_salt());
+                const auto& factor = pass_factors[std::distance(
+                    salts.begin(), salt)];
+                success = decrypt_multiplied(secret, parse, factor);
+            }
+            else
+            {
+                success = decrypt_secret(secret, parse, normalized, threads);
+            }
+
+            if (!success)
+                failed = true;
+        }
+    };
+
+    parallel_for(keys.size(), 1, decrypt_range);
+
+    if (failed)
+        return false;
+
+    out_secrets = std::move(secrets);
+    return true;
+}
+
 // decrypt public_key
 // ----------------------------------------------------------------------------
 
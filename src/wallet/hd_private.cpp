@@ -272,6 +272,47 @@ hd_public hd_private::derive_public(uint32_t index) const
     return derive_private(index).to_public();
 }
 
+hd_private::list hd_private::derive_private_range(uint32_t first,
+    size_t count) const
+{
+    constexpr uint8_t depth = 0;
+
+    if (!is_derivable(first, count))
+        return{};
+
+    list children(count);
+
+    const auto message = [this](uint32_t index)
+    {
+        return (index >= hd_first_hardened_key) ?
+            to_chunk(splice(to_array(depth), secret_, to_big_endian(index))) :
+            to_chunk(splice(point_, to_big_endian(index)));
+    };
+
+    const auto create = [&](size_t offset, const long_hash& hmac,
+        const hd_lineage& lineage)
+    {
+        const auto intermediate = split(hmac);
+
+        // The child key ki is (parse256(IL) + kpar) mod n:
+        auto secret = secret_;
+        if (ec_add(secret, intermediate.left))
+            children[offset] = hd_private(secret, intermediate.right,
+                lineage);
+    };
+
+    derive_range(first, count, message, create);
+    return children;
+}
+
+// Public derivation of each child avoids the private derivation and the
+// serialization round trip of to_public.
+hd_public::list hd_private::derive_public_range(uint32_t first,
+    size_t count) const
+{
+    return to_public().derive_public_range(first, count);
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
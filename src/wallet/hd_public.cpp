@@ -33,6 +33,7 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 
@@ -42,6 +43,9 @@ namespace wallet {
 const uint32_t hd_public::mainnet = 76067358;
 const uint32_t hd_public::testnet = 70617039;
 
+// The minimum number of children derived by each thread of a range.
+static constexpr size_t derive_grain = 16;
+
 // hd_public
 // ----------------------------------------------------------------------------
 
@@ -240,9 +244,81 @@ hd_public hd_public::derive_public(uint32_t index) const
     return hd_public(combined, intermediate.right, lineage);
 }
 
+hd_public::list hd_public::derive_public_range(uint32_t first,
+    size_t count) const
+{
+    const auto last = static_cast<uint64_t>(first) + count;
+    if (!is_derivable(first, count) || last > hd_first_hardened_key)
+        return{};
+
+    list children(count);
+
+    const auto message = [this](uint32_t index)
+    {
+        return to_chunk(splice(point_, to_big_endian(index)));
+    };
+
+    const auto create = [&](size_t offset, const long_hash& hmac,
+        const hd_lineage& lineage)
+    {
+        const auto intermediate = split(hmac);
+
+        // The returned child key Ki is point(parse256(IL)) + Kpar.
+        auto combined = point_;
+        if (ec_add(combined, intermediate.left))
+            children[offset] = hd_public(combined, intermediate.right,
+                lineage);
+    };
+
+    derive_range(first, count, message, create);
+    return children;
+}
+
 // Helpers.
 // ----------------------------------------------------------------------------
 
+// The range must be within the index domain and the children within depth.
+bool hd_public::is_derivable(uint32_t first, size_t count) const
+{
+    static const auto domain = static_cast<uint64_t>(max_uint32) + 1;
+    const auto last = static_cast<uint64_t>(first) + count;
+    return valid_ && lineage_.depth != max_uint8 && last <= domain;
+}
+
+// The parent fingerprint and lineage are computed once for the range, and
+// the hmacs of the children of each thread are computed as a batch.
+void hd_public::derive_range(uint32_t first, size_t count,
+    const child_message& message, const child_creator& create) const
+{
+    const hd_lineage lineage
+    {
+        lineage_.prefixes,
+        static_cast<uint8_t>(lineage_.depth + 1),
+        fingerprint(),
+        0
+    };
+
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        data_stack data;
+        data.reserve(end - begin);
+
+        for (auto offset = begin; offset < end; ++offset)
+            data.push_back(message(static_cast<uint32_t>(first + offset)));
+
+        const auto hmacs = hmac_sha512_hash(data, chain_);
+
+        for (auto offset = begin; offset < end; ++offset)
+        {
+            auto child = lineage;
+            child.child_number = static_cast<uint32_t>(first + offset);
+            create(offset, hmacs[offset - begin], child);
+        }
+    };
+
+    parallel_for(count, derive_grain, derive);
+}
+
 uint32_t hd_public::fingerprint() const
 {
     const auto message_digest = bitcoin_short_hash(point_);
@@ -18,11 +18,15 @@
  */
 #include <bitcoin/bitcoin/wallet/message.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 
 namespace libbitcoin {
@@ -35,6 +39,9 @@ static constexpr uint8_t magic_differential = magic_compressed - magic_uncompres
 static_assert(magic_differential > max_recovery_id, "oops!");
 static_assert(max_uint8 - max_recovery_id >= magic_uncompressed, "oops!");
 
+// The minimum number of messages verified by each thread.
+static constexpr size_t verify_grain = 16;
+
 hash_digest hash_message(data_slice message)
 {
     // This is a specified magic prefix.
@@ -158,5 +165,27 @@ bool verify_message(data_slice message, const payment_address& address,
         (hash == address.hash());
 }
 
+// The digest is computed in each thread, so the hashing is parallel with
+// the (dominant) public key recovery.
+std::vector<bool> verify_messages(const signed_message::list& messages,
+    size_t threads)
+{
+    // std::vector<bool> is packed, so results are collected by byte.
+    std::vector<uint8_t> verified(messages.size(), 0);
+
+    const auto verify = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+        {
+            const auto& item = messages[index];
+            verified[index] = verify_message(item.message, item.address,
+                item.signature) ? 1 : 0;
+        }
+    };
+
+    parallel_for(messages.size(), verify_grain, verify, threads);
+    return std::vector<bool>(verified.begin(), verified.end());
+}
+
 } // namespace wallet
 } // namespace libbitcoin
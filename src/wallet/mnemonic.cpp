@@ -20,12 +20,16 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/binary.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 #include <bitcoin/bitcoin/wallet/dictionary.hpp>
 #include "../math/external/pkcs5_pbkdf2.h"
@@ -44,9 +48,85 @@ inline uint8_t bip39_shift(size_t bit)
     return (1 << (byte_bits - (bit % byte_bits) - 1));
 }
 
-bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
+// Word index.
+// ----------------------------------------------------------------------------
+// The words of all built-in dictionaries, sorted for binary search. A word
+// may appear in more than one dictionary (e.g. zh_Hans and zh_Hant).
+
+struct indexed_word
+{
+    const char* word;
+    size_t size;
+    const dictionary* lexicon;
+    uint16_t position;
+};
+
+typedef std::vector<indexed_word> word_index;
+
+// Words are compared by size as well, so a word with an embedded null does
+// not match the dictionary word that is its prefix.
+static bool word_less(const indexed_word& left, const indexed_word& right)
+{
+    const auto size = std::min(left.size, right.size);
+    const auto result = std::memcmp(left.word, right.word, size);
+    return result < 0 || (result == 0 && left.size < right.size);
+}
+
+// The dictionaries are constant initialized, unlike language::all, so the
+// index may be created during the dynamic initialization of this unit.
+static const dictionary* const built_in_lexicons[]
+{
+    &language::en,
+    &language::es,
+    &language::ja,
+    &language::it,
+    &language::fr,
+    &language::cs,
+    &language::ru,
+    &language::uk,
+    &language::zh_Hans,
+    &language::zh_Hant
+};
+
+static word_index create_index()
+{
+    word_index index;
+    index.reserve(std::distance(std::begin(built_in_lexicons),
+        std::end(built_in_lexicons)) * dictionary_size);
+
+    for (const auto lexicon: built_in_lexicons)
+    {
+        for (size_t position = 0; position < dictionary_size; ++position)
+        {
+            const auto word = (*lexicon)[position];
+            index.push_back({ word, std::strlen(word), lexicon,
+                static_cast<uint16_t>(position) });
+        }
+    }
+
+    std::stable_sort(index.begin(), index.end(), word_less);
+    return index;
+}
+
+// Created at namespace scope, as the initialization of function-local
+// statics is not thread safe under vs2013.
+static const auto built_in_index = create_index();
+
+static bool is_built_in(const dictionary* lexicon)
+{
+    const auto end = std::end(built_in_lexicons);
+    return std::find(std::begin(built_in_lexicons), end, lexicon) != end;
+}
+
+// Validation.
+// ----------------------------------------------------------------------------
+
+typedef std::vector<int> position_list;
+
+// Verify the checksum bits of the mnemonic given its word positions.
+static bool validate_positions(const position_list& positions)
 {
-    const auto word_count = words.size();
+    const auto word_count = positions.size();
     if ((word_count % mnemonic_word_multiple) != 0)
         return false;
 
@@ -59,9 +139,8 @@ bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
     size_t bit = 0;
     data_chunk data((total_bits + byte_bits - 1) / byte_bits, 0);
 
-    for (const auto& word: words)
+    for (const auto position: positions)
     {
-        const auto position = find_position(lexicon, word);
         if (position == -1)
             return false;
 
@@ -75,10 +154,27 @@ bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
         }
     }
 
-    data.resize(entropy_bits / byte_bits);
+    const auto entropy_bytes = entropy_bits / byte_bits;
+    const auto hash = sha256_hash(data_slice(data.data(),
+        data.data() + entropy_bytes));
+
+    for (bit = 0; bit < check_bits; ++bit)
+    {
+        const auto data_bit = entropy_bits + bit;
+        const auto expected = (hash[bit / byte_bits] & bip39_shift(bit)) != 0;
+        const auto actual = (data[data_bit / byte_bits] &
+            bip39_shift(data_bit)) != 0;
+
+        if (expected != actual)
+            return false;
+    }
+
+    return true;
+}
 
-    const auto mnemonic = create_mnemonic(data, lexicon);
-    return std::equal(mnemonic.begin(), mnemonic.end(), words.begin());
+bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
+{
+    return find_lexicon(words, { &lexicon }) != nullptr;
 }
 
 word_list create_mnemonic(data_slice entropy, const dictionary &lexicon)
@@ -121,14 +217,52 @@ word_list create_mnemonic(data_slice entropy, const dictionary &lexicon)
     return words;
 }
 
-bool validate_mnemonic(const word_list& mnemonic,
+// Positions are resolved for all lexicons in a single pass over the words,
+// using the index for built-in lexicons (and a linear search otherwise).
+const dictionary* find_lexicon(const word_list& mnemonic,
     const dictionary_list& lexicons)
 {
-    for (const auto& lexicon: lexicons)
-        if (validate_mnemonic(mnemonic, *lexicon))
-            return true;
+    if ((mnemonic.size() % mnemonic_word_multiple) != 0)
+        return nullptr;
+
+    const auto& index = built_in_index;
+    std::vector<position_list> positions(lexicons.size(),
+        position_list(mnemonic.size(), -1));
+
+    for (size_t word = 0; word < mnemonic.size(); ++word)
+    {
+        const auto& text = mnemonic[word];
+        const indexed_word key{ text.data(), text.size(), nullptr, 0 };
+        const auto range = std::equal_range(index.begin(), index.end(), key,
+            word_less);
+
+        for (auto it = range.first; it != range.second; ++it)
+            for (size_t lexicon = 0; lexicon < lexicons.size(); ++lexicon)
+                if (lexicons[lexicon] == it->lexicon)
+                    positions[lexicon][word] = it->position;
+    }
+
+    for (size_t lexicon = 0; lexicon < lexicons.size(); ++lexicon)
+    {
+        const auto candidate = lexicons[lexicon];
+        auto& lexicon_positions = positions[lexicon];
 
-    return false;
+        if (!is_built_in(candidate))
+            for (size_t word = 0; word < mnemonic.size(); ++word)
+                lexicon_positions[word] = find_position(*candidate,
+                    mnemonic[word]);
+
+        if (validate_positions(lexicon_positions))
+            return candidate;
+    }
+
+    return nullptr;
+}
+
+bool validate_mnemonic(const word_list& mnemonic,
+    const dictionary_list& lexicons)
+{
+    return find_lexicon(mnemonic, lexicons) != nullptr;
 }
 
 long_hash decode_mnemonic(const word_list& mnemonic)
@@ -139,6 +273,21 @@ long_hash decode_mnemonic(const word_list& mnemonic)
         hmac_iterations);
 }
 
+long_hash_list decode_mnemonics(const std::vector<word_list>& mnemonics)
+{
+    long_hash_list seeds(mnemonics.size());
+
+    const auto decode = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            seeds[index] = decode_mnemonic(mnemonics[index]);
+    };
+
+    // Each seed is 2048 hmac rounds, so distribute one mnemonic at a time.
+    parallel_for(mnemonics.size(), 1, decode);
+    return seeds;
+}
+
 #ifdef WITH_ICU
 
 long_hash decode_mnemonic(const word_list& mnemonic,
@@ -23,11 +23,13 @@
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <bitcoin/bitcoin/formats/base_58.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 
@@ -244,6 +246,45 @@ std::ostream& operator<<(std::ostream& out, const payment_address& of)
 // Static functions.
 // ----------------------------------------------------------------------------
 
+// Uncompressed points are decompressed before hashing, so this also spreads
+// the cost of decompression.
+payment_address::list payment_address::from_points(
+    const ec_public::list& points, uint8_t version)
+{
+    // The minimum number of addresses created by each thread.
+    static constexpr size_t grain = 256;
+
+    list out(points.size());
+
+    // Each thread hashes the valid points of its range as a batch.
+    const auto create = [&](size_t first, size_t last)
+    {
+        data_stack keys(last - first);
+        std::vector<data_slice> slices;
+        std::vector<size_t> indexes;
+
+        for (auto index = first; index < last; ++index)
+        {
+            auto& key = keys[index - first];
+            const auto& point = points[index];
+
+            if (point && point.to_data(key))
+            {
+                slices.emplace_back(key);
+                indexes.push_back(index);
+            }
+        }
+
+        const auto hashes = bitcoin_short_hashes(slices);
+
+        for (size_t row = 0; row < hashes.size(); ++row)
+            out[indexes[row]] = payment_address{ hashes[row], version };
+    };
+
+    parallel_for(points.size(), grain, create);
+    return out;
+}
+
 // All returned addresses are valid.
 payment_address::list payment_address::extract(const chain::script& script,
     uint8_t p2kh_version, uint8_t p2sh_version)
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/stealth_scanner.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/stealth_record.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/stealth.hpp>
+#include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_address.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+// The minimum number of candidate records matched by each thread.
+static constexpr size_t scan_grain = 64;
+
+// The filter is a bit prefix of the little endian serialization of the
+// stealth prefix, so it is converted to a mask and value over that word.
+static bool to_mask(uint32_t& out_mask, uint32_t& out_value,
+    const binary& filter)
+{
+    if (filter.size() > stealth_address::max_filter_bits)
+        return false;
+
+    byte_array<sizeof(uint32_t)> mask{ { 0 } };
+    byte_array<sizeof(uint32_t)> value{ { 0 } };
+    const auto& blocks = filter.blocks();
+    std::copy(blocks.begin(), blocks.end(), value.begin());
+
+    for (size_t bit = 0; bit < filter.size(); ++bit)
+        mask[bit / byte_bits] |= (0x80 >> (bit % byte_bits));
+
+    out_mask = from_little_endian_unsafe<uint32_t>(mask.begin());
+    out_value = from_little_endian_unsafe<uint32_t>(value.begin()) & out_mask;
+    return true;
+}
+
+stealth_scanner::stealth_scanner(const ec_secret& scan_private,
+    const point_list& spend_keys, const binary& filter, uint8_t version)
+  : version_(version), scan_private_(scan_private), spend_keys_(spend_keys),
+    valid_(false), mask_(0), value_(0)
+{
+    ec_compressed scan_public;
+    valid_ = !spend_keys_.empty() && to_mask(mask_, value_, filter) &&
+        secret_to_public(scan_public, scan_private_);
+}
+
+stealth_scanner::operator const bool() const
+{
+    return valid_;
+}
+
+bool stealth_scanner::is_candidate(uint32_t prefix) const
+{
+    return (prefix & mask_) == value_;
+}
+
+// The shared secret is computed once for each record (not each spend key).
+bool stealth_scanner::match_record(match& out_match,
+    const chain::stealth_record& record) const
+{
+    ec_secret shared;
+    if (!shared_secret(shared, scan_private_, record.ephemeral_public_key()))
+        return false;
+
+    for (size_t index = 0; index < spend_keys_.size(); ++index)
+    {
+        auto point = spend_keys_[index];
+        if (!ec_add(point, shared))
+            continue;
+
+        const auto hash = bitcoin_short_hash(point);
+        if (hash == record.public_key_hash())
+        {
+            out_match = { record, index, { hash, version_ }, shared };
+            return true;
+        }
+    }
+
+    return false;
+}
+
+stealth_scanner::matches stealth_scanner::scan(
+    const chain::stealth_record::list& records) const
+{
+    if (!valid_)
+        return{};
+
+    // Filter by prefix before any elliptic curve operation.
+    std::vector<size_t> candidates;
+    for (size_t index = 0; index < records.size(); ++index)
+        if (is_candidate(records[index].prefix()))
+            candidates.push_back(index);
+
+    matches found(candidates.size());
+    std::vector<uint8_t> matched(candidates.size(), 0);
+
+    const auto match_range = [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            matched[index] = match_record(found[index],
+                records[candidates[index]]) ? 1 : 0;
+    };
+
+    parallel_for(candidates.size(), scan_grain, match_range);
+
+    // Compact the matches in place, preserving record order.
+    size_t count = 0;
+    for (size_t index = 0; index < found.size(); ++index)
+    {
+        if (matched[index] == 0)
+            continue;
+
+        if (count != index)
+            found[count] = std::move(found[index]);
+
+        ++count;
+    }
+
+    found.resize(count);
+    return found;
+}
+
+bool stealth_scanner::derive_private(ec_secret& out_private,
+    const match& match, const ec_secret& spend_private)
+{
+    auto secret = spend_private;
+    if (!ec_add(secret, match.shared))
+        return false;
+
+    out_private = secret;
+    return true;
+}
+
+} // namespace wallet
+} // namespace libbitcoin
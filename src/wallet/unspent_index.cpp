@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/unspent_index.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/point_value.hpp>
+#include <bitcoin/bitcoin/chain/points_value.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+using namespace bc::chain;
+
+// The number of search steps between reads of the clock.
+static constexpr size_t budget_interval = 1024;
+
+const asio::duration unspent_index::default_budget = asio::milliseconds(100);
+
+// The null point orders first, so this precedes all outputs of the value.
+static point_value lowest(uint64_t value)
+{
+    return{ point{ null_hash, 0 }, value };
+}
+
+bool unspent_index::lesser::operator()(const point_value& left,
+    const point_value& right) const
+{
+    return left.value() == right.value() ?
+        static_cast<const point&>(left) < static_cast<const point&>(right) :
+        left.value() < right.value();
+}
+
+unspent_index::unspent_index()
+  : value_(0)
+{
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+size_t unspent_index::size() const
+{
+    return outputs_.size();
+}
+
+uint64_t unspent_index::value() const
+{
+    return value_;
+}
+
+bool unspent_index::contains(const point& point) const
+{
+    return values_.find(point) != values_.end();
+}
+
+// Updates.
+//-----------------------------------------------------------------------------
+
+bool unspent_index::insert(const point_value& unspent)
+{
+    if (!values_.emplace(unspent, unspent.value()).second)
+        return false;
+
+    outputs_.insert(unspent);
+    value_ = ceiling_add(value_, unspent.value());
+    return true;
+}
+
+bool unspent_index::remove(const point& spent)
+{
+    const auto it = values_.find(spent);
+
+    if (it == values_.end())
+        return false;
+
+    outputs_.erase(point_value{ spent, it->second });
+    value_ -= it->second;
+    values_.erase(it);
+    return true;
+}
+
+void unspent_index::clear()
+{
+    outputs_.clear();
+    values_.clear();
+    value_ = 0;
+}
+
+// Selection.
+//-----------------------------------------------------------------------------
+
+void unspent_index::greedy(points_value& out, uint64_t minimum_value) const
+{
+    out.points.clear();
+
+    // The minimum required value does not exist.
+    if (outputs_.empty() || value_ < minimum_value)
+        return;
+
+    // If there are values large enough, return the smallest (of the largest).
+    const auto sufficient = outputs_.lower_bound(lowest(minimum_value));
+
+    if (sufficient != outputs_.end())
+    {
+        out.points.push_back(*sufficient);
+        return;
+    }
+
+    uint64_t total = 0;
+
+    // Take by descending value in order to use the fewest inputs possible.
+    for (auto output = outputs_.rbegin(); output != outputs_.rend(); ++output)
+    {
+        out.points.push_back(*output);
+        total += output->value();
+
+        if (total >= minimum_value)
+            return;
+    }
+
+    BITCOIN_ASSERT_MSG(false, "unreachable code reached");
+}
+
+void unspent_index::individual(points_value& out,
+    uint64_t minimum_value) const
+{
+    // Select all individual points that satisfy the minimum (ascending).
+    const auto sufficient = outputs_.lower_bound(lowest(minimum_value));
+    out.points.assign(sufficient, outputs_.end());
+}
+
+void unspent_index::select(points_value& out, uint64_t minimum_value,
+    select_outputs::algorithm option) const
+{
+    switch (option)
+    {
+        case select_outputs::algorithm::individual:
+        {
+            individual(out, minimum_value);
+            break;
+        }
+        case select_outputs::algorithm::greedy:
+        default:
+        {
+            greedy(out, minimum_value);
+            break;
+        }
+    }
+}
+
+bool unspent_index::select_exact(points_value& out, uint64_t minimum_value,
+    uint64_t tolerance, const asio::duration& budget) const
+{
+    out.points.clear();
+    const auto maximum_value = ceiling_add(minimum_value, tolerance);
+
+    if (value_ < minimum_value)
+        return false;
+
+    // Only outputs that do not exceed the maximum may be in a match.
+    const auto end = maximum_value == max_uint64 ? outputs_.end() :
+        outputs_.lower_bound(lowest(maximum_value + 1));
+
+    std::vector<const point_value*> candidates;
+    for (auto output = ordered::const_reverse_iterator(end);
+        output != outputs_.rend(); ++output)
+        candidates.push_back(&(*output));
+
+    // The total value of the candidates from each position to the end.
+    const auto count = candidates.size();
+    std::vector<uint64_t> remaining(count + 1, 0);
+    for (auto index = count; index > 0; --index)
+        remaining[index - 1] = remaining[index] +
+            candidates[index - 1]->value();
+
+    if (remaining.front() < minimum_value)
+        return false;
+
+    const auto deadline = asio::steady_clock::now() + budget;
+    std::vector<size_t> selection;
+    std::vector<size_t> best;
+    auto best_excess = max_uint64;
+    uint64_t total = 0;
+    size_t index = 0;
+
+    // Depth first, each candidate is included before it is excluded.
+    for (size_t step = 1; ; ++step)
+    {
+        if (step % budget_interval == 0 &&
+            asio::steady_clock::now() >= deadline)
+            break;
+
+        // A selection over the maximum is abandoned, like one that matches.
+        const auto exceeded = total > maximum_value;
+
+        if (!exceeded && total >= minimum_value)
+        {
+            const auto excess = total - minimum_value;
+
+            if (excess < best_excess)
+            {
+                best = selection;
+                best_excess = excess;
+            }
+
+            if (excess == 0)
+                break;
+        }
+        else if (!exceeded && index < count &&
+            total + remaining[index] >= minimum_value)
+        {
+            total += candidates[index]->value();
+            selection.push_back(index++);
+            continue;
+        }
+
+        if (selection.empty())
+            break;
+
+        // Exclude the last included candidate, skipping candidates of equal
+        // value since their inclusion would repeat the branch just searched.
+        const auto last = selection.back();
+        selection.pop_back();
+        total -= candidates[last]->value();
+        index = last + 1;
+
+        while (index < count &&
+            candidates[index]->value() == candidates[last]->value())
+            ++index;
+    }
+
+    if (best_excess == max_uint64)
+        return false;
+
+    out.points.reserve(best.size());
+    for (const auto position: best)
+        out.points.push_back(*candidates[position]);
+
+    return true;
+}
+
+} // namespace wallet
+} // namespace libbitcoin
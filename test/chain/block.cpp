@@ -660,4 +660,69 @@ BOOST_AUTO_TEST_CASE(validate_block__is_distinct_tx_set__partialy_distinct_not_a
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(block_deserialization_tests)
+
+// Compares the contiguous (deserializer) and stream (istream_reader) paths.
+static void require_from_data(const data_chunk& raw)
+{
+    chain::block contiguous;
+    contiguous.from_data(raw);
+
+    chain::block stream;
+    data_source istream(raw);
+    stream.from_data(istream);
+
+    BOOST_REQUIRE(contiguous.is_valid());
+    BOOST_REQUIRE(contiguous == stream);
+    BOOST_REQUIRE(contiguous.to_data() == raw);
+}
+
+BOOST_AUTO_TEST_CASE(block__from_data__genesis_mainnet__matches_stream)
+{
+    const auto genesis = chain::block::genesis_mainnet();
+    require_from_data(genesis.to_data());
+}
+
+BOOST_AUTO_TEST_CASE(block__from_data__block100k_mainnet__matches_stream)
+{
+    // encodes the 100,000 block data.
+    const data_chunk raw = to_chunk(base16_literal(
+        "010000007f110631052deeee06f0754a3629ad7663e56359fd5f3aa7b3e30a00"
+        "000000005f55996827d9712147a8eb6d7bae44175fe0bcfa967e424a25bfe9f4"
+        "dc118244d67fb74c9d8e2f1bea5ee82a03010000000100000000000000000000"
+        "00000000000000000000000000000000000000000000ffffffff07049d8e2f1b"
+        "0114ffffffff0100f2052a0100000043410437b36a7221bc977dce712728a954"
+        "e3b5d88643ed5aef46660ddcfeeec132724cd950c1fdd008ad4a2dfd354d6af0"
+        "ff155fc17c1ee9ef802062feb07ef1d065f0ac000000000100000001260fd102"
+        "fab456d6b169f6af4595965c03c2296ecf25bfd8790e7aa29b404eff01000000"
+        "8c493046022100c56ad717e07229eb93ecef2a32a42ad041832ffe66bd2e1485"
+        "dc6758073e40af022100e4ba0559a4cebbc7ccb5d14d1312634664bac46f36dd"
+        "d35761edaae20cefb16f01410417e418ba79380f462a60d8dd12dcef8ebfd7ab"
+        "1741c5c907525a69a8743465f063c1d9182eea27746aeb9f1f52583040b1bc34"
+        "1b31ca0388139f2f323fd59f8effffffff0200ffb2081d0000001976a914fc7b"
+        "44566256621affb1541cc9d59f08336d276b88ac80f0fa02000000001976a914"
+        "617f0609c9fabb545105f7898f36b84ec583350d88ac00000000010000000122"
+        "cd6da26eef232381b1a670aa08f4513e9f91a9fd129d912081a3dd138cb01301"
+        "0000008c4930460221009339c11b83f234b6c03ebbc4729c2633cbc8cbd0d157"
+        "74594bfedc45c4f99e2f022100ae0135094a7d651801539df110a028d65459d2"
+        "4bc752d7512bc8a9f78b4ab368014104a2e06c38dc72c4414564f190478e3b0d"
+        "01260f09b8520b196c2f6ec3d06239861e49507f09b7568189efe8d327c3384a"
+        "4e488f8c534484835f8020b3669e5aebffffffff0200ac23fc060000001976a9"
+        "14b9a2c9700ff9519516b21af338d28d53ddf5349388ac00743ba40b00000019"
+        "76a914eb675c349c474bec8dea2d79d12cff6f330ab48788ac00000000"));
+
+    require_from_data(raw);
+}
+
+BOOST_AUTO_TEST_CASE(block__from_data__truncated_genesis__failure)
+{
+    const auto raw = chain::block::genesis_mainnet().to_data();
+    const data_chunk truncated(raw.begin(), raw.end() - 1);
+    chain::block instance;
+    BOOST_REQUIRE(!instance.from_data(truncated));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(chain_state_tests)
+
+static const uint32_t mainnet_forks = rule_fork::all_rules &
+    ~(rule_fork::easy_blocks | rule_fork::bip90_rule);
+static const uint32_t testnet_forks = rule_fork::all_rules &
+    ~rule_fork::bip90_rule;
+static const chain_state::checkpoints no_checkpoints{};
+
+// A deterministic synthetic chain, with versions rising through the bip34,
+// bip66 and bip65 thresholds and a mix of easy (limit) and harder bits.
+static header::list make_chain(size_t count)
+{
+    header::list chain;
+    chain.reserve(count);
+    uint32_t timestamp = 1231006505;
+
+    for (size_t height = 0; height < count; ++height)
+    {
+        const uint32_t version = height < 200 ? 1 : height < 300 ? 2 :
+            height < 400 ? 3 : 4;
+        const uint32_t bits = height % 7 == 0 ? 0x1c0fffff :
+            proof_of_work_limit;
+
+        // Vary the spacing so that the median differs from the latest and
+        // the easy blocks time limit is sometimes exceeded.
+        timestamp += (height * 7919) % 2401;
+        chain.emplace_back(version, null_hash, null_hash, timestamp, bits,
+            static_cast<uint32_t>(height));
+    }
+
+    return chain;
+}
+
+// Populate the raw data set for the state at height as a store would.
+static chain_state::data make_data(const header::list& chain, size_t height,
+    uint32_t forks)
+{
+    const auto map = chain_state::get_map(height, no_checkpoints, forks);
+    const auto& self = chain[height];
+
+    chain_state::data data;
+    data.height = height;
+    data.hash = self.hash();
+    data.allow_collisions_hash = null_hash;
+    data.bip9_bit0_hash = null_hash;
+    data.bits.self = self.bits();
+    data.version.self = self.version();
+    data.timestamp.self = self.timestamp();
+    data.timestamp.retarget = chain[map.timestamp_retarget].timestamp();
+
+    for (auto it = height - map.bits.count; it < height; ++it)
+        data.bits.ordered.push_back(chain[it].bits());
+
+    for (auto it = height - map.version.count; it < height; ++it)
+        data.version.ordered.push_back(chain[it].version());
+
+    for (auto it = height - map.timestamp.count; it < height; ++it)
+        data.timestamp.ordered.push_back(chain[it].timestamp());
+
+    return data;
+}
+
+static chain_state::ptr make_state(const header::list& chain, size_t height,
+    uint32_t forks)
+{
+    return std::make_shared<chain_state>(make_data(chain, height, forks),
+        no_checkpoints, forks);
+}
+
+static bool equal_state(const chain_state& left, const chain_state& right)
+{
+    return left.height() == right.height() &&
+        left.enabled_forks() == right.enabled_forks() &&
+        left.minimum_block_version() == right.minimum_block_version() &&
+        left.median_time_past() == right.median_time_past() &&
+        left.work_required() == right.work_required();
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__constructor__zero_height__invalid)
+{
+    chain_state::data data;
+    data.height = 0;
+    data.bits.self = proof_of_work_limit;
+    data.version.self = 1;
+    data.timestamp.self = 0;
+    data.timestamp.retarget = 0;
+    const chain_state instance(std::move(data), no_checkpoints, mainnet_forks);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__constructor__mainnet_header_promotion__matches_data)
+{
+    const auto chain = make_chain(1500);
+    auto state = make_state(chain, 1, mainnet_forks);
+
+    for (size_t height = 2; height < chain.size(); ++height)
+    {
+        state = std::make_shared<chain_state>(*state, chain[height]);
+        const auto expected = make_state(chain, height, mainnet_forks);
+        BOOST_REQUIRE(equal_state(*state, *expected));
+    }
+
+    // The version sample has risen through the bip65 enforcement threshold.
+    BOOST_REQUIRE(state->is_enabled(rule_fork::bip65_rule));
+    BOOST_REQUIRE_EQUAL(state->minimum_block_version(), bip65_version);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__constructor__testnet_header_promotion__matches_data)
+{
+    const auto chain = make_chain(2 * retargeting_interval + 50);
+    auto state = make_state(chain, 1, testnet_forks);
+
+    for (size_t height = 2; height < chain.size(); ++height)
+    {
+        state = std::make_shared<chain_state>(*state, chain[height]);
+        const auto expected = make_state(chain, height, testnet_forks);
+        BOOST_REQUIRE(equal_state(*state, *expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__constructor__pool_and_block_promotion__matches_data)
+{
+    const auto chain = make_chain(1200);
+    auto state = make_state(chain, 1, mainnet_forks);
+
+    for (size_t height = 2; height < chain.size(); ++height)
+    {
+        const auto pool = std::make_shared<chain_state>(*state);
+        BOOST_REQUIRE_EQUAL(pool->height(), height);
+
+        const block block(chain[height], {});
+        state = std::make_shared<chain_state>(*pool, block);
+        const auto expected = make_state(chain, height, mainnet_forks);
+        BOOST_REQUIRE(equal_state(*state, *expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__constructor__branched_promotion__independent)
+{
+    const auto chain = make_chain(1100);
+    auto state = make_state(chain, 1, mainnet_forks);
+
+    for (size_t height = 2; height < 1050; ++height)
+        state = std::make_shared<chain_state>(*state, chain[height]);
+
+    // Promote a branch of higher versions from the same parent.
+    auto branch = state;
+    for (size_t height = 1050; height < chain.size(); ++height)
+    {
+        const auto& original = chain[height];
+        const header fork(original.version() + 1, null_hash, null_hash,
+            original.timestamp(), original.bits(), original.nonce());
+        branch = std::make_shared<chain_state>(*branch, fork);
+    }
+
+    // The history shared with the branch is unaffected by it.
+    for (size_t height = 1050; height < chain.size(); ++height)
+        state = std::make_shared<chain_state>(*state, chain[height]);
+
+    const auto expected = make_state(chain, chain.size() - 1, mainnet_forks);
+    BOOST_REQUIRE(equal_state(*state, *expected));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
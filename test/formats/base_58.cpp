@@ -100,4 +100,107 @@ BOOST_AUTO_TEST_CASE(base58_array_test)
     BOOST_REQUIRE(converted == expected);
 }
 
+BOOST_AUTO_TEST_CASE(base58__encode_base58__long_data__round_trips)
+{
+    // Exceeds the stack limb buffer, including leading zeros.
+    data_chunk data(300);
+    for (size_t index = 1; index < data.size(); ++index)
+        data[index] = static_cast<uint8_t>(index * 37);
+
+    data_chunk decoded;
+    const auto encoded = encode_base58(data);
+    BOOST_REQUIRE_EQUAL(encoded.front(), '1');
+    BOOST_REQUIRE(decode_base58(decoded, encoded));
+    BOOST_REQUIRE(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(base58__encode_base58__batch__matches_single)
+{
+    data_stack data;
+    for (size_t index = 0; index < 3000; ++index)
+        data.push_back(to_chunk(bitcoin_hash(to_chunk(to_little_endian(
+            index)))));
+
+    // Leading zeros and empty data.
+    data[7] = data_chunk{ 0x00, 0x00, 0x42 };
+    data[42] = data_chunk{};
+
+    const auto encoded = encode_base58(data);
+    BOOST_REQUIRE_EQUAL(encoded.size(), data.size());
+
+    for (size_t index = 0; index < data.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encoded[index], encode_base58(data[index]));
+
+    data_stack decoded;
+    BOOST_REQUIRE(decode_base58(decoded, encoded));
+    BOOST_REQUIRE(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(base58__decode_base58__batch_invalid_character__false)
+{
+    const string_list encoded
+    {
+        "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT",
+        "abcdjkk011",
+        "2g"
+    };
+
+    data_stack decoded;
+    BOOST_REQUIRE(!decode_base58(decoded, encoded));
+}
+
+BOOST_AUTO_TEST_CASE(base58__encode_base58_check__address__expected)
+{
+    data_chunk payload;
+    BOOST_REQUIRE(decode_base16(payload, "005cc87f4a3fdfe3a2346b6953267ca867282630d3"));
+    const auto encoded = encode_base58_check(payload);
+    BOOST_REQUIRE_EQUAL(encoded, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT");
+
+    data_chunk decoded;
+    BOOST_REQUIRE(decode_base58_check(decoded, encoded));
+    BOOST_REQUIRE(decoded == payload);
+}
+
+BOOST_AUTO_TEST_CASE(base58__encode_base58_check__sizes__matches_appended_checksum)
+{
+    // Extended key, other sizes and leading zeros.
+    for (const size_t size: { 0, 1, 20, 78, 100 })
+    {
+        data_chunk payload(size);
+        for (size_t index = 2; index < size; ++index)
+            payload[index] = static_cast<uint8_t>(index * 37);
+
+        auto checked = payload;
+        append_checksum(checked);
+        const auto encoded = encode_base58_check(payload);
+        BOOST_REQUIRE_EQUAL(encoded, encode_base58(checked));
+
+        data_chunk decoded;
+        BOOST_REQUIRE(decode_base58_check(decoded, encoded));
+        BOOST_REQUIRE(decoded == payload);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(base58__decode_base58_check__invalid_checksum__false)
+{
+    data_chunk decoded;
+    BOOST_REQUIRE(!decode_base58_check(decoded, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViU"));
+    BOOST_REQUIRE(!decode_base58_check(decoded, "2g"));
+}
+
+BOOST_AUTO_TEST_CASE(base58__decode_base58__extended_key_array__round_trips)
+{
+    byte_array<82> key;
+    for (size_t index = 0; index < key.size(); ++index)
+        key[index] = static_cast<uint8_t>(index * 37);
+
+    key[0] = 0x00;
+    byte_array<82> decoded;
+    BOOST_REQUIRE(decode_base58(decoded, encode_base58(key)));
+    BOOST_REQUIRE(decoded == key);
+
+    byte_array<81> short_key;
+    BOOST_REQUIRE(!decode_base58(short_key, encode_base58(key)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
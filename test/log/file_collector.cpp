@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::log;
+using namespace boost::filesystem;
+
+BOOST_AUTO_TEST_SUITE(file_collector_tests)
+
+// Creates an empty log directory and archive directory for each test.
+class directories
+{
+public:
+    directories(const std::string& name)
+      : root_(temp_directory_path() / unique_path(name + "-%%%%-%%%%"))
+    {
+        create_directories(log());
+        create_directories(archive());
+    }
+
+    ~directories()
+    {
+        remove_all(root_);
+    }
+
+    path log() const
+    {
+        return root_ / "log";
+    }
+
+    path archive() const
+    {
+        return root_ / "archive";
+    }
+
+private:
+    const path root_;
+};
+
+static void write(const path& file, const std::string& text)
+{
+    std::ofstream stream(file.string(), std::ios::binary);
+    stream << text;
+}
+
+static std::string read(const path& file)
+{
+    std::ifstream stream(file.string(), std::ios::binary);
+    std::ostringstream text;
+    text << stream.rdbuf();
+    return text.str();
+}
+
+static boost::shared_ptr<file_collector> make_file_collector(
+    const path& archive, size_t max_files=10,
+    file_compression compression=file_compression::none)
+{
+    return boost::dynamic_pointer_cast<file_collector>(make_collector(
+        archive, 1024 * 1024, 0, max_files, compression));
+}
+
+BOOST_AUTO_TEST_CASE(file_collector__store_file__uncompressed__archived)
+{
+    const directories paths("store_file");
+    const auto collector = make_file_collector(paths.archive());
+    BOOST_REQUIRE(collector);
+
+    const auto log = paths.log() / "debug.log";
+    write(log, "first");
+    collector->store_file(log);
+    collector->flush();
+
+    BOOST_REQUIRE(!exists(log));
+    BOOST_REQUIRE_EQUAL(read(paths.archive() / "debug-00000.log"), "first");
+}
+
+BOOST_AUTO_TEST_CASE(file_collector__store_file__gzip__round_trips)
+{
+    const directories paths("store_file_gzip");
+    const auto collector = make_file_collector(paths.archive(), 10,
+        file_compression::gzip);
+    BOOST_REQUIRE(collector);
+
+    const auto log = paths.log() / "debug.log";
+    write(log, "compressed");
+    collector->store_file(log);
+    collector->flush();
+
+    const auto archived = paths.archive() / "debug-00000.log.gz";
+    BOOST_REQUIRE(exists(archived));
+
+    std::ifstream file(archived.string(), std::ios::binary);
+    boost::iostreams::filtering_istream stream;
+    stream.push(boost::iostreams::gzip_decompressor());
+    stream.push(file);
+    std::ostringstream text;
+    boost::iostreams::copy(stream, text);
+    BOOST_REQUIRE_EQUAL(text.str(), "compressed");
+}
+
+BOOST_AUTO_TEST_CASE(file_collector__store_file__max_files__oldest_erased)
+{
+    const directories paths("store_file_max");
+    const auto collector = make_file_collector(paths.archive(), 2);
+    BOOST_REQUIRE(collector);
+
+    const auto log = paths.log() / "debug.log";
+    for (size_t index = 0; index < 3; ++index)
+    {
+        write(log, std::to_string(index));
+        collector->store_file(log);
+        collector->flush();
+    }
+
+    BOOST_REQUIRE(!exists(paths.archive() / "debug-00000.log"));
+    BOOST_REQUIRE_EQUAL(read(paths.archive() / "debug-00001.log"), "1");
+    BOOST_REQUIRE_EQUAL(read(paths.archive() / "debug-00002.log"), "2");
+}
+
+BOOST_AUTO_TEST_CASE(file_collector__scan_for_files__pending__archived)
+{
+    const directories paths("scan_for_files");
+    const auto collector = make_file_collector(paths.archive());
+    BOOST_REQUIRE(collector);
+
+    // A file renamed aside by a process that exited before storing it.
+    const auto pending = paths.log() / "debug.log-00003.pending";
+    write(pending, "recovered");
+
+    collector->scan_for_files(boost::log::sinks::file::scan_matching,
+        paths.log() / "debug.log", nullptr);
+    collector->flush();
+
+    BOOST_REQUIRE(!exists(pending));
+    BOOST_REQUIRE_EQUAL(read(paths.archive() / "debug-00000.log"),
+        "recovered");
+}
+
+BOOST_AUTO_TEST_CASE(file_collector__scan_for_files__other_pending__ignored)
+{
+    const directories paths("scan_for_files_other");
+    const auto collector = make_file_collector(paths.archive());
+    BOOST_REQUIRE(collector);
+
+    const auto pending = paths.log() / "error.log-00000.pending";
+    write(pending, "other");
+
+    collector->scan_for_files(boost::log::sinks::file::scan_matching,
+        paths.log() / "debug.log", nullptr);
+    collector->flush();
+
+    BOOST_REQUIRE(exists(pending));
+    BOOST_REQUIRE(!exists(paths.archive() / "error-00000.log"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
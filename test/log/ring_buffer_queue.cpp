@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/sinks.hpp>
+#include <boost/log/utility/value_ref.hpp>
+#include <boost/make_shared.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::log;
+using namespace boost::log;
+
+// Exposes the queueing strategy interface used by asynchronous_sink.
+template <size_t Capacity>
+class test_queue
+  : public ring_buffer_queue<Capacity>
+{
+public:
+    using ring_buffer_queue<Capacity>::enqueue;
+    using ring_buffer_queue<Capacity>::try_enqueue;
+    using ring_buffer_queue<Capacity>::try_dequeue;
+    using ring_buffer_queue<Capacity>::dequeue_ready;
+    using ring_buffer_queue<Capacity>::interrupt_dequeue;
+};
+
+// Records are only opened while a sink accepts them.
+struct ring_buffer_queue_fixture
+{
+    typedef sinks::synchronous_sink<sinks::text_ostream_backend> null_sink;
+
+    ring_buffer_queue_fixture()
+      : sink(boost::make_shared<null_sink>())
+    {
+        core::get()->add_sink(sink);
+    }
+
+    ~ring_buffer_queue_fixture()
+    {
+        core::get()->remove_sink(sink);
+    }
+
+    boost::shared_ptr<null_sink> sink;
+};
+
+static record_view make_record(int index, severity level=severity::info)
+{
+    attribute_set set;
+    set.insert("index", boost::log::attributes::constant<int>(index));
+    set.insert(bc::log::attributes::severity.get_name(),
+        boost::log::attributes::constant<severity>(level));
+
+    auto record = core::get()->open_record(set);
+    BOOST_REQUIRE(record);
+    return record.lock();
+}
+
+static int index_of(const record_view& record)
+{
+    return extract_or_default<int>("index", record, -1);
+}
+
+template <size_t Capacity>
+static int next(test_queue<Capacity>& queue)
+{
+    record_view record;
+    return queue.try_dequeue(record) ? index_of(record) : -1;
+}
+
+BOOST_FIXTURE_TEST_SUITE(ring_buffer_queue_tests, ring_buffer_queue_fixture)
+
+BOOST_AUTO_TEST_CASE(ring_buffer_queue__try_enqueue__wraparound__fifo)
+{
+    test_queue<4> queue;
+    auto index = 0;
+
+    // Each round starts one cell further around the ring.
+    for (auto round = 0; round < 10; ++round)
+    {
+        const auto first = index;
+
+        for (auto count = 0; count < 3; ++count)
+            BOOST_REQUIRE(queue.try_enqueue(make_record(index++)));
+
+        for (auto expected = first; expected < index; ++expected)
+            BOOST_REQUIRE_EQUAL(next(queue), expected);
+    }
+
+    for (auto count = 0; count < 4; ++count)
+        BOOST_REQUIRE(queue.try_enqueue(make_record(count)));
+
+    BOOST_REQUIRE(!queue.try_enqueue(make_record(4)));
+
+    for (auto expected = 0; expected < 4; ++expected)
+        BOOST_REQUIRE_EQUAL(next(queue), expected);
+
+    BOOST_REQUIRE_EQUAL(next(queue), -1);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer_queue__enqueue__drop_full__newest_dropped)
+{
+    test_queue<4> queue;
+    queue.set_overflow_policy(overflow_policy::drop);
+
+    for (auto index = 0; index < 6; ++index)
+        queue.enqueue(make_record(index));
+
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 2u);
+
+    for (auto expected = 0; expected < 4; ++expected)
+        BOOST_REQUIRE_EQUAL(next(queue), expected);
+
+    BOOST_REQUIRE_EQUAL(next(queue), -1);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer_queue__enqueue__sample_above_threshold__sampled)
+{
+    static const auto rate = test_queue<16>::sample_rate;
+    test_queue<16> queue;
+    queue.set_overflow_policy(overflow_policy::sample);
+
+    // Below three quarters full every record is admitted.
+    for (auto index = 0; index < 12; ++index)
+        queue.enqueue(make_record(index));
+
+    // Above it one of each sample rate records is admitted.
+    for (auto index = 12; index < 12 + 2 * int(rate); ++index)
+        queue.enqueue(make_record(index));
+
+    // Warnings are always admitted, until the queue is full.
+    for (auto index = 100; index < 103; ++index)
+        queue.enqueue(make_record(index, severity::warning));
+
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 2 * (rate - 1) + 1);
+
+    for (auto expected = 0; expected < 12; ++expected)
+        BOOST_REQUIRE_EQUAL(next(queue), expected);
+
+    BOOST_REQUIRE_EQUAL(next(queue), 12);
+    BOOST_REQUIRE_EQUAL(next(queue), 12 + int(rate));
+    BOOST_REQUIRE_EQUAL(next(queue), 100);
+    BOOST_REQUIRE_EQUAL(next(queue), 101);
+    BOOST_REQUIRE_EQUAL(next(queue), -1);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer_queue__enqueue__block_full__waits_for_consumer)
+{
+    static const auto records = 100;
+    test_queue<4> queue;
+    queue.set_overflow_policy(overflow_policy::block);
+
+    std::thread producer([&queue]()
+    {
+        for (auto index = 0; index < records; ++index)
+            queue.enqueue(make_record(index));
+    });
+
+    record_view record;
+    for (auto expected = 0; expected < records; ++expected)
+    {
+        BOOST_REQUIRE(queue.dequeue_ready(record));
+        BOOST_REQUIRE_EQUAL(index_of(record), expected);
+    }
+
+    producer.join();
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer_queue__enqueue__multiple_producers__ordered_per_producer)
+{
+    static const auto producers = 4;
+    static const auto records = 1000;
+    test_queue<64> queue;
+    std::vector<std::thread> threads;
+
+    for (auto producer = 0; producer < producers; ++producer)
+        threads.emplace_back([&queue, producer]()
+        {
+            for (auto index = 0; index < records; ++index)
+                queue.enqueue(make_record(producer * records + index));
+        });
+
+    record_view record;
+    std::vector<int> expected(producers, 0);
+
+    for (auto count = 0; count < producers * records; ++count)
+    {
+        BOOST_REQUIRE(queue.dequeue_ready(record));
+        const auto index = index_of(record);
+        BOOST_REQUIRE_EQUAL(index % records, expected[index / records]++);
+    }
+
+    for (auto& thread: threads)
+        thread.join();
+
+    BOOST_REQUIRE_EQUAL(next(queue), -1);
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer_queue__dequeue_ready__interrupted__false)
+{
+    test_queue<4> queue;
+    record_view record;
+    queue.interrupt_dequeue();
+    BOOST_REQUIRE(!queue.dequeue_ready(record));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/make_shared.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::log;
+using namespace boost::asio::ip;
+
+BOOST_AUTO_TEST_SUITE(statsd_aggregator_tests)
+
+// Receives the packets sent by an aggregator over the loopback interface.
+class receiver
+{
+public:
+    receiver()
+      : socket_(service_, udp::endpoint(address_v4::loopback(), 0))
+    {
+    }
+
+    statsd_aggregator::ptr make_aggregator(threadpool& pool, size_t mtu)
+    {
+        const auto socket = boost::make_shared<udp::socket>(pool.service());
+        socket->open(udp::v4());
+        const auto endpoint = boost::make_shared<udp::endpoint>(
+            socket_.local_endpoint());
+        return boost::make_shared<statsd_aggregator>(pool, socket, endpoint,
+            asio::seconds(60), mtu);
+    }
+
+    // Wait for the packets that contain the expected number of lines.
+    std::vector<std::string> receive(size_t lines)
+    {
+        std::vector<std::string> packets;
+        const auto deadline = asio::steady_clock::now() + asio::seconds(5);
+        size_t received = 0;
+
+        while (received < lines && asio::steady_clock::now() < deadline)
+        {
+            if (socket_.available() == 0)
+            {
+                std::this_thread::sleep_for(asio::milliseconds(1));
+                continue;
+            }
+
+            std::string packet(socket_.available(), '\0');
+            udp::endpoint sender;
+            packet.resize(socket_.receive_from(
+                boost::asio::buffer(&packet[0], packet.size()), sender));
+            received += std::count(packet.begin(), packet.end(), '\n') + 1;
+            packets.push_back(packet);
+        }
+
+        return packets;
+    }
+
+private:
+    asio::service service_;
+    udp::socket socket_;
+};
+
+BOOST_AUTO_TEST_CASE(statsd_aggregator__flush__counters_and_gauges__merged)
+{
+    threadpool pool(1);
+    receiver server;
+    const auto aggregator = server.make_aggregator(pool, 1000);
+
+    aggregator->counter("a", 1);
+    aggregator->gauge("g", 5);
+
+    // Another thread's buffer, the counter is scaled by the sample rate.
+    std::thread([&aggregator]()
+    {
+        aggregator->counter("a", 2, 0.5f);
+        aggregator->gauge("g", 7);
+    }).join();
+
+    aggregator->flush();
+    const auto packets = server.receive(2);
+    BOOST_REQUIRE_EQUAL(packets.size(), 1u);
+    BOOST_REQUIRE_EQUAL(packets.front(), "a:5|c\ng:7|g");
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(statsd_aggregator__flush__timer__percentiles)
+{
+    threadpool pool(1);
+    receiver server;
+    const auto aggregator = server.make_aggregator(pool, 1000);
+
+    for (auto sample = 100; sample > 0; --sample)
+        aggregator->timer("t", asio::milliseconds(sample));
+
+    aggregator->flush();
+    const auto packets = server.receive(8);
+    BOOST_REQUIRE_EQUAL(packets.size(), 1u);
+    BOOST_REQUIRE_EQUAL(packets.front(),
+        "t.count:100|c\n"
+        "t.lower:1|g\n"
+        "t.upper:100|g\n"
+        "t.mean:50|g\n"
+        "t.p50:50|g\n"
+        "t.p90:90|g\n"
+        "t.p95:95|g\n"
+        "t.p99:99|g");
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(statsd_aggregator__flush__mtu__packed)
+{
+    threadpool pool(1);
+    receiver server;
+
+    // Two six byte lines and their delimiter fill a packet.
+    const auto aggregator = server.make_aggregator(pool, 13);
+
+    for (auto index = 0; index < 5; ++index)
+        aggregator->counter("c" + std::to_string(index), 1);
+
+    // A line that exceeds the mtu is sent alone.
+    aggregator->counter("oversized_counter", 1);
+
+    aggregator->flush();
+    const auto packets = server.receive(6);
+    BOOST_REQUIRE_EQUAL(packets.size(), 4u);
+    BOOST_REQUIRE_EQUAL(packets[0], "c0:1|c\nc1:1|c");
+    BOOST_REQUIRE_EQUAL(packets[1], "c2:1|c\nc3:1|c");
+    BOOST_REQUIRE_EQUAL(packets[2], "c4:1|c");
+    BOOST_REQUIRE_EQUAL(packets[3], "oversized_counter:1|c");
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(statsd_aggregator__destruct__started__flushed)
+{
+    threadpool pool(1);
+    receiver server;
+    auto aggregator = server.make_aggregator(pool, 1000);
+    const boost::weak_ptr<statsd_aggregator> weak = aggregator;
+
+    // The periodic flush does not keep the instance alive.
+    aggregator->start();
+    aggregator->counter("x", 1);
+    aggregator.reset();
+    BOOST_REQUIRE(weak.expired());
+
+    const auto packets = server.receive(1);
+    BOOST_REQUIRE_EQUAL(packets.size(), 1u);
+    BOOST_REQUIRE_EQUAL(packets.front(), "x:1|c");
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -172,4 +172,42 @@ BOOST_AUTO_TEST_CASE(elliptic_curve__ec_multiply_test)
     BOOST_REQUIRE(std::equal(public1.begin(), public1.end(), public2.begin()));
 }
 
+BOOST_AUTO_TEST_CASE(elliptic_curve__secret_to_public__list__matches_single)
+{
+    secret_list secrets;
+    for (size_t index = 0; index < 300; ++index)
+        secrets.push_back(bitcoin_hash(to_chunk(to_little_endian(index))));
+
+    point_list compressed;
+    uncompressed_list uncompressed;
+    BOOST_REQUIRE(secret_to_public(compressed, secrets));
+    BOOST_REQUIRE(secret_to_public(uncompressed, secrets, 3));
+    BOOST_REQUIRE_EQUAL(compressed.size(), secrets.size());
+    BOOST_REQUIRE_EQUAL(uncompressed.size(), secrets.size());
+
+    for (size_t index = 0; index < secrets.size(); ++index)
+    {
+        ec_compressed point;
+        ec_uncompressed full;
+        BOOST_REQUIRE(secret_to_public(point, secrets[index]));
+        BOOST_REQUIRE(secret_to_public(full, secrets[index]));
+        BOOST_REQUIRE(compressed[index] == point);
+        BOOST_REQUIRE(uncompressed[index] == full);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__secret_to_public__list_invalid_secret__false_null_point)
+{
+    ec_secret valid{ { 0 } };
+    valid[31] = 1;
+    const secret_list secrets{ valid, null_hash, valid };
+
+    point_list points;
+    BOOST_REQUIRE(!secret_to_public(points, secrets));
+    BOOST_REQUIRE_EQUAL(points.size(), 3u);
+    BOOST_REQUIRE(points[0] != null_compressed_point);
+    BOOST_REQUIRE(points[1] == null_compressed_point);
+    BOOST_REQUIRE(points[2] == points[0]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
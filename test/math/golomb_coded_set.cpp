@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(golomb_coded_set_tests)
+
+static const siphash_key key{ 0x0706050403020100, 0x0f0e0d0c0b0a0908 };
+static const uint8_t bits = 19;
+static const uint64_t rate = 784931;
+
+static data_stack make_items(uint32_t first, uint32_t count)
+{
+    data_stack items;
+    items.reserve(count);
+
+    for (auto index = first; index < first + count; ++index)
+        items.push_back(to_chunk(to_little_endian(index)));
+
+    return items;
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_construct__empty__empty)
+{
+    BOOST_REQUIRE(golomb_construct({}, bits, rate, key).empty());
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_construct__invalid_bits__empty)
+{
+    const auto items = make_items(0, 10);
+    BOOST_REQUIRE(golomb_construct(items, 0, rate, key).empty());
+    BOOST_REQUIRE(golomb_construct(items, 33, rate, key).empty());
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_construct__items__expected_size)
+{
+    // Each item is coded in about bits + 2 bits.
+    const auto items = make_items(0, 1000);
+    const auto set = golomb_construct(items, bits, rate, key);
+    BOOST_REQUIRE_GT(set.size(), 1000u * (bits + 1) / 8);
+    BOOST_REQUIRE_LT(set.size(), 1000u * (bits + 3) / 8);
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__members__true)
+{
+    const auto items = make_items(0, 1000);
+    const auto set = golomb_construct(items, bits, rate, key);
+
+    for (const auto& item: items)
+        BOOST_REQUIRE(golomb_match(set, items.size(), item, bits, rate, key));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__non_members__false)
+{
+    const auto items = make_items(0, 1000);
+    const auto set = golomb_construct(items, bits, rate, key);
+
+    for (const auto& item: make_items(1000, 1000))
+        BOOST_REQUIRE(!golomb_match(set, items.size(), item, bits, rate, key));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__small_bits__round_trips)
+{
+    // Few remainder bits produce long unary quotients.
+    const auto items = make_items(0, 100);
+    const auto set = golomb_construct(items, 1, 1000, key);
+
+    for (const auto& item: items)
+        BOOST_REQUIRE(golomb_match(set, items.size(), item, 1, 1000, key));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__wrong_key__false)
+{
+    const siphash_key other{ 42, 24 };
+    const auto items = make_items(0, 100);
+    const auto set = golomb_construct(items, bits, rate, key);
+    BOOST_REQUIRE(!golomb_match(set, items.size(), items, bits, rate, other));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__any__expected)
+{
+    const auto items = make_items(0, 1000);
+    const auto set = golomb_construct(items, bits, rate, key);
+    auto targets = make_items(5000, 100);
+    BOOST_REQUIRE(!golomb_match(set, items.size(), targets, bits, rate, key));
+
+    targets.push_back(items[500]);
+    BOOST_REQUIRE(golomb_match(set, items.size(), targets, bits, rate, key));
+    BOOST_REQUIRE(!golomb_match(set, items.size(), data_stack{}, bits, rate,
+        key));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__truncated__false)
+{
+    const auto items = make_items(0, 100);
+    auto set = golomb_construct(items, bits, rate, key);
+    set.resize(set.size() / 2);
+    BOOST_REQUIRE(!golomb_match(set, items.size(), make_items(1000, 10), bits,
+        rate, key));
+}
+
+// Queries each member of a set individually and as part of absent targets.
+BOOST_AUTO_TEST_CASE(golomb_coded_set__golomb_match__each_member__true)
+{
+    const auto items = make_items(0, 200);
+    const auto set = golomb_construct(items, bits, rate, key);
+
+    for (uint32_t index = 0; index < items.size(); index += 10)
+    {
+        auto targets = make_items(1000 + index, 9);
+        targets.push_back(items[index]);
+        BOOST_REQUIRE(golomb_match(set, items.size(), targets, bits, rate,
+            key));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
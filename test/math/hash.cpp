@@ -90,4 +90,102 @@ BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(scrypt_test)
+{
+    // RFC 7914 test vectors.
+    const auto empty = scrypt(data_chunk{}, data_chunk{}, 16, 1, 1, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(empty), "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+
+    const auto password = scrypt(to_chunk(std::string("password")), to_chunk(std::string("NaCl")), 1024, 16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(password), "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640");
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__threads__matches_single_thread)
+{
+    const auto data = to_chunk(std::string("password"));
+    const auto salt = to_chunk(std::string("NaCl"));
+    const auto single = scrypt(data, salt, 1024, 16, 8, 64, 1);
+    BOOST_REQUIRE(scrypt(data, salt, 1024, 16, 8, 64, 3) == single);
+    BOOST_REQUIRE(scrypt(data, salt, 1024, 16, 8, 64) == single);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__invalid_parameters__throws)
+{
+    const data_chunk data{ 'd', 'a', 't', 'a' };
+    BOOST_REQUIRE_THROW(scrypt(data, data, 1, 1, 1, 64), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt(data, data, 1000, 1, 1, 64), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt(data, data, 16, 0, 1, 64), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_80_test)
+{
+    // The genesis block header and its hash.
+    const auto header = base16_literal(
+        "0100000000000000000000000000000000000000000000000000000000000000"
+        "000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa"
+        "4b1e5e4a29ab5f49ffff001d1dac2b7c");
+    BOOST_REQUIRE(bitcoin_hash(header) == hash_literal(
+        "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"));
+
+    byte_array<80> message;
+    for (size_t index = 0; index < message.size(); ++index)
+    {
+        message[index] = static_cast<uint8_t>(index * 7);
+        BOOST_REQUIRE(bitcoin_hash(message) ==
+            bitcoin_hash(data_slice(message)));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(bitcoin_short_hashes_test)
+{
+    // Lengths span the one and two block sha256 tails of every lane.
+    data_stack data;
+    for (size_t length = 0; length <= 200; ++length)
+    {
+        data_chunk chunk(length);
+        for (size_t index = 0; index < length; ++index)
+            chunk[index] = static_cast<uint8_t>(length * 31 + index);
+
+        data.push_back(std::move(chunk));
+    }
+
+    // Every count of a partial group, including a single scalar input.
+    for (size_t count = 0; count <= 9; ++count)
+    {
+        const std::vector<data_slice> slices(data.rbegin(),
+            data.rbegin() + count);
+        const auto hashes = bitcoin_short_hashes(slices);
+        BOOST_REQUIRE_EQUAL(hashes.size(), count);
+
+        for (size_t index = 0; index < count; ++index)
+            BOOST_REQUIRE(hashes[index] == bitcoin_short_hash(slices[index]));
+    }
+
+    const std::vector<data_slice> slices(data.begin(), data.end());
+    const auto hashes = bitcoin_short_hashes(slices);
+    BOOST_REQUIRE_EQUAL(hashes.size(), slices.size());
+
+    for (size_t index = 0; index < slices.size(); ++index)
+        BOOST_REQUIRE(hashes[index] == bitcoin_short_hash(slices[index]));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_short_hashes_public_keys_test)
+{
+    static const size_t count = 100;
+
+    // Compressed public key sized inputs, as in address generation.
+    data_stack keys(count, data_chunk(ec_compressed_size, 0x02));
+    for (size_t index = 0; index < count; ++index)
+        std::copy_n(reinterpret_cast<const uint8_t*>(&index), sizeof(index),
+            keys[index].begin() + 1);
+
+    const std::vector<data_slice> slices(keys.begin(), keys.end());
+    short_hash_list scalar(count);
+    for (size_t index = 0; index < count; ++index)
+        scalar[index] = bitcoin_short_hash(slices[index]);
+
+    BOOST_REQUIRE(bitcoin_short_hashes(slices) == scalar);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(murmur3_tests)
+
+// Test vectors of the reference client (BIP37 hash function).
+#define MURMUR3_TEST(expected, seed, data) \
+    BOOST_REQUIRE_EQUAL(murmur3(to_chunk(base16_literal(data)), seed), \
+        expected##u)
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__empty__expected)
+{
+    BOOST_REQUIRE_EQUAL(murmur3(data_chunk{}, 0x00000000), 0x00000000u);
+    BOOST_REQUIRE_EQUAL(murmur3(data_chunk{}, 0xfba4c795), 0x6a396f08u);
+    BOOST_REQUIRE_EQUAL(murmur3(data_chunk{}, 0xffffffff), 0x81f16f39u);
+}
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__one_byte__expected)
+{
+    MURMUR3_TEST(0x514e28b7, 0x00000000, "00");
+    MURMUR3_TEST(0xea3f0b17, 0xfba4c795, "00");
+    MURMUR3_TEST(0xfd6cf10d, 0x00000000, "ff");
+}
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__multiple_bytes__expected)
+{
+    MURMUR3_TEST(0x16c6b7ab, 0x00000000, "0011");
+    MURMUR3_TEST(0x8eb51c3d, 0x00000000, "001122");
+    MURMUR3_TEST(0xb4471bf8, 0x00000000, "00112233");
+    MURMUR3_TEST(0xe2301fa8, 0x00000000, "0011223344");
+    MURMUR3_TEST(0xfc2e4a15, 0x00000000, "001122334455");
+    MURMUR3_TEST(0xb074502c, 0x00000000, "00112233445566");
+    MURMUR3_TEST(0x8034d2a0, 0x00000000, "0011223344556677");
+    MURMUR3_TEST(0xb4698def, 0x00000000, "001122334455667788");
+}
+
+#undef MURMUR3_TEST
+
+BOOST_AUTO_TEST_CASE(murmur3__murmur3__seeds__matches_single)
+{
+    // Not a multiple of the interleave, to exercise the remainder.
+    const auto data = to_chunk(base16_literal("001122334455667788"));
+    std::vector<uint32_t> seeds(13);
+    std::vector<uint32_t> hashes(seeds.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        seeds[index] = static_cast<uint32_t>(index) * 0xfba4c795 + 42;
+
+    murmur3(data, seeds.data(), hashes.data(), seeds.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        BOOST_REQUIRE_EQUAL(hashes[index], murmur3(data, seeds[index]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
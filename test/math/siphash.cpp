@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(siphash_tests)
+
+// Reference key 000102...0f.
+static const siphash_key key{ 0x0706050403020100, 0x0f0e0d0c0b0a0908 };
+
+static data_chunk sequence(size_t size)
+{
+    data_chunk out(size);
+
+    for (size_t index = 0; index < size; ++index)
+        out[index] = static_cast<uint8_t>(index);
+
+    return out;
+}
+
+static hash_digest sequence_hash(uint8_t start)
+{
+    hash_digest out;
+
+    for (size_t index = 0; index < out.size(); ++index)
+        out[index] = static_cast<uint8_t>(start + index);
+
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(siphash__to_siphash_key__sequence__little_endian)
+{
+    half_hash value;
+    std::copy_n(sequence(16).begin(), value.size(), value.begin());
+    BOOST_REQUIRE(to_siphash_key(value) == key);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__empty__reference_vector)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, data_chunk{}), 0x726fdb47dd0e0e31u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__fifteen_bytes__reference_vector)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, sequence(15)), 0xa129ca6149be45e5u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__hash__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, sequence_hash(0)), 0x7127512f72f27cceu);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__hash__matches_slice)
+{
+    const auto hash = sequence_hash(42);
+    BOOST_REQUIRE_EQUAL(siphash(key, hash), siphash(key, data_slice(hash)));
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__hash_list__matches_single)
+{
+    const hash_list hashes{ sequence_hash(0), sequence_hash(1), sequence_hash(2) };
+    const auto result = siphash(key, hashes);
+    BOOST_REQUIRE_EQUAL(result.size(), hashes.size());
+
+    for (size_t index = 0; index < hashes.size(); ++index)
+        BOOST_REQUIRE_EQUAL(result[index], siphash(key, hashes[index]));
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__key_list__matches_single)
+{
+    // Not a multiple of the interleave, to exercise the remainder.
+    siphash_key_list keys;
+
+    for (uint64_t index = 0; index < 11; ++index)
+        keys.emplace_back(key.first + index, key.second * index);
+
+    const auto hash = sequence_hash(7);
+    const auto result = siphash(keys, hash);
+    BOOST_REQUIRE_EQUAL(result.size(), keys.size());
+
+    for (size_t index = 0; index < keys.size(); ++index)
+        BOOST_REQUIRE_EQUAL(result[index], siphash(keys[index], hash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
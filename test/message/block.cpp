@@ -466,4 +466,46 @@ BOOST_AUTO_TEST_CASE(block__operator_boolean_not_equals_2__differs__returns_true
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(block__encode__repeated__returns_cached_encoding)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    const block instance(chain::block::genesis_mainnet());
+    const auto encoded = instance.encode(block::version_maximum, magic);
+    BOOST_REQUIRE(encoded);
+    BOOST_REQUIRE_EQUAL(encoded->magic(), magic);
+    BOOST_REQUIRE(encoded->data() == serialize(block::version_maximum, instance, magic));
+    BOOST_REQUIRE(to_chunk(encoded->payload()) == instance.to_data(block::version_maximum));
+    BOOST_REQUIRE(instance.encode(block::version_maximum, magic) == encoded);
+}
+
+BOOST_AUTO_TEST_CASE(block__encode__different_magic__reencodes)
+{
+    const block instance(chain::block::genesis_mainnet());
+    const auto mainnet = instance.encode(block::version_maximum, 0xd9b4bef9);
+    const auto testnet = instance.encode(block::version_maximum, 0x0709110b);
+    BOOST_REQUIRE(mainnet != testnet);
+    BOOST_REQUIRE_EQUAL(testnet->magic(), 0x0709110bu);
+}
+
+BOOST_AUTO_TEST_CASE(block__from_data__encoded__resets_encoding)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    block instance(chain::block::genesis_mainnet());
+    const auto encoded = instance.encode(block::version_maximum, magic);
+    const auto data = instance.to_data(block::version_maximum);
+    BOOST_REQUIRE(instance.from_data(block::version_maximum, data));
+    BOOST_REQUIRE(instance.encode(block::version_maximum, magic) != encoded);
+}
+
+BOOST_AUTO_TEST_CASE(block__set_encoding__received__returns_received_encoding)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    block instance(chain::block::genesis_mainnet());
+    const auto received = std::make_shared<const encoding>(
+        block::version_maximum, magic,
+        serialize(block::version_maximum, instance, magic));
+    instance.set_encoding(received);
+    BOOST_REQUIRE(instance.encode(block::version_maximum, magic) == received);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
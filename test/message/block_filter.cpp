@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(block_filter_tests)
+
+static chain::script pay_key_hash(uint32_t index)
+{
+    return chain::script::to_pay_key_hash_pattern(
+        bitcoin_short_hash(to_chunk(to_little_endian(index))));
+}
+
+// A transaction spending a populated previous output paid to index.
+static chain::transaction spend(uint32_t index)
+{
+    chain::transaction tx
+    {
+        1, 0,
+        { { { null_hash, index }, {}, 0 } },
+        { { 500, pay_key_hash(index + 1000000) } }
+    };
+
+    tx.inputs().front().previous_output().validation.cache =
+        chain::output(1000, pay_key_hash(index));
+    return tx;
+}
+
+static chain::block make_block(uint32_t count)
+{
+    chain::transaction::list txs;
+    txs.reserve(count);
+
+    for (uint32_t index = 0; index < count; ++index)
+        txs.push_back(spend(index));
+
+    return { chain::header(), std::move(txs) };
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__constructor_1__always__invalid)
+{
+    const block_filter instance;
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(!instance.match(data_chunk{ 0x42 }));
+}
+
+// Test vector of BIP158 (testnet genesis block).
+BOOST_AUTO_TEST_CASE(block_filter__constructor_3__genesis_testnet__expected)
+{
+    const auto genesis = chain::block::genesis_testnet();
+    const block_filter instance(genesis);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(encode_base16(instance.data()), "019dfca8");
+    BOOST_REQUIRE(instance.header(null_hash) == hash_literal(
+        "21584579b7eb08997773e5aeff3a7f932700042d0ed2a6129012b7d7ae81b750"));
+
+    const auto& output = genesis.transactions().front().outputs().front();
+    BOOST_REQUIRE(instance.match(output.script().to_data(false)));
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__constructor_3__missing_previous_output__invalid)
+{
+    auto tx = spend(0);
+    tx.inputs().front().previous_output().validation.cache = chain::output{};
+    const chain::block block(chain::header(), { tx });
+    const block_filter instance(block);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__constructor_3__block__matches_scripts)
+{
+    const auto null_data = chain::script(
+        chain::script::to_null_data_pattern(data_chunk{ 0x42 }));
+    auto txs = make_block(10).transactions();
+    txs.front().outputs().push_back({ 0, null_data });
+    const block_filter instance(chain::block(chain::header(), std::move(txs)));
+
+    // Each output script and each previous output script, distinct.
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.size(), 20u);
+    BOOST_REQUIRE(instance.match(pay_key_hash(0).to_data(false)));
+    BOOST_REQUIRE(instance.match(pay_key_hash(1000009).to_data(false)));
+    BOOST_REQUIRE(!instance.match(pay_key_hash(10).to_data(false)));
+    BOOST_REQUIRE(!instance.match(null_data.to_data(false)));
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__constructor_2__serialized__matches)
+{
+    const auto block = make_block(10);
+    const block_filter built(block);
+    const block_filter instance(block.hash(), built.data());
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.size(), built.size());
+    BOOST_REQUIRE(instance.hash() == built.hash());
+
+    const data_stack none{ pay_key_hash(10).to_data(false),
+        pay_key_hash(11).to_data(false) };
+    const data_stack some{ pay_key_hash(10).to_data(false),
+        pay_key_hash(5).to_data(false) };
+    BOOST_REQUIRE(!instance.match(none));
+    BOOST_REQUIRE(instance.match(some));
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__constructor_2__empty_data__invalid)
+{
+    const block_filter instance(null_hash, data_chunk{});
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__constructor_2__wrong_block_hash__no_match)
+{
+    const auto block = make_block(10);
+    const block_filter built(block);
+    const block_filter instance(null_hash, built.data());
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.match(pay_key_hash(5).to_data(false)));
+}
+
+BOOST_AUTO_TEST_CASE(block_filter__to_headers__chain__expected)
+{
+    const hash_list hashes
+    {
+        bitcoin_hash(data_chunk{ 0x01 }),
+        bitcoin_hash(data_chunk{ 0x02 }),
+        bitcoin_hash(data_chunk{ 0x03 })
+    };
+    const auto headers = block_filter::to_headers(hashes, null_hash);
+    BOOST_REQUIRE_EQUAL(headers.size(), 3u);
+    BOOST_REQUIRE(headers[0] == block_filter::to_header(hashes[0], null_hash));
+    BOOST_REQUIRE(headers[1] == block_filter::to_header(hashes[1], headers[0]));
+    BOOST_REQUIRE(headers[2] == block_filter::to_header(hashes[2], headers[1]));
+}
+
+// Builds the filter of a block and queries it with wallets.
+BOOST_AUTO_TEST_CASE(block_filter__constructor_3__block__matches_wallet)
+{
+    static const uint32_t transactions = 50;
+
+    const block_filter instance(make_block(transactions));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u * transactions);
+
+    data_stack wallet;
+    for (uint32_t index = 0; index < 20; ++index)
+        wallet.push_back(pay_key_hash(transactions + index).to_data(false));
+
+    BOOST_REQUIRE(!instance.match(wallet));
+
+    wallet.push_back(pay_key_hash(transactions - 1).to_data(false));
+    BOOST_REQUIRE(instance.match(wallet));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
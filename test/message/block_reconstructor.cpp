@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(block_reconstructor_tests)
+
+static const uint64_t nonce = 0x0123456789abcdef;
+
+static transaction::const_ptr_list make_pool(size_t count)
+{
+    transaction::const_ptr_list pool;
+    pool.reserve(count);
+
+    // Distinct by lock time, small and quick to hash.
+    for (size_t index = 0; index < count; ++index)
+        pool.push_back(std::make_shared<const transaction>(
+            chain::transaction(1, static_cast<uint32_t>(index), {}, {})));
+
+    return pool;
+}
+
+// A coinbase followed by every step'th transaction of the pool.
+static chain::block make_block(const transaction::const_ptr_list& pool,
+    size_t step)
+{
+    chain::transaction::list transactions;
+    transactions.push_back(chain::transaction(2, 0, {}, {}));
+
+    for (size_t index = 0; index < pool.size(); index += step)
+        transactions.push_back(*pool[index]);
+
+    chain::block block(chain::header(), std::move(transactions));
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__compact_block__block__coinbase_prefilled)
+{
+    const auto block = make_block(make_pool(10), 1);
+    const compact_block compact(block, nonce);
+    BOOST_REQUIRE(compact.is_valid());
+    BOOST_REQUIRE_EQUAL(compact.transactions().size(), 1u);
+    BOOST_REQUIRE_EQUAL(compact.transactions().front().index(), 0u);
+    BOOST_REQUIRE_EQUAL(compact.short_ids().size(), 10u);
+
+    const auto key = compact.short_id_key();
+    const auto& transactions = block.transactions();
+    BOOST_REQUIRE(compact.short_ids()[3] == compact_block::to_short_id(key,
+        transactions[4].hash()));
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__all_candidates__complete)
+{
+    const auto pool = make_pool(100);
+    const auto block = make_block(pool, 3);
+    block_reconstructor instance(compact_block(block, nonce));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.is_complete());
+    BOOST_REQUIRE_EQUAL(instance.fill(pool), block.transactions().size() - 1);
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(instance.missing().indexes().empty());
+
+    chain::block out;
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__missing_candidates__requests_and_fills)
+{
+    const auto pool = make_pool(20);
+    const auto block = make_block(pool, 1);
+
+    // Omit pool entries 4, 5 and 12 (block positions 5, 6 and 13).
+    transaction::const_ptr_list candidates;
+    for (size_t index = 0; index < pool.size(); ++index)
+        if (index != 4 && index != 5 && index != 12)
+            candidates.push_back(pool[index]);
+
+    block_reconstructor instance(compact_block(block, nonce));
+    BOOST_REQUIRE_EQUAL(instance.fill(candidates), 17u);
+    BOOST_REQUIRE_EQUAL(instance.missing_count(), 3u);
+
+    chain::block out;
+    BOOST_REQUIRE(!instance.to_block(out));
+
+    // Indexes are differentially encoded.
+    const auto request = instance.missing();
+    BOOST_REQUIRE(request.block_hash() == block.hash());
+    BOOST_REQUIRE(request.indexes() == (std::vector<uint64_t>{ 5, 0, 6 }));
+
+    const auto& transactions = block.transactions();
+    const block_transactions response(block.hash(),
+    {
+        transactions[5], transactions[6], transactions[13]
+    });
+
+    BOOST_REQUIRE(instance.fill(response));
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__response_wrong_size__false)
+{
+    const auto pool = make_pool(4);
+    const auto block = make_block(pool, 1);
+    block_reconstructor instance(compact_block(block, nonce));
+    const block_transactions response(block.hash(), { *pool[0] });
+    BOOST_REQUIRE(!instance.fill(response));
+    BOOST_REQUIRE_EQUAL(instance.missing_count(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__response_wrong_block__false)
+{
+    const auto pool = make_pool(1);
+    const auto block = make_block(pool, 1);
+    block_reconstructor instance(compact_block(block, nonce));
+    const block_transactions response(null_hash, { *pool[0] });
+    BOOST_REQUIRE(!instance.fill(response));
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__constructor__duplicate_short_ids__invalid)
+{
+    const auto block = make_block(make_pool(2), 1);
+    compact_block compact(block, nonce);
+    compact.short_ids()[1] = compact.short_ids()[0];
+    block_reconstructor instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.fill(make_pool(2)), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__constructor__prefilled_out_of_range__invalid)
+{
+    const auto block = make_block(make_pool(2), 1);
+    compact_block compact(block, nonce);
+    compact.transactions().front() = prefilled_transaction(3,
+        block.transactions().front());
+    block_reconstructor instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__to_block__wrong_merkle_root__false)
+{
+    const auto pool = make_pool(5);
+    auto block = make_block(pool, 1);
+    block.header().set_merkle(null_hash);
+    block_reconstructor instance(compact_block(block, nonce));
+    instance.fill(pool);
+    BOOST_REQUIRE(instance.is_complete());
+
+    chain::block out;
+    BOOST_REQUIRE(!instance.to_block(out));
+}
+
+// These lock times produce colliding short ids under the default header.
+static const uint32_t collision1 = 18230854;
+static const uint32_t collision2 = 29082813;
+
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__collision__slot_emptied)
+{
+    const auto first = std::make_shared<const transaction>(
+        chain::transaction(1, collision1, {}, {}));
+    const auto second = std::make_shared<const transaction>(
+        chain::transaction(1, collision2, {}, {}));
+    const auto other = std::make_shared<const transaction>(
+        chain::transaction(1, 0, {}, {}));
+
+    const chain::header header;
+    const auto key = compact_block(header, nonce, {}, {}).short_id_key();
+    const auto id = compact_block::to_short_id(key, first->hash());
+    BOOST_REQUIRE(id == compact_block::to_short_id(key, second->hash()));
+
+    const compact_block::short_id_list ids
+    {
+        id, compact_block::to_short_id(key, other->hash())
+    };
+
+    // Distinct candidates of one call.
+    block_reconstructor same(compact_block(header, nonce, ids, {}));
+    BOOST_REQUIRE(same.is_valid());
+    BOOST_REQUIRE_EQUAL(same.fill({ first, second }), 0u);
+    BOOST_REQUIRE_EQUAL(same.missing_count(), 2u);
+
+    // A slot filled by a prior call is emptied, not counted as filled.
+    block_reconstructor prior(compact_block(header, nonce, ids, {}));
+    BOOST_REQUIRE_EQUAL(prior.fill({ first }), 1u);
+    BOOST_REQUIRE_EQUAL(prior.missing_count(), 1u);
+    BOOST_REQUIRE_EQUAL(prior.fill({ second }), 0u);
+    BOOST_REQUIRE_EQUAL(prior.missing_count(), 2u);
+
+    // The ambiguous slot remains to be requested.
+    BOOST_REQUIRE_EQUAL(prior.fill({ first, other }), 1u);
+    BOOST_REQUIRE_EQUAL(prior.missing_count(), 1u);
+    BOOST_REQUIRE(prior.missing().indexes() == (std::vector<uint64_t>{ 0 }));
+}
+
+// Reconstructs a block from a memory pool much larger than the block.
+BOOST_AUTO_TEST_CASE(block_reconstructor__fill__sparse_memory_pool__complete)
+{
+    const auto pool = make_pool(1000);
+    const auto block = make_block(pool, 10);
+    block_reconstructor instance(compact_block(block, nonce));
+    BOOST_REQUIRE_EQUAL(instance.fill(pool), block.transactions().size() - 1);
+    BOOST_REQUIRE(instance.is_complete());
+
+    chain::block out;
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+static const auto element1 = to_chunk(base16_literal("99108ad8ed9bb6274d3980bab5a85c048f0950c8"));
+static const auto element2 = to_chunk(base16_literal("b5a2c786d9ef4658287ced5914b37a1b4aa32eee"));
+static const auto element3 = to_chunk(base16_literal("b9300670b4c5366e95b2699e8b18bc75e5f729c5"));
+
+static chain::transaction pay_key_hash(const short_hash& hash,
+    uint32_t lock_time)
+{
+    return
+    {
+        1, lock_time,
+        { { { null_hash, 0 }, {}, 0 } },
+        { { 1000, chain::script(chain::script::to_pay_key_hash_pattern(hash)) } }
+    };
+}
+
+static chain::transaction spend(const chain::transaction& previous)
+{
+    return
+    {
+        1, 0,
+        { { { previous.hash(), 0 }, {}, 0 } },
+        { { 500, chain::script(chain::script::to_pay_key_hash_pattern(null_short_hash)) } }
+    };
+}
+
+// Serialization vectors of the reference client.
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor__elements__expected)
+{
+    bloom_filter instance(3, 0.01, 0, bloom_filter::update::all);
+    instance.insert(element1);
+    BOOST_REQUIRE(instance.contains(element1));
+    BOOST_REQUIRE(!instance.contains(to_chunk(base16_literal("19108ad8ed9bb6274d3980bab5a85c048f0950c8"))));
+    instance.insert(element2);
+    BOOST_REQUIRE(instance.contains(element2));
+    instance.insert(element3);
+    BOOST_REQUIRE(instance.contains(element3));
+
+    const auto load = instance.to_filter_load();
+    BOOST_REQUIRE_EQUAL(encode_base16(load.to_data(version::level::maximum)),
+        "03614e9b050000000000000001");
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor__tweak__expected)
+{
+    bloom_filter instance(3, 0.01, 2147483649u, bloom_filter::update::all);
+    instance.insert(element1);
+    instance.insert(element2);
+    instance.insert(element3);
+
+    const auto load = instance.to_filter_load();
+    BOOST_REQUIRE_EQUAL(encode_base16(load.to_data(version::level::maximum)),
+        "03ce4299050000000100008001");
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor__filter_load__round_trips)
+{
+    bloom_filter original(10, 0.001, 42, bloom_filter::update::p2pubkey_only);
+    original.insert(element1);
+
+    const bloom_filter instance(original.to_filter_load());
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.data() == original.data());
+    BOOST_REQUIRE_EQUAL(instance.hash_functions(), original.hash_functions());
+    BOOST_REQUIRE_EQUAL(instance.tweak(), 42u);
+    BOOST_REQUIRE(instance.contains(element1));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor__default__matches_nothing)
+{
+    bloom_filter instance;
+    instance.insert(element1);
+    BOOST_REQUIRE(!instance.contains(element1));
+    BOOST_REQUIRE(!instance.match(chain::block::genesis_mainnet().transactions().front()));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__add__oversized__false)
+{
+    bloom_filter instance(10, 0.001, 0, bloom_filter::update::none);
+    BOOST_REQUIRE(!instance.add(filter_add(data_chunk(max_filter_add + 1))));
+    BOOST_REQUIRE(instance.add(filter_add(element1)));
+    BOOST_REQUIRE(instance.contains(element1));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__transaction_hash__true)
+{
+    const auto tx = pay_key_hash(null_short_hash, 1);
+    bloom_filter instance(10, 0.000001, 0, bloom_filter::update::none);
+    BOOST_REQUIRE(!instance.match(tx));
+    instance.insert(tx.hash());
+    BOOST_REQUIRE(instance.match(tx));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__output_push_update_all__matches_spend)
+{
+    short_hash hash;
+    std::copy_n(element1.begin(), hash.size(), hash.begin());
+    const auto payment = pay_key_hash(hash, 1);
+    const auto spender = spend(payment);
+
+    bloom_filter instance(10, 0.000001, 0, bloom_filter::update::all);
+    instance.insert(element1);
+    BOOST_REQUIRE(!instance.match(spender));
+    BOOST_REQUIRE(instance.match(payment));
+    BOOST_REQUIRE(instance.contains(chain::point{ payment.hash(), 0 }));
+    BOOST_REQUIRE(instance.match(spender));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__output_push_update_none__does_not_match_spend)
+{
+    short_hash hash;
+    std::copy_n(element1.begin(), hash.size(), hash.begin());
+    const auto payment = pay_key_hash(hash, 1);
+
+    bloom_filter instance(10, 0.000001, 0, bloom_filter::update::none);
+    instance.insert(element1);
+    BOOST_REQUIRE(instance.match(payment));
+    BOOST_REQUIRE(!instance.match(spend(payment)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__output_push_p2pubkey_only__does_not_update_key_hash)
+{
+    short_hash hash;
+    std::copy_n(element1.begin(), hash.size(), hash.begin());
+    const auto payment = pay_key_hash(hash, 1);
+
+    bloom_filter instance(10, 0.000001, 0, bloom_filter::update::p2pubkey_only);
+    instance.insert(element1);
+    BOOST_REQUIRE(instance.match(payment));
+    BOOST_REQUIRE(!instance.contains(chain::point{ payment.hash(), 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__block__updates_within_block)
+{
+    short_hash hash;
+    std::copy_n(element1.begin(), hash.size(), hash.begin());
+    const auto payment = pay_key_hash(hash, 1);
+    const auto other = pay_key_hash(null_short_hash, 2);
+    const chain::block block(chain::header(), { other, payment, spend(payment) });
+
+    bloom_filter instance(10, 0.000001, 0, bloom_filter::update::all);
+    instance.insert(element1);
+    BOOST_REQUIRE(instance.match(block) == (std::vector<bool>{ false, true, true }));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__merkle_block__genesis_matched__single_hash)
+{
+    const auto genesis = chain::block::genesis_mainnet();
+    const merkle_block instance(genesis, { true });
+    BOOST_REQUIRE_EQUAL(instance.total_transactions(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 1u);
+    BOOST_REQUIRE(instance.hashes().front() == genesis.header().merkle());
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x01 });
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__merkle_block__three_last_matched__expected)
+{
+    const chain::block block(chain::header(),
+    {
+        pay_key_hash(null_short_hash, 1),
+        pay_key_hash(null_short_hash, 2),
+        pay_key_hash(null_short_hash, 3)
+    });
+
+    const auto& txs = block.transactions();
+    const merkle_block instance(block, { false, false, true });
+    BOOST_REQUIRE_EQUAL(instance.total_transactions(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 2u);
+    BOOST_REQUIRE(instance.hashes()[0] == bitcoin_hash(build_chunk({ txs[0].hash(), txs[1].hash() })));
+    BOOST_REQUIRE(instance.hashes()[1] == txs[2].hash());
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x0d });
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__merkle_block__mismatched_flags__invalid)
+{
+    const auto genesis = chain::block::genesis_mainnet();
+    const merkle_block instance(genesis, { true, false });
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor__excess_hash_functions__invalid)
+{
+    const filter_load message({ 0xff }, max_uint32, 0, bloom_filter::update::none);
+    const bloom_filter instance(message);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.hash_functions(), max_filter_functions + 1);
+    BOOST_REQUIRE(!instance.contains(data_chunk{ 0x42 }));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor__maximum_hash_functions__valid)
+{
+    const filter_load message({ 0xff }, max_filter_functions, 0, bloom_filter::update::none);
+    const bloom_filter instance(message);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.contains(data_chunk{ 0x42 }));
+}
+
+// Matches a block against several peer filters.
+BOOST_AUTO_TEST_CASE(bloom_filter__match__block_peers__expected)
+{
+    static const size_t peers = 4;
+    static const size_t transactions = 20;
+
+    chain::transaction::list txs;
+    txs.reserve(transactions);
+
+    for (uint32_t index = 0; index < transactions; ++index)
+        txs.push_back(pay_key_hash(bitcoin_short_hash(to_chunk(
+            to_little_endian(index))), index));
+
+    const chain::block block(chain::header(), std::move(txs));
+    std::vector<bloom_filter> filters;
+
+    for (uint32_t peer = 0; peer < peers; ++peer)
+    {
+        filters.emplace_back(10, 0.0001, peer, bloom_filter::update::all);
+        filters.back().insert(bitcoin_short_hash(to_chunk(
+            to_little_endian(peer))));
+    }
+
+    for (uint32_t peer = 0; peer < peers; ++peer)
+    {
+        // Each peer matches at least its own payment.
+        const auto matches = filters[peer].match(block);
+        BOOST_REQUIRE_EQUAL(matches.size(), transactions);
+        BOOST_REQUIRE(matches[peer]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
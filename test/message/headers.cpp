@@ -742,4 +742,119 @@ BOOST_AUTO_TEST_CASE(headers__is_sequential__disordered__false)
     BOOST_REQUIRE(!instance.is_sequential());
 }
 
+// Mainnet blocks 1 and 2.
+static const header block1
+{
+    1u,
+    hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"),
+    hash_literal("0e3e2357e806b6cdb1f70b54c3a3a17b6714ee1f0e68bebb44a74b1efd512098"),
+    1231469665u,
+    0x1d00ffff,
+    2573394689u
+};
+
+static const header block2
+{
+    1u,
+    hash_literal("00000000839a8e6886ab5951d76f411475428afc90947ee320161bbf18eb6048"),
+    hash_literal("9b0fc92260312ce44e74ef369f5c66bbb85848f2eddd5a7a1cde251e54ccfdd5"),
+    1231469744u,
+    0x1d00ffff,
+    1639830024u
+};
+
+// The mainnet chain state of block 1.
+static chain::chain_state::ptr block1_state()
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    const auto genesis = chain::block::genesis_mainnet().header();
+
+    chain::chain_state::data data;
+    data.height = 1;
+    data.hash = block1.hash();
+    data.allow_collisions_hash = null_hash;
+    data.bip9_bit0_hash = null_hash;
+    data.bits.self = block1.bits();
+    data.bits.ordered = { genesis.bits() };
+    data.version.self = block1.version();
+    data.version.ordered = { genesis.version() };
+    data.timestamp.self = block1.timestamp();
+    data.timestamp.retarget = genesis.timestamp();
+    data.timestamp.ordered = { genesis.timestamp() };
+    return std::make_shared<chain::chain_state>(std::move(data), checkpoints,
+        machine::rule_fork::no_rules);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__empty__success)
+{
+    const headers instance;
+    BOOST_REQUIRE_EQUAL(instance.check(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__mainnet__success)
+{
+    const headers instance({ chain::block::genesis_mainnet().header(), block1,
+        block2 });
+    BOOST_REQUIRE_EQUAL(instance.check(), error::success);
+    BOOST_REQUIRE(instance.elements()[2].hash() == hash_literal(
+        "000000006a625f06636b8bb6ac7b960a8d03705d1ace08b1a19da3fdcc99ddbd"));
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__unlinked__invalid_previous_block)
+{
+    const headers instance({ block2, block1 });
+    BOOST_REQUIRE_EQUAL(instance.check(), error::invalid_previous_block);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__invalid_nonce__invalid_proof_of_work)
+{
+    auto invalid = block2;
+    invalid.set_nonce(42);
+    const headers instance({ block1, invalid });
+    BOOST_REQUIRE_EQUAL(instance.check(), error::invalid_proof_of_work);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__excess_bits__invalid_proof_of_work)
+{
+    auto invalid = block1;
+    invalid.set_bits(0x1e00ffff);
+    const headers instance({ invalid });
+    BOOST_REQUIRE_EQUAL(instance.check(), error::invalid_proof_of_work);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__many__expected)
+{
+    // Enough headers to be checked on multiple threads, the last invalid.
+    header::list elements(2000, block1);
+    elements.back().set_nonce(42);
+    const headers instance(std::move(elements));
+    BOOST_REQUIRE_EQUAL(instance.check(), error::invalid_proof_of_work);
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept__null_parent__operation_failed)
+{
+    const headers instance({ block2 });
+    BOOST_REQUIRE_EQUAL(instance.accept(nullptr), error::operation_failed);
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept__mainnet__success_with_state)
+{
+    const headers instance({ block2 });
+    BOOST_REQUIRE_EQUAL(instance.accept(block1_state()), error::success);
+
+    const auto& validation = instance.elements().front().validation;
+    BOOST_REQUIRE(validation.state);
+    BOOST_REQUIRE_EQUAL(validation.height, 2u);
+    BOOST_REQUIRE_EQUAL(validation.state->height(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__accept__incorrect_bits__incorrect_proof_of_work)
+{
+    auto invalid = block2;
+    invalid.set_bits(0x1c00ffff);
+    const headers instance({ invalid });
+    BOOST_REQUIRE_EQUAL(instance.accept(block1_state()),
+        error::incorrect_proof_of_work);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
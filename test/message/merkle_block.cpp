@@ -624,4 +624,170 @@ BOOST_AUTO_TEST_CASE(merkle_block__operator_boolean_not_equals__differs__returns
     BOOST_REQUIRE(instance != expected);
 }
 
+// Partial merkle tree.
+//-----------------------------------------------------------------------------
+
+// A block of count distinct transactions with a valid merkle root.
+static chain::block make_block(size_t count)
+{
+    chain::transaction::list txs;
+    txs.reserve(count);
+
+    for (uint32_t index = 0; index < count; ++index)
+        txs.push_back({ 1, index, { { { null_hash, index }, {}, 0 } }, {} });
+
+    chain::block block(chain::header(), std::move(txs));
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__default__false)
+{
+    const message::merkle_block instance;
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+    BOOST_REQUIRE(matches.empty());
+    BOOST_REQUIRE(positions.empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__round_trip__expected_matches)
+{
+    for (size_t count = 1; count <= 33; ++count)
+    {
+        const auto block = make_block(count);
+        const auto& txs = block.transactions();
+
+        // Exercise none, all, the edges and a sparse pattern of matches.
+        for (size_t pattern = 0; pattern < 5; ++pattern)
+        {
+            std::vector<bool> flags(count);
+            for (size_t index = 0; index < count; ++index)
+                flags[index] = pattern == 1 ||
+                    (pattern == 2 && index == 0) ||
+                    (pattern == 3 && index == count - 1) ||
+                    (pattern == 4 && index % 3 == 1);
+
+            const message::merkle_block instance(block, flags);
+            BOOST_REQUIRE(instance.is_valid());
+
+            hash_list matches;
+            std::vector<size_t> positions;
+            BOOST_REQUIRE(instance.extract(matches, positions));
+            BOOST_REQUIRE_EQUAL(matches.size(), positions.size());
+
+            size_t match = 0;
+            for (size_t index = 0; index < count; ++index)
+            {
+                if (!flags[index])
+                    continue;
+
+                BOOST_REQUIRE_LT(match, matches.size());
+                BOOST_REQUIRE_EQUAL(positions[match], index);
+                BOOST_REQUIRE(matches[match] == txs[index].hash());
+                ++match;
+            }
+
+            BOOST_REQUIRE_EQUAL(match, matches.size());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__round_trip_serialized__expected_matches)
+{
+    const auto block = make_block(7);
+    const message::merkle_block built(block,
+        { false, true, false, false, false, true, false });
+
+    const auto data = built.to_data(message::version::level::maximum);
+    const auto instance = message::merkle_block::factory(
+        message::version::level::maximum, data);
+
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(instance.extract(matches, positions));
+    BOOST_REQUIRE(positions == (std::vector<size_t>{ 1, 5 }));
+    BOOST_REQUIRE(matches[0] == block.transactions()[1].hash());
+    BOOST_REQUIRE(matches[1] == block.transactions()[5].hash());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__tampered_hash__false)
+{
+    const auto block = make_block(10);
+    message::merkle_block instance(block,
+        { false, false, true, false, false, false, false, false, false, true });
+
+    instance.hashes()[0][0] ^= 0x01;
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+    BOOST_REQUIRE(matches.empty());
+    BOOST_REQUIRE(positions.empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__extra_hash__false)
+{
+    const auto block = make_block(10);
+    message::merkle_block instance(block,
+        { false, false, true, false, false, false, false, false, false, true });
+
+    instance.hashes().push_back(null_hash);
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__extra_flag_byte__false)
+{
+    const auto block = make_block(10);
+    message::merkle_block instance(block,
+        { false, false, true, false, false, false, false, false, false, true });
+
+    instance.flags().push_back(0x00);
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__duplicate_siblings__false)
+{
+    // Duplicating the last of an odd count of leaves produces the same root
+    // (CVE-2012-2459), which must not verify.
+    const auto block = make_block(3);
+    const auto& txs = block.transactions();
+    const message::merkle_block instance(block.header(), 4u,
+    {
+        txs[0].hash(), txs[1].hash(), txs[2].hash(), txs[2].hash()
+    }, { 0x7f });
+
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+}
+
+// Builds and verifies a partial tree of a block with an odd leaf count.
+BOOST_AUTO_TEST_CASE(merkle_block__extract__sparse_matches__expected)
+{
+    static const size_t transactions = 101;
+
+    const auto block = make_block(transactions);
+    std::vector<bool> flags(transactions);
+    for (size_t index = 0; index < transactions; index += 7)
+        flags[index] = true;
+
+    const message::merkle_block instance(block, flags);
+    hash_list matches;
+    std::vector<size_t> positions;
+    BOOST_REQUIRE(instance.extract(matches, positions));
+    BOOST_REQUIRE_EQUAL(matches.size(), (transactions + 6) / 7);
+    BOOST_REQUIRE_EQUAL(positions.size(), matches.size());
+
+    const auto& txs = block.transactions();
+    for (size_t index = 0; index < positions.size(); ++index)
+    {
+        BOOST_REQUIRE_EQUAL(positions[index], index * 7);
+        BOOST_REQUIRE(matches[index] == txs[index * 7].hash());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -47,4 +47,132 @@ BOOST_AUTO_TEST_CASE(messages__variable_uint_size__eight_byte__expected)
     BOOST_REQUIRE_EQUAL(message::variable_uint_size(value), 9u);
 }
 
+static const uint32_t magic = 0xd9b4bef9;
+static const uint32_t protocol = message::version::level::maximum;
+
+static message::inventory large_inventory()
+{
+    hash_list hashes(1000);
+
+    for (size_t index = 0; index < hashes.size(); ++index)
+        hashes[index] = bitcoin_hash(to_little_endian(index));
+
+    return { hashes, message::inventory::type_id::transaction };
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__block__expected)
+{
+    const message::block genesis(chain::block::genesis_mainnet());
+    const auto data = message::serialize(protocol, genesis, magic);
+    BOOST_REQUIRE_EQUAL(data.size(), message::heading::satoshi_fixed_size() +
+        genesis.serialized_size(protocol));
+
+    message::heading head;
+    BOOST_REQUIRE(head.from_data(data));
+    BOOST_REQUIRE_EQUAL(head.magic(), magic);
+    BOOST_REQUIRE_EQUAL(head.command(), message::block::command);
+
+    message::block copy;
+    const data_chunk payload(data.begin() + 24, data.end());
+    BOOST_REQUIRE(copy.from_data(protocol, payload));
+    BOOST_REQUIRE(copy == genesis);
+    BOOST_REQUIRE_EQUAL(head.checksum(), bitcoin_checksum(payload));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__buffer_writer_block__matches_contiguous)
+{
+    buffer_pool pool(64);
+    buffer_writer sink(pool);
+    const message::block genesis(chain::block::genesis_mainnet());
+    message::serialize(protocol, genesis, magic, sink);
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_GT(sink.buffers().size(), 1u);
+    BOOST_REQUIRE(sink.to_data() == message::serialize(protocol, genesis, magic));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__buffer_writer_appended__matches_contiguous)
+{
+    buffer_pool pool(100);
+    buffer_writer sink(pool);
+    const message::ping ping(42);
+    const message::block genesis(chain::block::genesis_mainnet());
+    message::serialize(protocol, ping, magic, sink);
+    message::serialize(protocol, genesis, magic, sink);
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE(sink.to_data() == build_chunk(
+    {
+        message::serialize(protocol, ping, magic),
+        message::serialize(protocol, genesis, magic)
+    }));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__buffer_writer_inventory__buffer_sequence_matches_contiguous)
+{
+    buffer_pool pool;
+    buffer_writer sink(pool);
+    const auto inventory = large_inventory();
+    message::serialize(protocol, inventory, magic, sink);
+    const auto expected = message::serialize(protocol, inventory, magic);
+
+    data_chunk gathered(sink.size());
+    const auto buffers = sink.buffers();
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_size(buffers), expected.size());
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_copy(boost::asio::buffer(gathered),
+        buffers), expected.size());
+    BOOST_REQUIRE(gathered == expected);
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__buffer_writer_inventory__reuses_pool)
+{
+    const auto inventory = large_inventory();
+    buffer_pool pool;
+
+    {
+        buffer_writer sink(pool);
+        message::serialize(protocol, inventory, magic, sink);
+        BOOST_REQUIRE(sink);
+    }
+
+    // All buffers of the message were returned for reuse.
+    BOOST_REQUIRE_GT(pool.available(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__version_below_bip37__expected_size)
+{
+    message::version instance;
+    instance.set_value(message::version::level::bip37);
+    instance.set_relay(true);
+
+    // The relay flag is not serialized below the negotiated bip37 version.
+    const auto version = message::version::level::bip37 - 1u;
+    const auto data = message::serialize(version, instance, magic);
+    BOOST_REQUIRE_EQUAL(data.size(), message::heading::satoshi_fixed_size() +
+        instance.serialized_size(version));
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(version) + 1u,
+        instance.serialized_size(message::version::level::bip37));
+}
+
+// A message that writes more than its serialized size.
+struct oversized
+{
+    static const std::string command;
+
+    size_t serialized_size(uint32_t) const
+    {
+        return 1;
+    }
+
+    void to_data(uint32_t, writer& sink) const
+    {
+        sink.write_4_bytes_little_endian(42);
+    }
+};
+
+const std::string oversized::command = "oversized";
+
+BOOST_AUTO_TEST_CASE(messages__serialize__oversized_payload__empty)
+{
+    BOOST_REQUIRE(message::serialize(protocol, oversized(), magic).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
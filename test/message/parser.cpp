@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(parser_tests)
+
+static const uint32_t magic = 0xd9b4bef9;
+static const uint32_t protocol = version::level::maximum;
+
+static data_chunk ping_message(uint64_t nonce)
+{
+    return serialize(protocol, ping(nonce), magic);
+}
+
+static data_chunk genesis_message()
+{
+    return serialize(protocol, block(chain::block::genesis_mainnet()), magic);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__empty__success)
+{
+    parser instance(magic, protocol);
+    BOOST_REQUIRE_EQUAL(instance.parse(data_chunk{}), error::success);
+    BOOST_REQUIRE_EQUAL(instance.buffered(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__whole_message__notifies)
+{
+    uint64_t nonce = 0;
+    parser instance(magic, protocol);
+    instance.subscribe<ping>([&](ping::const_ptr message)
+    {
+        nonce = message->nonce();
+    });
+
+    BOOST_REQUIRE_EQUAL(instance.parse(ping_message(42)), error::success);
+    BOOST_REQUIRE_EQUAL(nonce, 42u);
+    BOOST_REQUIRE_EQUAL(instance.buffered(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__byte_at_a_time__notifies_once)
+{
+    size_t count = 0;
+    const auto genesis = chain::block::genesis_mainnet();
+    parser instance(magic, protocol);
+    instance.subscribe<block>([&](block::const_ptr message)
+    {
+        ++count;
+        BOOST_REQUIRE(*message == genesis);
+    });
+
+    const auto data = genesis_message();
+
+    for (const auto byte: data)
+    {
+        BOOST_REQUIRE_EQUAL(count, 0u);
+        BOOST_REQUIRE_EQUAL(instance.parse(data_chunk{ byte }), error::success);
+    }
+
+    BOOST_REQUIRE_EQUAL(count, 1u);
+    BOOST_REQUIRE_EQUAL(instance.buffered(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__split_messages__notifies_in_order)
+{
+    std::vector<uint64_t> nonces;
+    size_t blocks = 0;
+    parser instance(magic, protocol);
+    instance.subscribe<ping>([&](ping::const_ptr message)
+    {
+        nonces.push_back(message->nonce());
+    });
+    instance.subscribe<block>([&](block::const_ptr)
+    {
+        ++blocks;
+    });
+
+    const auto data = build_chunk(
+    {
+        ping_message(1),
+        genesis_message(),
+        ping_message(2),
+        serialize(protocol, verack(), magic),
+        ping_message(3)
+    });
+
+    // Split at arbitrary points across headings and payloads.
+    const size_t split = 37;
+    for (auto it = data.begin(); it < data.end(); it += split)
+    {
+        const auto end = std::min(it + split, data.end());
+        BOOST_REQUIRE_EQUAL(instance.parse(data_chunk(it, end)),
+            error::success);
+    }
+
+    BOOST_REQUIRE_EQUAL(blocks, 1u);
+    BOOST_REQUIRE_EQUAL(nonces.size(), 3u);
+    BOOST_REQUIRE_EQUAL(nonces[0], 1u);
+    BOOST_REQUIRE_EQUAL(nonces[1], 2u);
+    BOOST_REQUIRE_EQUAL(nonces[2], 3u);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__unsubscribed__skipped)
+{
+    size_t count = 0;
+    parser instance(magic, protocol);
+    instance.subscribe<ping>([&](ping::const_ptr)
+    {
+        ++count;
+    });
+
+    const auto data = build_chunk({ genesis_message(), ping_message(1) });
+    BOOST_REQUIRE_EQUAL(instance.parse(data), error::success);
+    BOOST_REQUIRE_EQUAL(count, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__invalid_magic__bad_stream_until_reset)
+{
+    size_t count = 0;
+    parser instance(magic + 1, protocol);
+    instance.subscribe<ping>([&](ping::const_ptr)
+    {
+        ++count;
+    });
+
+    BOOST_REQUIRE_EQUAL(instance.parse(ping_message(1)), error::bad_stream);
+    BOOST_REQUIRE_EQUAL(instance.parse(data_chunk{ 0 }), error::bad_stream);
+    BOOST_REQUIRE_EQUAL(count, 0u);
+
+    instance.reset();
+    const auto data = serialize(protocol, ping(1), magic + 1);
+    BOOST_REQUIRE_EQUAL(instance.parse(data), error::success);
+    BOOST_REQUIRE_EQUAL(count, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__oversized_payload__bad_stream)
+{
+    parser instance(magic, protocol);
+    const auto oversized = heading::maximum_payload_size(protocol) + 1;
+    const heading head(magic, ping::command,
+        static_cast<uint32_t>(oversized), 0);
+    BOOST_REQUIRE_EQUAL(instance.parse(head.to_data()), error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__whole_bad_checksum__bad_stream)
+{
+    parser instance(magic, protocol);
+    instance.subscribe<ping>([](ping::const_ptr)
+    {
+        BOOST_FAIL("unexpected notification");
+    });
+
+    auto data = ping_message(42);
+    data.back() ^= 0x01;
+    BOOST_REQUIRE_EQUAL(instance.parse(data), error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__split_bad_checksum__bad_stream)
+{
+    parser instance(magic, protocol);
+    instance.subscribe<block>([](block::const_ptr)
+    {
+        BOOST_FAIL("unexpected notification");
+    });
+
+    auto data = genesis_message();
+    data.back() ^= 0x01;
+    const auto middle = data.begin() + data.size() / 2;
+    BOOST_REQUIRE_EQUAL(instance.parse(data_chunk(data.begin(), middle)),
+        error::success);
+    BOOST_REQUIRE_GT(instance.buffered(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.parse(data_chunk(middle, data.end())),
+        error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__undeserializable_payload__bad_stream)
+{
+    parser instance(magic, protocol);
+    instance.subscribe<block>([](block::const_ptr)
+    {
+        BOOST_FAIL("unexpected notification");
+    });
+
+    // A correctly framed but truncated block payload.
+    const data_chunk payload(10, 0x00);
+    const heading head(magic, block::command,
+        static_cast<uint32_t>(payload.size()), bitcoin_checksum(payload));
+    const auto data = build_chunk({ head.to_data(), payload });
+    BOOST_REQUIRE_EQUAL(instance.parse(data), error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(parser__parse__retain_encoding__block_retains_received_bytes)
+{
+    const auto data = genesis_message();
+    block::const_ptr received;
+    parser instance(magic, protocol);
+    instance.set_retain_encoding(true);
+    instance.subscribe<block>([&](block::const_ptr message)
+    {
+        received = message;
+    });
+
+    BOOST_REQUIRE_EQUAL(instance.parse(data), error::success);
+    BOOST_REQUIRE(received);
+    const auto encoded = received->encode(protocol, magic);
+    BOOST_REQUIRE(encoded->data() == data);
+    BOOST_REQUIRE(received->encode(protocol, magic) == encoded);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
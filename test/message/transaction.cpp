@@ -642,4 +642,26 @@ BOOST_AUTO_TEST_CASE(transaction__operator_boolean_not_equals_2__differs__return
     BOOST_REQUIRE(alpha != beta);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__encode__repeated__returns_cached_encoding)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    const transaction instance(
+        chain::block::genesis_mainnet().transactions().front());
+    const auto encoded = instance.encode(transaction::version_maximum, magic);
+    BOOST_REQUIRE(encoded);
+    BOOST_REQUIRE(encoded->data() == serialize(transaction::version_maximum, instance, magic));
+    BOOST_REQUIRE(to_chunk(encoded->payload()) == instance.to_data(transaction::version_maximum));
+    BOOST_REQUIRE(instance.encode(transaction::version_maximum, magic) == encoded);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__operator_assign__encoded__resets_encoding)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    const auto coinbase = chain::block::genesis_mainnet().transactions().front();
+    transaction instance(coinbase);
+    const auto encoded = instance.encode(transaction::version_maximum, magic);
+    instance = transaction(coinbase);
+    BOOST_REQUIRE(instance.encode(transaction::version_maximum, magic) != encoded);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
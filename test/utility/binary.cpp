@@ -493,4 +493,43 @@ BOOST_AUTO_TEST_CASE(prefix_to_bytes__two_bytes_leading_null_byte__round_trips)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(binary__is_prefix_of)
+
+BOOST_AUTO_TEST_CASE(is_prefix_of__empty__true)
+{
+    const binary prefix;
+    BOOST_REQUIRE(prefix.is_prefix_of(uint32_t(0x0df0adba)));
+    BOOST_REQUIRE(prefix.is_prefix_of(data_chunk{}));
+}
+
+BOOST_AUTO_TEST_CASE(is_prefix_of__nonaligned_match__true)
+{
+    const binary prefix("1011101010101");
+    BOOST_REQUIRE(prefix.is_prefix_of(uint32_t(0x0df0adba)));
+    BOOST_REQUIRE(prefix.is_prefix_of(data_chunk{ 0xba, 0xaf }));
+}
+
+BOOST_AUTO_TEST_CASE(is_prefix_of__nonaligned_mismatch__false)
+{
+    const binary prefix("1011101010100");
+    BOOST_REQUIRE(!prefix.is_prefix_of(uint32_t(0x0df0adba)));
+    BOOST_REQUIRE(!prefix.is_prefix_of(data_chunk{ 0xbb, 0xad }));
+}
+
+BOOST_AUTO_TEST_CASE(is_prefix_of__short_field__zero_padded)
+{
+    const binary prefix("1011101000000000");
+    BOOST_REQUIRE(prefix.is_prefix_of(data_chunk{ 0xba }));
+    BOOST_REQUIRE(!binary("1011101000000001").is_prefix_of(data_chunk{ 0xba }));
+}
+
+BOOST_AUTO_TEST_CASE(operator_equals__same_bits__true)
+{
+    BOOST_REQUIRE(binary("10111") == binary(5, data_chunk{ 0xbf }));
+    BOOST_REQUIRE(binary("10111") != binary(6, data_chunk{ 0xbf }));
+    BOOST_REQUIRE(binary("10111") != binary("10110"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
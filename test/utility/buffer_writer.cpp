@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(buffer_writer_tests)
+
+BOOST_AUTO_TEST_CASE(buffer_writer__constructor__always__empty_valid)
+{
+    buffer_pool pool(8);
+    buffer_writer sink(pool);
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_EQUAL(sink.size(), 0u);
+    BOOST_REQUIRE(sink.buffers().empty());
+    BOOST_REQUIRE(sink.to_data().empty());
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__write_bytes__spans_buffers__expected_sequence)
+{
+    static const data_chunk expected{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+    buffer_pool pool(8);
+    buffer_writer sink(pool);
+    sink.write_bytes(expected);
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_EQUAL(sink.size(), expected.size());
+
+    const auto buffers = sink.buffers();
+    BOOST_REQUIRE_EQUAL(buffers.size(), 3u);
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_size(buffers[0]), 8u);
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_size(buffers[1]), 8u);
+    BOOST_REQUIRE_EQUAL(boost::asio::buffer_size(buffers[2]), 4u);
+    BOOST_REQUIRE(sink.to_data() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__write__integers__matches_serializer)
+{
+    data_chunk expected(54);
+    auto serial = make_unsafe_serializer(expected.begin());
+    serial.write_byte(0x42);
+    serial.write_2_bytes_big_endian(0x1234);
+    serial.write_4_bytes_little_endian(0x12345678);
+    serial.write_8_bytes_little_endian(0x0123456789abcdef);
+    serial.write_variable_little_endian(0xfedc);
+    serial.write_string("abc");
+    serial.write_hash(bitcoin_hash(data_chunk{ 42 }));
+
+    buffer_pool pool(5);
+    buffer_writer sink(pool);
+    sink.write_byte(0x42);
+    sink.write_2_bytes_big_endian(0x1234);
+    sink.write_4_bytes_little_endian(0x12345678);
+    sink.write_8_bytes_little_endian(0x0123456789abcdef);
+    sink.write_variable_little_endian(0xfedc);
+    sink.write_string("abc");
+    sink.write_hash(bitcoin_hash(data_chunk{ 42 }));
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE(sink.to_data() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__skip__reused_buffer__writes_nulls)
+{
+    buffer_pool pool(4);
+    auto dirty = pool.acquire();
+    std::fill(dirty.begin(), dirty.end(), 0xff);
+    pool.release(std::move(dirty));
+
+    buffer_writer sink(pool);
+    sink.skip(3);
+    sink.write_string("ab", 4);
+    BOOST_REQUIRE(sink.to_data() == (data_chunk{ 0, 0, 0, 'a', 'b', 0, 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__write_at__across_buffers__overwrites)
+{
+    buffer_pool pool(4);
+    buffer_writer sink(pool);
+    sink.skip(10);
+    sink.write_at(2, data_chunk{ 1, 2, 3, 4, 5, 6 });
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE(sink.to_data() == (data_chunk{ 0, 0, 1, 2, 3, 4, 5, 6, 0, 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__write_at__beyond_size__invalid)
+{
+    buffer_pool pool(4);
+    buffer_writer sink(pool);
+    sink.skip(2);
+    sink.write_at(1, data_chunk{ 1, 2 });
+    BOOST_REQUIRE(!sink);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__slices__offset__expected)
+{
+    buffer_pool pool(4);
+    buffer_writer sink(pool);
+    sink.write_bytes(data_chunk{ 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    const auto slices = sink.slices(3);
+    BOOST_REQUIRE_EQUAL(slices.size(), 3u);
+    BOOST_REQUIRE_EQUAL(slices[0].size(), 1u);
+    BOOST_REQUIRE_EQUAL(slices[0].data()[0], 4u);
+    BOOST_REQUIRE_EQUAL(slices[1].size(), 4u);
+    BOOST_REQUIRE_EQUAL(slices[2].size(), 1u);
+    BOOST_REQUIRE_EQUAL(bitcoin_checksum(slices),
+        bitcoin_checksum(data_chunk{ 4, 5, 6, 7, 8, 9 }));
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__clear__always__returns_buffers_to_pool)
+{
+    buffer_pool pool(4, 2);
+    buffer_writer sink(pool);
+    sink.skip(10);
+    BOOST_REQUIRE_EQUAL(pool.available(), 0u);
+    sink.clear();
+    BOOST_REQUIRE_EQUAL(sink.size(), 0u);
+    BOOST_REQUIRE_EQUAL(pool.available(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_writer__destructor__always__returns_buffers_to_pool)
+{
+    buffer_pool pool(4);
+
+    {
+        buffer_writer sink(pool);
+        sink.skip(6);
+    }
+
+    BOOST_REQUIRE_EQUAL(pool.available(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
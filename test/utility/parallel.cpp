@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(parallel_tests)
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__empty__not_invoked)
+{
+    size_t calls = 0;
+    parallel_for(0, 1, [&](size_t, size_t) { ++calls; });
+    BOOST_REQUIRE_EQUAL(calls, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__below_grain__single_range)
+{
+    size_t calls = 0;
+    parallel_for(10, 100, [&](size_t first, size_t last)
+    {
+        BOOST_REQUIRE_EQUAL(first, 0u);
+        BOOST_REQUIRE_EQUAL(last, 10u);
+        ++calls;
+    }, 4);
+
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__below_twice_grain__single_range)
+{
+    size_t calls = 0;
+    parallel_for(150, 100, [&](size_t first, size_t last)
+    {
+        BOOST_REQUIRE_EQUAL(first, 0u);
+        BOOST_REQUIRE_EQUAL(last, 150u);
+        ++calls;
+    }, 4);
+
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__threads__each_index_once)
+{
+    static const size_t count = 1001;
+    std::vector<size_t> visits(count, 0);
+    std::atomic<size_t> calls(0);
+
+    parallel_for(count, 10, [&](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            ++visits[index];
+
+        ++calls;
+    }, 4);
+
+    BOOST_REQUIRE_EQUAL(calls.load(), 4u);
+    for (const auto visit: visits)
+        BOOST_REQUIRE_EQUAL(visit, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__worker_throws__rethrown_after_all_ranges)
+{
+    std::atomic<size_t> calls(0);
+    const auto handler = [&](size_t first, size_t)
+    {
+        ++calls;
+
+        // Throw from a range processed on a worker thread.
+        if (first != 0)
+            throw std::runtime_error("range");
+    };
+
+    BOOST_REQUIRE_THROW(parallel_for(40, 10, handler, 4), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(calls.load(), 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -61,6 +61,31 @@ BOOST_AUTO_TEST_CASE(deserializer_exhaustion)
     BOOST_REQUIRE(!reader);
 }
 
+BOOST_AUTO_TEST_CASE(deserializer_read_bytes_overflow_empty)
+{
+    data_chunk data(42);
+    auto reader = make_safe_deserializer(data.begin(), data.end());
+    const auto result = reader.read_bytes(max_size_t);
+
+    BOOST_REQUIRE(!reader);
+    BOOST_REQUIRE(result.empty());
+}
+
+BOOST_AUTO_TEST_CASE(serializer_safe_overflow_invalid)
+{
+    data_chunk data(6, 0x00);
+    auto writer = make_safe_serializer(data.begin(), data.begin() + 5);
+    writer.write_4_bytes_little_endian(0x04030201);
+    BOOST_REQUIRE(writer);
+
+    // The write that exceeds the end is dropped, as are those that follow.
+    writer.write_2_bytes_little_endian(0xffff);
+    writer.write_byte(0xff);
+    BOOST_REQUIRE(!writer);
+    BOOST_REQUIRE(writer.position() == data.begin() + 4);
+    BOOST_REQUIRE(data == data_chunk({ 0x01, 0x02, 0x03, 0x04, 0x00, 0x00 }));
+}
+
 BOOST_AUTO_TEST_CASE(is_exhausted_initialized_empty_stream_returns_true)
 {
     data_chunk data(0);
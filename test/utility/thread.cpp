@@ -18,6 +18,7 @@
  */
 #include <boost/test/unit_test.hpp>
 
+#include <future>
 #include <stdexcept>
 #include <bitcoin/bitcoin.hpp>
 
@@ -112,4 +113,65 @@ BOOST_AUTO_TEST_CASE(thread__set_thread_priority__invalid__throws_invalid_argume
     BOOST_REQUIRE_THROW(set_priority(static_cast<thread_priority>(42)), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(thread__numa_nodes__always__at_least_one)
+{
+    BOOST_REQUIRE_GE(numa_nodes(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(thread__node_cores__first_node__not_empty)
+{
+    BOOST_REQUIRE(!node_cores(0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(thread__node_cores__invalid_node__empty)
+{
+    BOOST_REQUIRE(node_cores(numa_nodes()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(thread__set_affinity__empty__false)
+{
+    BOOST_REQUIRE(!set_affinity({}));
+}
+
+BOOST_AUTO_TEST_CASE(thread__current_node__pinned__expected)
+{
+    // Pinning is not supported on all platforms, skip if not.
+    std::promise<size_t> promise;
+    asio::thread thread([&promise]()
+    {
+        const auto pinned = set_affinity(node_cores(0));
+        promise.set_value(pinned ? current_node() : 0);
+    });
+
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), 0u);
+    thread.join();
+}
+
+BOOST_AUTO_TEST_CASE(thread__threadpool_node__spawn__any_node)
+{
+    threadpool pool(1);
+    BOOST_REQUIRE_EQUAL(pool.node(), any_node);
+}
+
+BOOST_AUTO_TEST_CASE(thread__threadpool_node__spawn_on_node__expected)
+{
+    // Pinning is not supported on all platforms, the pool is bound if so.
+    threadpool pool;
+    const auto bound = pool.spawn_on_node(2, 0, true);
+    dispatcher dispatch(pool, "thread_test");
+    BOOST_REQUIRE_EQUAL(pool.size(), 2u);
+    BOOST_REQUIRE_EQUAL(dispatch.node(), bound ? 0u : any_node);
+
+    pool.spawn(1);
+    BOOST_REQUIRE_EQUAL(dispatch.node(), any_node);
+}
+
+BOOST_AUTO_TEST_CASE(thread__threadpool_node__spawn_on_invalid_node__any_node)
+{
+    threadpool pool;
+    BOOST_REQUIRE(!pool.spawn_on_node(1, numa_nodes()));
+    BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+    BOOST_REQUIRE_EQUAL(pool.node(), any_node);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(timing_wheel_tests)
+
+BOOST_AUTO_TEST_CASE(timing_wheel__start__expires__success)
+{
+    threadpool pool(1);
+    std::promise<code> promise;
+    const auto handler = [&promise](const code& ec)
+    {
+        promise.set_value(ec);
+    };
+
+    const auto start = asio::steady_clock::now();
+    pool.timers().start(handler, asio::milliseconds(20));
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    BOOST_REQUIRE(asio::steady_clock::now() - start >= asio::milliseconds(20));
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timing_wheel__stop__pending__true_not_invoked)
+{
+    threadpool pool(1);
+    std::atomic<size_t> invoked(0);
+    const auto handler = [&invoked](const code&)
+    {
+        ++invoked;
+    };
+
+    const auto timer = pool.timers().start(handler, asio::milliseconds(10));
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 1u);
+    BOOST_REQUIRE(pool.timers().stop(timer));
+    BOOST_REQUIRE(!pool.timers().stop(timer));
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 0u);
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(invoked.load(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timing_wheel__stop__empty__false)
+{
+    threadpool pool(1);
+    BOOST_REQUIRE(!pool.timers().stop(nullptr));
+}
+
+BOOST_AUTO_TEST_CASE(timing_wheel__start__beyond_rotation__success)
+{
+    // Two slots of one millisecond requires multiple rotations.
+    threadpool pool(1);
+    timing_wheel wheel(pool.service(), asio::milliseconds(1), 2);
+    std::promise<code> promise;
+    const auto handler = [&promise](const code& ec)
+    {
+        promise.set_value(ec);
+    };
+
+    const auto start = asio::steady_clock::now();
+    wheel.start(handler, asio::milliseconds(15));
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    BOOST_REQUIRE(asio::steady_clock::now() - start >= asio::milliseconds(15));
+
+    // The wheel must outlive the ticks that the pool may still be running.
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(timing_wheel__deadline__restart__invoked_once)
+{
+    threadpool pool(1);
+    std::atomic<size_t> invoked(0);
+    std::promise<code> promise;
+    const auto handler = [&invoked, &promise](const code& ec)
+    {
+        if (++invoked == 1)
+            promise.set_value(ec);
+    };
+
+    const auto timer = std::make_shared<deadline>(pool, asio::milliseconds(5));
+    timer->start(handler);
+    timer->start(handler, asio::milliseconds(10));
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), error::success);
+    timer->stop();
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(invoked.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(timing_wheel__start__concurrent__all_expire)
+{
+    static const size_t timers = 1000;
+    threadpool pool(2);
+    dispatcher dispatch(pool, "timing_wheel_test");
+    std::atomic<size_t> expired(0);
+    std::promise<void> promise;
+    const auto handler = [&expired, &promise](const code&)
+    {
+        if (++expired == timers)
+            promise.set_value();
+    };
+
+    for (size_t index = 0; index < timers; ++index)
+        dispatch.delayed(asio::milliseconds(index % 50), handler);
+
+    promise.get_future().wait();
+    BOOST_REQUIRE_EQUAL(expired.load(), timers);
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timing_wheel__stop__concurrent__none_expire)
+{
+    static const size_t timers = 1000;
+    threadpool pool(1);
+    std::atomic<size_t> invoked(0);
+    std::vector<timing_wheel::entry_ptr> entries;
+    entries.reserve(timers);
+    const auto handler = [&invoked](const code&)
+    {
+        ++invoked;
+    };
+
+    for (size_t index = 0; index < timers; ++index)
+        entries.push_back(pool.timers().start(handler, asio::seconds(1)));
+
+    for (const auto& entry: entries)
+        BOOST_REQUIRE(pool.timers().stop(entry));
+
+    BOOST_REQUIRE_EQUAL(pool.timers().size(), 0u);
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(invoked.load(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -208,6 +208,24 @@ BOOST_AUTO_TEST_CASE(encrypted__encrypt_private__vector_unicode__expected)
     BC_REQUIRE_ENCRYPT(secret, passphrase, version, compression, expected);
 }
 
+BOOST_AUTO_TEST_CASE(encrypted__encrypt_private__batch_vectors__expected)
+{
+    const secret_list secrets
+    {
+        base16_literal("cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5"),
+        base16_literal("09c2686880095b1a4c249ee3ac4eea8a014f11e6f986d0b5025ac1f39afbd9ae")
+    };
+
+    encrypted_private_list out_privates;
+    BOOST_REQUIRE(encrypt(out_privates, secrets, "TestingOneTwoThree", 0x00, true));
+    BOOST_REQUIRE_EQUAL(out_privates.size(), secrets.size());
+    BOOST_REQUIRE_EQUAL(encode_base58(out_privates[0]), "6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo");
+
+    secret_list out_secrets;
+    BOOST_REQUIRE(decrypt(out_secrets, out_privates, "TestingOneTwoThree"));
+    BOOST_REQUIRE(out_secrets == secrets);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ----------------------------------------------------------------------------
@@ -332,6 +350,37 @@ BOOST_AUTO_TEST_CASE(encrypted__decrypt_private__vector_9_multiplied__expected)
     BOOST_REQUIRE(!out_is_compressed);
 }
 
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_private__batch_vectors__expected)
+{
+    const encrypted_private_list keys
+    {
+        base58_literal("6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg"),
+        base58_literal("6PfQu77ygVyJLZjfvMLyhLMQbYnu5uguoJJ4kMCLqWwPEdfpwANVS76gTX"),
+        base58_literal("6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo"),
+        base58_literal("6PfQu77ygVyJLZjfvMLyhLMQbYnu5uguoJJ4kMCLqWwPEdfpwANVS76gTX")
+    };
+
+    secret_list out_secrets;
+    BOOST_REQUIRE(decrypt(out_secrets, keys, "TestingOneTwoThree"));
+    BOOST_REQUIRE_EQUAL(out_secrets.size(), keys.size());
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[0]), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[1]), "a43a940577f4e97f5c4d39eb14ff083a98187c64ea7c99ef7ce460833959a519");
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[2]), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[3]), "a43a940577f4e97f5c4d39eb14ff083a98187c64ea7c99ef7ce460833959a519");
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_private__batch_wrong_passphrase__false)
+{
+    const encrypted_private_list keys
+    {
+        base58_literal("6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg"),
+        base58_literal("6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq")
+    };
+
+    secret_list out_secrets;
+    BOOST_REQUIRE(!decrypt(out_secrets, keys, "TestingOneTwoThree"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ----------------------------------------------------------------------------
@@ -469,6 +518,42 @@ BOOST_AUTO_TEST_CASE(encrypted__create_key_pair__vector_9_compressed_testnet__ex
     BOOST_REQUIRE_EQUAL(encode_base16(out_point), "02c3b28a224e38af4219cd782653250d2e4b67ed85ac342201f8f05ff909efdc52");
 }
 
+BOOST_AUTO_TEST_CASE(encrypted__create_key_pairs__bad_checksum__false)
+{
+    const uint8_t version = 0x00;
+    const ek_seed_list seeds{ base16_literal("d36d8e703d8bd5445044178f69087657fba73d9f3ff211f7") };
+    const auto token = base58_literal("passphraseo59BauW85etaRsKpbbTrEa5RRYw6bq5K9yrDf4r4N5fcirPdtDKmfJw9oYNoGN");
+    point_list out_points;
+    encrypted_private_list out_privates;
+    BOOST_REQUIRE(!create_key_pairs(out_privates, out_points, token, seeds, version, false));
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__create_key_pairs__vector_9__matches_single)
+{
+    auto compression = true;
+    const uint8_t version = 0x00;
+    const auto token = base58_literal("passphraseouGLY8yjTZQ5Q2bTo8rtKfdbHz4tme7QuPheRgES8KnT6pX5yxFauYhv3SVPDD");
+
+    ek_seed_list seeds{ base16_literal("bbeac8b9bb39381520b6873553544b387bcaa19112602230") };
+    for (size_t index = 1; index < 16; ++index)
+        seeds.push_back(slice<0, ek_seed_size>(bitcoin_hash(to_chunk(to_little_endian(index)))));
+
+    point_list out_points;
+    encrypted_private_list out_privates;
+    BOOST_REQUIRE(create_key_pairs(out_privates, out_points, token, seeds, version, compression));
+    BOOST_REQUIRE_EQUAL(out_privates.size(), seeds.size());
+    BOOST_REQUIRE_EQUAL(out_points.size(), seeds.size());
+    BOOST_REQUIRE_EQUAL(encode_base58(out_privates.front()), "6PnQ4ihgH1pxeUWa1SDPZ4xToaTdLtjebd8Qw6KJf8xDCW67ssaAqWuJkw");
+    BOOST_REQUIRE_EQUAL(encode_base16(out_points.front()), "02c3b28a224e38af4219cd782653250d2e4b67ed85ac342201f8f05ff909efdc52");
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+    {
+        BC_REQUIRE_CREATE_KEY_PAIR(token, seeds[index], version, compression);
+        BOOST_REQUIRE(out_privates[index] == out_private);
+        BOOST_REQUIRE(out_points[index] == out_point);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ----------------------------------------------------------------------------
@@ -130,4 +130,46 @@ BOOST_AUTO_TEST_CASE(hd_private__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__across_hardened__expected)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto first = hd_first_hardened_key - 20;
+    const auto children = m.derive_private_range(first, 40);
+    BOOST_REQUIRE_EQUAL(children.size(), 40u);
+
+    for (uint32_t offset = 0; offset < children.size(); ++offset)
+        BOOST_REQUIRE(children[offset] == m.derive_private(first + offset));
+
+    BOOST_REQUIRE_EQUAL(children[20].encoded(), "xprv9uHRZZhk6KAJC1avXpDAp4MDc3sQKNxDiPvvkX8Br5ngLNv1TxvUxt4cV1rGL5hj6KCesnDYUhd7oWgT11eZG7XnxHrnYeSvkzY7d2bhkJ7");
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__out_of_domain__empty)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    BOOST_REQUIRE(m.derive_private_range(max_uint32, 2).empty());
+    BOOST_REQUIRE(m.derive_private_range(max_uint32, 1).size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_public_range__long_seed__expected)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto m0 = m.derive_private(0);
+    const auto children = m0.derive_public_range(0, 50);
+    BOOST_REQUIRE_EQUAL(children.size(), 50u);
+
+    for (uint32_t index = 0; index < children.size(); ++index)
+        BOOST_REQUIRE(children[index] == m0.derive_public(index));
+
+    BOOST_REQUIRE(m0.derive_public_range(hd_first_hardened_key, 1).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
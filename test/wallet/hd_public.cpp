@@ -95,4 +95,38 @@ BOOST_AUTO_TEST_CASE(hd_public__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__invalid__empty)
+{
+    const hd_public key;
+    BOOST_REQUIRE(key.derive_public_range(0, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__hardened__empty)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const hd_public m_pub = m;
+    BOOST_REQUIRE(m_pub.derive_public_range(hd_first_hardened_key, 1).empty());
+    BOOST_REQUIRE(m_pub.derive_public_range(hd_first_hardened_key - 1, 2).empty());
+    BOOST_REQUIRE(m_pub.derive_public_range(hd_first_hardened_key - 1, 1).size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__long_seed__expected)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const hd_public m_pub = m;
+    const auto children = m_pub.derive_public_range(0, 100);
+    BOOST_REQUIRE_EQUAL(children.size(), 100u);
+
+    for (uint32_t index = 0; index < children.size(); ++index)
+        BOOST_REQUIRE(children[index] == m_pub.derive_public(index));
+
+    BOOST_REQUIRE_EQUAL(children[0].encoded(), "xpub69H7F5d8KSRgmmdJg2KhpAK8SR3DjMwAdkxj3ZuxV27CprR9LgpeyGmXUbC6wb7ERfvrnKZjXoUmmDznezpbZb7ap6r1D3tgFxHmwMkQTPH");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -242,4 +242,68 @@ BOOST_AUTO_TEST_CASE(message__verify_message__electrum_incorrect_address__false)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(message__verify_messages)
+
+BOOST_AUTO_TEST_CASE(message__verify_messages__empty__empty)
+{
+    BOOST_REQUIRE(verify_messages({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(message__verify_messages__vectors__expected)
+{
+    message_signature electrum;
+    BOOST_REQUIRE(decode_base16(electrum, ELECTRUM_SIGNATURE));
+    const payment_address compressed(base16_literal(SECRET));
+    const payment_address uncompressed({ base16_literal(SECRET), 0x00, false });
+    const payment_address electrum_signer("1PeChFbhxDD9NLbU21DfD55aQBC4ZTR3tE");
+    const payment_address electrum_other("1Em1SX7qQq1pTmByqLRafhL1ypx2V786tP");
+    const auto nakomoto = to_chunk(std::string("Nakomoto"));
+
+    const signed_message::list messages
+    {
+        { to_chunk(std::string("Compressed")), compressed, base16_literal(SIGNATURE_COMPRESSED) },
+        { to_chunk(std::string("Uncompressed")), uncompressed, base16_literal(SIGNATURE_UNCOMPRESSED) },
+        { nakomoto, electrum_signer, electrum },
+        { nakomoto, electrum_other, electrum },
+        { to_chunk(std::string("Compressed")), compressed, base16_literal(SIGNATURE_UNCOMPRESSED) }
+    };
+
+    const auto result = verify_messages(messages);
+    const std::vector<bool> expected{ true, true, true, false, false };
+    BOOST_REQUIRE(result == expected);
+}
+
+BOOST_AUTO_TEST_CASE(message__verify_messages__signed__matches_verify_message)
+{
+    static const size_t count = 30;
+    signed_message::list messages;
+    messages.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto secret = bitcoin_hash(to_chunk(to_little_endian(index)));
+        const ec_private key(secret);
+        const auto message = to_chunk(to_little_endian(index * 3));
+        message_signature signature;
+        BOOST_REQUIRE(sign_message(signature, message, key));
+
+        // Every third signature is made to fail against a foreign address.
+        const auto signer = (index % 3 == 0) ? payment_address(
+            ec_private(bitcoin_hash(secret))) : payment_address(key);
+        messages.push_back({ message, signer, signature });
+    }
+
+    std::vector<bool> singles;
+    for (const auto& item: messages)
+        singles.push_back(verify_message(item.message, item.address,
+            item.signature));
+
+    const auto results = verify_messages(messages);
+    BOOST_REQUIRE(results == singles);
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE_EQUAL(results[index], index % 3 != 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
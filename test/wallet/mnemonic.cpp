@@ -242,4 +242,97 @@ BOOST_AUTO_TEST_CASE(mnemonic__dictionary__zh_Hans_Hant__intersection)
     BOOST_REQUIRE_EQUAL(intersection, 1275u);
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__find_lexicon__each_language__expected)
+{
+    const auto entropy = to_chunk(sha256_hash(to_chunk("entropy")));
+    for (const auto lexicon: language::all)
+    {
+        const auto mnemonic = create_mnemonic(entropy, *lexicon);
+        BOOST_REQUIRE_EQUAL(mnemonic.size(), 24u);
+        BOOST_REQUIRE(find_lexicon(mnemonic) == lexicon);
+        BOOST_REQUIRE(validate_mnemonic(mnemonic, *lexicon));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__find_lexicon__invalid__null)
+{
+    for (const auto& mnemonic: invalid_mnemonic_tests)
+    {
+        const auto words = split(mnemonic, ",");
+        BOOST_REQUIRE(find_lexicon(words) == nullptr);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__find_lexicon__excluded_language__null)
+{
+    const data_chunk entropy(16, 0x42);
+    const auto mnemonic = create_mnemonic(entropy, language::ja);
+    BOOST_REQUIRE(find_lexicon(mnemonic, { &language::en, &language::es })
+        == nullptr);
+    BOOST_REQUIRE(!validate_mnemonic(mnemonic, language::en));
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__find_lexicon__custom_dictionary__expected)
+{
+    // Not a built-in dictionary, so it is not indexed.
+    const auto custom = std::make_shared<dictionary>(language::en);
+    const data_chunk entropy(20, 0xa9);
+    const auto mnemonic = create_mnemonic(entropy, *custom);
+    BOOST_REQUIRE(find_lexicon(mnemonic, { custom.get() }) == custom.get());
+    BOOST_REQUIRE(validate_mnemonic(mnemonic, *custom));
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__validate_mnemonic__altered_word__invalid)
+{
+    const data_chunk entropy(32, 0x5a);
+    auto mnemonic = create_mnemonic(entropy, language::fr);
+    BOOST_REQUIRE(validate_mnemonic(mnemonic, language::fr));
+
+    // The last word carries the checksum, replace with its neighbor.
+    const auto position = find_position(language::fr, mnemonic.back());
+    mnemonic.back() = language::fr[position + 1];
+    BOOST_REQUIRE(!validate_mnemonic(mnemonic, language::fr));
+    BOOST_REQUIRE(!validate_mnemonic(mnemonic));
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__validate_mnemonic__embedded_null__invalid)
+{
+    const data_chunk entropy(16, 0x00);
+    auto mnemonic = create_mnemonic(entropy, language::en);
+    BOOST_REQUIRE(validate_mnemonic(mnemonic, language::en));
+
+    // The word is not in the dictionary, though its c string is.
+    mnemonic.front().append(std::string(1, '\0') + "x");
+    BOOST_REQUIRE(!validate_mnemonic(mnemonic, language::en));
+    BOOST_REQUIRE(!validate_mnemonic(mnemonic));
+    BOOST_REQUIRE(find_lexicon(mnemonic, language::all) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__no_passphrase__expected)
+{
+    std::vector<word_list> mnemonics;
+    for (const auto& vector: mnemonic_no_passphrase)
+        mnemonics.push_back(split(vector.mnemonic, ","));
+
+    const auto seeds = decode_mnemonics(mnemonics);
+    BOOST_REQUIRE_EQUAL(seeds.size(), mnemonic_no_passphrase.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(seeds[index]),
+            mnemonic_no_passphrase[index].seed);
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__validate_mnemonic__each_language__true)
+{
+    for (size_t index = 0; index < language::all.size(); ++index)
+    {
+        const auto entropy = to_chunk(sha256_hash(to_chunk(
+            to_little_endian(index))));
+        const auto& lexicon = *language::all[index];
+        const auto mnemonic = create_mnemonic(entropy, lexicon);
+        BOOST_REQUIRE(validate_mnemonic(mnemonic, lexicon));
+        BOOST_REQUIRE(validate_mnemonic(mnemonic));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -248,6 +248,32 @@ BOOST_AUTO_TEST_CASE(payment_address__construct__copy__valid_expected)
     BOOST_REQUIRE_EQUAL(copy.encoded(), ADDRESS_SCRIPT);
 }
 
+BOOST_AUTO_TEST_CASE(payment_address__from_points__secrets__expected)
+{
+    ec_secret secret;
+    BOOST_REQUIRE(decode_base16(secret, SECRET));
+    const secret_list secrets{ secret, null_hash, secret };
+
+    const auto compressed = ec_public::from_secrets(secrets);
+    BOOST_REQUIRE_EQUAL(compressed.size(), 3u);
+    BOOST_REQUIRE(compressed[0]);
+    BOOST_REQUIRE(!compressed[1]);
+    BOOST_REQUIRE_EQUAL(compressed[0].encoded(), COMPRESSED);
+
+    const auto addresses = payment_address::from_points(compressed, 0x6f);
+    BOOST_REQUIRE_EQUAL(addresses.size(), 3u);
+    BOOST_REQUIRE_EQUAL(addresses[0].encoded(), ADDRESS_COMPRESSED_TESTNET);
+    BOOST_REQUIRE(!addresses[1]);
+    BOOST_REQUIRE_EQUAL(addresses[2].encoded(), ADDRESS_COMPRESSED_TESTNET);
+
+    const auto uncompressed = ec_public::from_secrets(secrets, false);
+    const auto uncompressed_addresses = payment_address::from_points(
+        uncompressed);
+    BOOST_REQUIRE_EQUAL(uncompressed_addresses[0].encoded(),
+        ADDRESS_UNCOMPRESSED);
+    BOOST_REQUIRE(!uncompressed_addresses[1]);
+}
+
 // version property:
 
 BOOST_AUTO_TEST_CASE(payment_address__version__default__mainnet)
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(stealth_scanner_tests)
+
+#define MAIN_KEY "tprv8ctN3HAF9dCgX9ggdCwiZHa7c3UHuG2Ev4jgYWDhTHDUVWKKsg7znbr3vYtmCzVqcMQsjd9cSKsyKGaDvTAUMkw1UphETe1j8LcT21eWPkH"
+#define EPHEMERAL_PRIVATE "f91e673103863bbeb0ef1852cd8eade6b73ea55afc9b1873be62bf628eac072a"
+#define RECEIVER_PRIVATE "fc696c9f7143916f24977210c806101866c7fa13cc06982978d80518c91af2fb"
+#define DERIVED_ADDRESS "mtKffkQLTw2D6f6mTkrWfi8qxLv4jL1LrK"
+
+static const auto version = payment_address::testnet_p2kh;
+
+struct keys
+{
+    ec_secret scan_private;
+    ec_secret spend_private;
+    ec_compressed spend_public;
+    ec_compressed other_public;
+};
+
+static keys make_keys()
+{
+    const hd_private main_key(MAIN_KEY, hd_private::testnet);
+    const auto scan = main_key.derive_private(0 + hd_first_hardened_key);
+    const auto spend = main_key.derive_private(1 + hd_first_hardened_key);
+    const auto other = main_key.derive_private(2 + hd_first_hardened_key);
+    return { scan.secret(), spend.secret(), spend.point(), other.point() };
+}
+
+// Create the record of a payment to the spend key of the keys.
+static chain::stealth_record make_payment(const keys& keys)
+{
+    ec_compressed scan_public;
+    BOOST_REQUIRE(secret_to_public(scan_public, keys.scan_private));
+    const stealth_address address({}, scan_public, { keys.spend_public });
+
+    ec_secret ephemeral_private;
+    BOOST_REQUIRE(decode_base16(ephemeral_private, EPHEMERAL_PRIVATE));
+    const stealth_sender sender(ephemeral_private, address, {}, {}, version);
+    BOOST_REQUIRE(sender);
+
+    uint32_t prefix;
+    ec_compressed ephemeral_public;
+    const auto& script = sender.stealth_script();
+    BOOST_REQUIRE(to_stealth_prefix(prefix, script));
+    BOOST_REQUIRE(extract_ephemeral_key(ephemeral_public, script));
+    return { 42, prefix, ephemeral_public, sender.payment_address().hash(),
+        null_hash };
+}
+
+// Create records that do not pay to the keys, with valid ephemeral keys.
+static chain::stealth_record::list make_decoys(size_t count)
+{
+    chain::stealth_record::list decoys;
+    decoys.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        ec_compressed point;
+        const auto secret = bitcoin_hash(to_chunk(to_little_endian(index)));
+        BOOST_REQUIRE(secret_to_public(point, secret));
+        const auto prefix = static_cast<uint32_t>(index * 2654435761u);
+        decoys.emplace_back(index, prefix, point, null_short_hash, null_hash);
+    }
+
+    return decoys;
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__constructor__no_spend_keys__invalid)
+{
+    const auto keys = make_keys();
+    const stealth_scanner scanner(keys.scan_private, {}, {}, version);
+    BOOST_REQUIRE(!scanner);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__constructor__oversized_filter__invalid)
+{
+    const auto keys = make_keys();
+    const binary filter(33, data_chunk(5, 0xff));
+    const stealth_scanner scanner(keys.scan_private, { keys.spend_public },
+        filter, version);
+    BOOST_REQUIRE(!scanner);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__is_candidate__filter__matches_is_prefix_of)
+{
+    const auto keys = make_keys();
+    const binary filter("1011101010101");
+    const stealth_scanner scanner(keys.scan_private, { keys.spend_public },
+        filter, version);
+    BOOST_REQUIRE(scanner);
+
+    for (uint32_t prefix = 0; prefix < 0x10000; prefix += 7)
+    {
+        const auto field = prefix * 2654435761u;
+        BOOST_REQUIRE_EQUAL(scanner.is_candidate(field),
+            filter.is_prefix_of(field));
+    }
+
+    BOOST_REQUIRE(scanner.is_candidate(0x0df0adba));
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__payment__expected)
+{
+    const auto keys = make_keys();
+    const stealth_scanner scanner(keys.scan_private,
+        { keys.other_public, keys.spend_public }, {}, version);
+    BOOST_REQUIRE(scanner);
+
+    auto records = make_decoys(300);
+    const auto payment = make_payment(keys);
+    records.insert(records.begin() + 200, payment);
+
+    const auto matches = scanner.scan(records);
+    BOOST_REQUIRE_EQUAL(matches.size(), 1u);
+
+    const auto& match = matches.front();
+    BOOST_REQUIRE(match.record == payment);
+    BOOST_REQUIRE_EQUAL(match.spend_index, 1u);
+    BOOST_REQUIRE_EQUAL(match.address.encoded(), DERIVED_ADDRESS);
+
+    ec_secret receiver_private;
+    BOOST_REQUIRE(stealth_scanner::derive_private(receiver_private, match,
+        keys.spend_private));
+    BOOST_REQUIRE_EQUAL(encode_base16(receiver_private), RECEIVER_PRIVATE);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__filtered_payment__empty)
+{
+    const auto keys = make_keys();
+    const auto payment = make_payment(keys);
+
+    // A filter that excludes the payment prefix.
+    const binary filter(8, ~payment.prefix());
+    const stealth_scanner scanner(keys.scan_private, { keys.spend_public },
+        filter, version);
+    BOOST_REQUIRE(scanner);
+    BOOST_REQUIRE(scanner.scan({ payment }).empty());
+
+    // A filter that includes the payment prefix.
+    const stealth_scanner matching(keys.scan_private, { keys.spend_public },
+        binary(8, payment.prefix()), version);
+    BOOST_REQUIRE_EQUAL(matching.scan({ payment }).size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__decoys__matches_receiver)
+{
+    const auto keys = make_keys();
+    const stealth_receiver receiver(keys.scan_private, keys.spend_private, {},
+        version);
+    const stealth_scanner scanner(keys.scan_private, { keys.spend_public },
+        {}, version);
+    BOOST_REQUIRE(receiver);
+    BOOST_REQUIRE(scanner);
+
+    auto records = make_decoys(20);
+    records.push_back(make_payment(keys));
+
+    size_t found = 0;
+    payment_address address;
+    for (const auto& record: records)
+        if (receiver.derive_address(address, record.ephemeral_public_key()) &&
+            address.hash() == record.public_key_hash())
+            ++found;
+
+    BOOST_REQUIRE_EQUAL(found, 1u);
+    BOOST_REQUIRE_EQUAL(scanner.scan(records).size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(unspent_index_tests)
+
+static point_value make_output(uint32_t index, uint64_t value)
+{
+    hash_digest hash = null_hash;
+    hash[index % hash_size] = static_cast<uint8_t>(index);
+    return{ point{ hash, index }, value };
+}
+
+// Outputs of distinct value, so that selections are unambiguous.
+static points_value make_outputs(size_t count, uint32_t seed)
+{
+    std::mt19937 twister(seed);
+    std::uniform_int_distribution<uint64_t> spread(1, 1000);
+    points_value out;
+    uint64_t value = 0;
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        value += spread(twister);
+        out.points.push_back(make_output(index, value));
+    }
+
+    std::shuffle(out.points.begin(), out.points.end(), twister);
+    return out;
+}
+
+static unspent_index make_index(const points_value& unspent)
+{
+    unspent_index index;
+    for (const auto& output: unspent.points)
+        BOOST_REQUIRE(index.insert(output));
+
+    return index;
+}
+
+static bool same_values(const points_value& left, const points_value& right)
+{
+    if (left.points.size() != right.points.size())
+        return false;
+
+    for (size_t index = 0; index < left.points.size(); ++index)
+        if (left.points[index].value() != right.points[index].value())
+            return false;
+
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__insert__duplicate__false)
+{
+    unspent_index index;
+    BOOST_REQUIRE(index.insert(make_output(1, 10)));
+    BOOST_REQUIRE(!index.insert(make_output(1, 20)));
+    BOOST_REQUIRE_EQUAL(index.size(), 1u);
+    BOOST_REQUIRE_EQUAL(index.value(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__remove__indexed_and_missing__expected)
+{
+    unspent_index index;
+    BOOST_REQUIRE(index.insert(make_output(1, 10)));
+    BOOST_REQUIRE(index.insert(make_output(2, 10)));
+    BOOST_REQUIRE(index.insert(make_output(3, 30)));
+    BOOST_REQUIRE(index.remove(make_output(2, 0)));
+    BOOST_REQUIRE(!index.remove(make_output(2, 0)));
+    BOOST_REQUIRE(!index.contains(make_output(2, 0)));
+    BOOST_REQUIRE(index.contains(make_output(1, 0)));
+    BOOST_REQUIRE_EQUAL(index.size(), 2u);
+    BOOST_REQUIRE_EQUAL(index.value(), 40u);
+
+    index.clear();
+    BOOST_REQUIRE_EQUAL(index.size(), 0u);
+    BOOST_REQUIRE_EQUAL(index.value(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__select__insufficient__empty)
+{
+    points_value out;
+    const auto index = make_index(make_outputs(10, 42));
+    index.select(out, index.value() + 1);
+    BOOST_REQUIRE(out.points.empty());
+
+    unspent_index empty;
+    empty.select(out, 0);
+    BOOST_REQUIRE(out.points.empty());
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__select__greedy_and_individual__matches_select_outputs)
+{
+    const auto unspent = make_outputs(200, 42);
+    auto index = make_index(unspent);
+    points_value expected;
+    points_value out;
+
+    for (const auto algorithm: { select_outputs::algorithm::greedy,
+        select_outputs::algorithm::individual })
+    {
+        // Single sufficient outputs, then sets of outputs.
+        for (uint64_t minimum = 0; minimum <= index.value();
+            minimum += index.value() / 97)
+        {
+            select_outputs::select(expected, unspent, minimum, algorithm);
+            index.select(out, minimum, algorithm);
+            BOOST_REQUIRE(same_values(out, expected));
+        }
+    }
+
+    // Spent outputs are no longer selected.
+    auto remaining = unspent;
+    for (size_t spent = 0; spent < 100; ++spent)
+    {
+        BOOST_REQUIRE(index.remove(remaining.points.back()));
+        remaining.points.pop_back();
+    }
+
+    BOOST_REQUIRE_EQUAL(index.value(), remaining.value());
+    select_outputs::select(expected, remaining, remaining.value() / 2);
+    index.select(out, remaining.value() / 2);
+    BOOST_REQUIRE(same_values(out, expected));
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__select_exact__exact_subset__found)
+{
+    unspent_index index;
+    const uint64_t values[] = { 3, 5, 11, 17, 29, 41, 53, 61, 1000 };
+    uint32_t position = 0;
+    for (const auto value: values)
+        BOOST_REQUIRE(index.insert(make_output(position++, value)));
+
+    points_value out;
+    BOOST_REQUIRE(index.select_exact(out, 3 + 17 + 53));
+    BOOST_REQUIRE_EQUAL(out.value(), 3u + 17u + 53u);
+
+    // Within tolerance of two, 2 is not reachable but 3 is.
+    BOOST_REQUIRE(index.select_exact(out, 1, 2));
+    BOOST_REQUIRE_EQUAL(out.value(), 3u);
+
+    // No set of outputs has a value of two.
+    BOOST_REQUIRE(!index.select_exact(out, 2));
+    BOOST_REQUIRE(out.points.empty());
+    BOOST_REQUIRE(!index.select_exact(out, index.value() + 1, 100));
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__select_exact__no_budget__early_match)
+{
+    const auto unspent = make_outputs(2000, 7);
+    const auto index = make_index(unspent);
+    const auto largest = std::max_element(unspent.points.begin(),
+        unspent.points.end(), [](const point_value& left,
+            const point_value& right)
+        {
+            return left.value() < right.value();
+        })->value();
+
+    // The largest output is matched at the second step, before the clock is
+    // first read.
+    points_value out;
+    BOOST_REQUIRE(index.select_exact(out, largest, 0, asio::duration(0)));
+    BOOST_REQUIRE_EQUAL(out.points.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.value(), largest);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__select_exact__no_budget__search_abandoned)
+{
+    unspent_index index;
+    for (uint32_t position = 0; position < 2000; ++position)
+        BOOST_REQUIRE(index.insert(make_output(position, 2 * (position + 1))));
+
+    // No set of even values is odd, and the space is far too large to be
+    // exhausted, so only the budget ends the search.
+    points_value out;
+    BOOST_REQUIRE(!index.select_exact(out, index.value() / 2 + 1, 0,
+        asio::duration(0)));
+    BOOST_REQUIRE(out.points.empty());
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__select__payments__matches_select_outputs)
+{
+    static const size_t count = 500;
+    static const size_t payments = 20;
+
+    const auto unspent = make_outputs(count, 42);
+    const auto index = make_index(unspent);
+
+    for (size_t payment = 0; payment < payments; ++payment)
+    {
+        const auto minimum = (payment % 2 == 0 ? index.value() / 10 :
+            index.value() / count) * (payment + 1) / payments;
+
+        points_value expected;
+        points_value selected;
+        select_outputs::select(expected, unspent, minimum);
+        index.select(selected, minimum);
+        BOOST_REQUIRE(same_values(selected, expected));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()